@@ -8,6 +8,7 @@
 #include <utils/printers/actions.hxx>
 #include <utils/utils.hxx>
 #include <languages/fstrips/language.hxx>
+#include <languages/fstrips/compiled.hxx>
 
 
 namespace fs0 {
@@ -70,8 +71,36 @@ PartiallyGroundedAction::PartiallyGroundedAction(const ActionData& action_data,
 
 
 GroundAction::GroundAction(unsigned id, const ActionData& action_data, const Binding& binding, const fs::Formula* precondition, const std::vector<const fs::ActionEffect*>& effects) : 
-	ActionBase(action_data, binding, precondition, effects), _id(id)
-{}
+	ActionBase(action_data, binding, precondition, effects), _id(id),
+	_compiled_precondition(fs::CompiledExpression::compile(precondition)),
+	_compiled_effects()
+{
+	for (const fs::ActionEffect* effect:effects) {
+		std::shared_ptr<const fs::CompiledEffect> compiled = fs::CompiledEffect::compile(effect);
+		if (!compiled) { // We compile either all effects or none
+			_compiled_effects.clear();
+			break;
+		}
+		_compiled_effects.push_back(compiled);
+	}
+}
+
+bool GroundAction::checkPrecondition(const State& state) const {
+	return _compiled_precondition ? _compiled_precondition->holds(state) : _precondition->interpret(state);
+}
+
+void GroundAction::applyEffects(const State& state, std::vector<Atom>& atoms) const {
+	if (_compiled_effects.size() == _effects.size()) {
+		for (const auto& effect:_compiled_effects) {
+			if (effect->applicable(state)) atoms.push_back(effect->apply(state));
+		}
+		return;
+	}
+	
+	for (const fs::ActionEffect* effect:_effects) {
+		if (effect->applicable(state)) atoms.push_back(effect->apply(state));
+	}
+}
 
 
 const ActionIdx GroundAction::invalid_action_id = std::numeric_limits<unsigned int>::max();
@@ -5,13 +5,15 @@
 #include <utils/binding.hxx>
 
 
-namespace fs0 { namespace language { namespace fstrips { class Term; class Formula; class ActionEffect; } }}
+namespace fs0 { namespace language { namespace fstrips { class Term; class Formula; class ActionEffect; class CompiledExpression; class CompiledEffect; } }}
 namespace fs = fs0::language::fstrips;
 
 namespace fs0 {
 
 class GroundActionIterator;
 class ProblemInfo;
+class State;
+class Atom;
 
 //! All the data that fully characterizes a lifted action
 class ActionData {
@@ -110,6 +112,12 @@ class GroundAction : public ActionBase {
 protected:
 	//! The id that identifies the concrete action within the whole set of ground actions
 	unsigned _id;
+	
+	//! The compiled precondition, or nullptr if it cannot be compiled and needs to be interpreted
+	std::shared_ptr<const fs::CompiledExpression> _compiled_precondition;
+	
+	//! The compiled effects, which will be empty if some of the effects cannot be compiled and need to be interpreted
+	std::vector<std::shared_ptr<const fs::CompiledEffect>> _compiled_effects;
 
 public:
 	//! Trait required by aptk::DetStateModel
@@ -122,6 +130,12 @@ public:
 	~GroundAction() = default;
 	
 	unsigned getId() const { return _id; }
+	
+	//! Returns true iff the preconditions of the action hold in the given state
+	bool checkPrecondition(const State& state) const;
+	
+	//! Appends to the given vector the atoms that result from applying to the given state all the action effects applicable on it
+	void applyEffects(const State& state, std::vector<Atom>& atoms) const;
 };
 
 
@@ -0,0 +1,189 @@
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <actions/batch_applicability.hxx>
+#include <actions/successor_generator.hxx>
+#include <actions/actions.hxx>
+#include <state.hxx>
+#include <problem_info.hxx>
+#include <languages/fstrips/language.hxx>
+#include <aptk2/tools/logging.hxx>
+
+// The SIMD kernels are compiled for specific targets through function attributes, so that the rest of the code does not
+// need to be compiled with e.g. -mavx2, and selected at runtime depending on the CPU capabilities.
+#if defined(__x86_64__) && defined(__GNUC__)
+#define FS_BATCH_SIMD 1
+#include <immintrin.h>
+#else
+#define FS_BATCH_SIMD 0
+#endif
+
+namespace fs0 {
+
+BatchApplicabilityChecker::BatchApplicabilityChecker(const std::vector<const GroundAction*>& actions) :
+	_actions(actions), _tabulated(), _rows(0), _eq_columns(0), _eq_variables(), _eq_values(),
+	_neq_columns(0), _neq_variables(), _neq_values(), _fallback(), _kernel(best_kernel()),
+	_state_values(ProblemInfo::getInstance().getNumVariables() + 1, 0), _holds()
+{
+	std::vector<std::vector<SuccessorGenerator::Condition>> equalities, inequalities;
+
+	for (ActionIdx action = 0; action < actions.size(); ++action) {
+		const fs::Formula* precondition = actions[action]->getPrecondition();
+		std::vector<SuccessorGenerator::Condition> eq, neq;
+		if (precondition->is_contradiction() || !SuccessorGenerator::extract_conditions(precondition, eq, neq)) {
+			_fallback.push_back(action);
+			continue;
+		}
+		_tabulated.push_back(action);
+		_eq_columns = std::max<unsigned>(_eq_columns, eq.size());
+		_neq_columns = std::max<unsigned>(_neq_columns, neq.size());
+		equalities.push_back(std::move(eq));
+		inequalities.push_back(std::move(neq));
+	}
+
+	_rows = ((_tabulated.size() + ROW_ALIGNMENT - 1) / ROW_ALIGNMENT) * ROW_ALIGNMENT;
+	_holds.resize(_rows);
+
+	// Padding conditions refer to the sentinel variable, whose value is always 0, and hence always hold
+	const int32_t sentinel = _state_values.size() - 1;
+	_eq_variables.assign(_eq_columns * _rows, sentinel);
+	_eq_values.assign(_eq_columns * _rows, 0);
+	_neq_variables.assign(_neq_columns * _rows, sentinel);
+	_neq_values.assign(_neq_columns * _rows, 1);
+
+	for (unsigned row = 0; row < _tabulated.size(); ++row) {
+		for (unsigned k = 0; k < equalities[row].size(); ++k) {
+			_eq_variables[k * _rows + row] = equalities[row][k].first;
+			_eq_values[k * _rows + row] = equalities[row][k].second;
+		}
+		for (unsigned k = 0; k < inequalities[row].size(); ++k) {
+			_neq_variables[k * _rows + row] = inequalities[row][k].first;
+			_neq_values[k * _rows + row] = inequalities[row][k].second;
+		}
+	}
+
+	LPT_INFO("main", "Batch applicability checker: " << _tabulated.size() << " actions tabulated into " << _eq_columns << " equality and "
+	                 << _neq_columns << " inequality columns, " << _fallback.size() << " actions with complex preconditions, "
+	                 << kernel_name(_kernel) << " kernel");
+}
+
+std::vector<ActionIdx> BatchApplicabilityChecker::getCandidates(const State& state, Kernel kernel) const {
+	for (VariableIdx variable = 0; variable < _state_values.size() - 1; ++variable) {
+		_state_values[variable] = state.getValue(variable);
+	}
+
+	switch (kernel) {
+		case Kernel::SCALAR: evaluate_scalar(); break;
+		case Kernel::SSE2: evaluate_sse2(); break;
+		case Kernel::AVX2: evaluate_avx2(); break;
+	}
+
+	std::vector<ActionIdx> applicable;
+	for (unsigned row = 0; row < _tabulated.size(); ++row) {
+		if (_holds[row]) applicable.push_back(_tabulated[row]);
+	}
+
+	if (!_fallback.empty()) {
+		auto middle = applicable.size();
+		for (ActionIdx action:_fallback) {
+			if (_actions[action]->checkPrecondition(state)) applicable.push_back(action);
+		}
+		// Both parts are sorted, and we return the actions in the same order as a linear scan would find them
+		std::inplace_merge(applicable.begin(), applicable.begin() + middle, applicable.end());
+	}
+	return applicable;
+}
+
+void BatchApplicabilityChecker::evaluate_scalar() const {
+	const int32_t* values = _state_values.data();
+	for (unsigned row = 0; row < _rows; ++row) {
+		bool holds = true;
+		for (unsigned k = 0; holds && k < _eq_columns; ++k) {
+			holds = values[_eq_variables[k * _rows + row]] == _eq_values[k * _rows + row];
+		}
+		for (unsigned k = 0; holds && k < _neq_columns; ++k) {
+			holds = values[_neq_variables[k * _rows + row]] != _neq_values[k * _rows + row];
+		}
+		_holds[row] = holds;
+	}
+}
+
+#if FS_BATCH_SIMD
+
+// SSE2 has no gather instruction, so the state values are gathered one by one, but compared four at a time
+void BatchApplicabilityChecker::evaluate_sse2() const {
+	const int32_t* values = _state_values.data();
+	for (unsigned row = 0; row < _rows; row += 4) {
+		__m128i holds = _mm_set1_epi32(-1);
+		for (unsigned k = 0; k < _eq_columns; ++k) {
+			const int32_t* variables = &_eq_variables[k * _rows + row];
+			__m128i gathered = _mm_set_epi32(values[variables[3]], values[variables[2]], values[variables[1]], values[variables[0]]);
+			__m128i expected = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&_eq_values[k * _rows + row]));
+			holds = _mm_and_si128(holds, _mm_cmpeq_epi32(gathered, expected));
+		}
+		for (unsigned k = 0; k < _neq_columns; ++k) {
+			const int32_t* variables = &_neq_variables[k * _rows + row];
+			__m128i gathered = _mm_set_epi32(values[variables[3]], values[variables[2]], values[variables[1]], values[variables[0]]);
+			__m128i forbidden = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&_neq_values[k * _rows + row]));
+			holds = _mm_andnot_si128(_mm_cmpeq_epi32(gathered, forbidden), holds);
+		}
+		int mask = _mm_movemask_ps(_mm_castsi128_ps(holds));
+		for (unsigned i = 0; i < 4; ++i) _holds[row + i] = (mask >> i) & 1;
+	}
+}
+
+__attribute__((target("avx2")))
+void BatchApplicabilityChecker::evaluate_avx2() const {
+	const int32_t* values = _state_values.data();
+	for (unsigned row = 0; row < _rows; row += 8) {
+		__m256i holds = _mm256_set1_epi32(-1);
+		for (unsigned k = 0; k < _eq_columns; ++k) {
+			__m256i variables = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&_eq_variables[k * _rows + row]));
+			__m256i expected = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&_eq_values[k * _rows + row]));
+			holds = _mm256_and_si256(holds, _mm256_cmpeq_epi32(_mm256_i32gather_epi32(values, variables, 4), expected));
+		}
+		for (unsigned k = 0; k < _neq_columns; ++k) {
+			__m256i variables = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&_neq_variables[k * _rows + row]));
+			__m256i forbidden = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&_neq_values[k * _rows + row]));
+			holds = _mm256_andnot_si256(_mm256_cmpeq_epi32(_mm256_i32gather_epi32(values, variables, 4), forbidden), holds);
+		}
+		int mask = _mm256_movemask_ps(_mm256_castsi256_ps(holds));
+		for (unsigned i = 0; i < 8; ++i) _holds[row + i] = (mask >> i) & 1;
+	}
+}
+
+bool BatchApplicabilityChecker::supported(Kernel kernel) {
+	switch (kernel) {
+		case Kernel::SCALAR: return true;
+		case Kernel::SSE2: return true; // SSE2 is part of the x86-64 baseline
+		case Kernel::AVX2: __builtin_cpu_init(); return __builtin_cpu_supports("avx2");
+	}
+	return false;
+}
+
+#else
+
+void BatchApplicabilityChecker::evaluate_sse2() const { throw std::runtime_error("SSE2 kernel not available on this platform"); }
+void BatchApplicabilityChecker::evaluate_avx2() const { throw std::runtime_error("AVX2 kernel not available on this platform"); }
+
+bool BatchApplicabilityChecker::supported(Kernel kernel) { return kernel == Kernel::SCALAR; }
+
+#endif
+
+BatchApplicabilityChecker::Kernel BatchApplicabilityChecker::best_kernel() {
+	if (supported(Kernel::AVX2)) return Kernel::AVX2;
+	if (supported(Kernel::SSE2)) return Kernel::SSE2;
+	return Kernel::SCALAR;
+}
+
+const char* BatchApplicabilityChecker::kernel_name(Kernel kernel) {
+	switch (kernel) {
+		case Kernel::SCALAR: return "scalar";
+		case Kernel::SSE2: return "SSE2";
+		case Kernel::AVX2: return "AVX2";
+	}
+	return "unknown";
+}
+
+} // namespaces
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <fs_types.hxx>
+
+namespace fs0 {
+
+class State;
+class GroundAction;
+
+/**
+ * A batch evaluator of the preconditions of all ground actions on a given state.
+ * Actions whose precondition is a conjunction of atoms of the form X = c and X != c, where X is a state variable and c
+ * a constant, which is always the case e.g. in predicative problems, are laid out as structure-of-arrays tables:
+ * the k-th column of the equality table holds the variable and value of the k-th equality condition of every action,
+ * padded with conditions that always hold. All actions are then evaluated column by column over the (unpacked) values
+ * of the state, using SIMD gather / compare kernels when the CPU supports them.
+ * Actions with any other type of precondition are checked one by one, as usual.
+ */
+class BatchApplicabilityChecker {
+public:
+	//! The different implementations of the evaluation
+	enum class Kernel { SCALAR, SSE2, AVX2 };
+
+	BatchApplicabilityChecker(const std::vector<const GroundAction*>& actions);
+	~BatchApplicabilityChecker() = default;
+
+	BatchApplicabilityChecker(const BatchApplicabilityChecker&) = delete;
+	BatchApplicabilityChecker& operator=(const BatchApplicabilityChecker&) = delete;
+
+	//! Returns the indexes of all actions whose preconditions hold in the given state, sorted in increasing order.
+	//! Note that this does not take into account state constraints nor the validity of the action effects.
+	std::vector<ActionIdx> getCandidates(const State& state) const { return getCandidates(state, _kernel); }
+
+	//! Same as above, but using the given kernel, which must be supported by the CPU
+	std::vector<ActionIdx> getCandidates(const State& state, Kernel kernel) const;
+
+	//! Whether the given kernel can be used in the current CPU
+	static bool supported(Kernel kernel);
+
+	//! Returns the fastest kernel that can be used in the current CPU
+	static Kernel best_kernel();
+
+	static const char* kernel_name(Kernel kernel);
+
+protected:
+	//! The number of rows of the tables must be a multiple of the widest SIMD kernel
+	static const unsigned ROW_ALIGNMENT = 8;
+
+	const std::vector<const GroundAction*>& _actions;
+
+	//! '_tabulated[i]' is the action whose conditions are laid out in the i-th row of the tables
+	std::vector<ActionIdx> _tabulated;
+
+	//! The number of rows of the tables, including the padding ones
+	unsigned _rows;
+
+	//! The tables of equality and inequality conditions, stored column-major, i.e. the k-th condition of the action in
+	//! row i is at position k * _rows + i
+	unsigned _eq_columns;
+	std::vector<int32_t> _eq_variables;
+	std::vector<int32_t> _eq_values;
+
+	unsigned _neq_columns;
+	std::vector<int32_t> _neq_variables;
+	std::vector<int32_t> _neq_values;
+
+	//! The actions which could not be tabulated
+	std::vector<ActionIdx> _fallback;
+
+	Kernel _kernel;
+
+	//! Buffers for the values of the state variables, plus one extra (sentinel) variable used in the padding conditions,
+	//! and for the outcome of the evaluation of each row.
+	mutable std::vector<int32_t> _state_values;
+	mutable std::vector<uint8_t> _holds;
+
+	void evaluate_scalar() const;
+	void evaluate_sse2() const;
+	void evaluate_avx2() const;
+};
+
+} // namespaces
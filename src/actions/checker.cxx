@@ -19,11 +19,11 @@ bool Checker::check_correctness(const Problem& problem, const ActionPlan& plan,
 	for (unsigned idx:plan) {
 		const GroundAction& action = *actions[idx];
 // 		std::cout << "Action: " << action << std::endl;
-		if (!manager.isApplicable(state, action)) {
+		// Check the applicability of the action and move to the resulting state in one single pass
+		if (!manager.computeSuccessor(state, action, state)) {
 // 			std::cout << "Action not applicable on state " << state << std::endl;
 			return false;
 		}
-		state.accumulate(manager.computeEffects(state, action)); // Accumulate the newly-produced atoms
 	}
 	
 	// Now check that the resulting state is indeed a goal
@@ -36,10 +36,8 @@ bool Checker::check_correctness(const Problem& problem, const std::vector<Lifted
 	// First we make sure that the whole plan is applicable
 	State state(s0);
 	for (const LiftedActionID& action_id:plan) {
-		const GroundAction* action = action_id.generate();
-		if (!manager.isApplicable(state, *action)) return false;
-		state.accumulate(manager.computeEffects(state, *action)); // Accumulate the newly-produced atoms
-		delete action;
+		std::unique_ptr<const GroundAction> action(action_id.generate());
+		if (!manager.computeSuccessor(state, *action, state)) return false;
 	}
 	
 	// Now check that the resulting state is indeed a goal
@@ -0,0 +1,200 @@
+
+#include <algorithm>
+#include <iterator>
+
+#include <actions/delta_successor_generator.hxx>
+#include <actions/successor_generator.hxx>
+#include <actions/actions.hxx>
+#include <state.hxx>
+#include <state_layout.hxx>
+#include <applicability/applicability_manager.hxx>
+#include <problem_info.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/scopes.hxx>
+#include <aptk2/tools/logging.hxx>
+
+namespace fs0 {
+
+DeltaSuccessorGenerator::DeltaSuccessorGenerator(const std::vector<const GroundAction*>& actions) :
+	_actions(actions),
+	_equalities(ProblemInfo::getInstance().getNumVariables()),
+	_inequalities(ProblemInfo::getInstance().getNumVariables()),
+	_complex(ProblemInfo::getInstance().getNumVariables()),
+	_global(),
+	_unsatisfied(actions.size(), 0),
+	_candidates(),
+	_listed(actions.size(), false),
+	_enlisted(),
+	_merged(),
+	_is_complex(actions.size(), false),
+	_last(nullptr),
+	_successors(),
+	_word_variables(StateLayout::getInstance().getNumWords()),
+	_pending(),
+	_is_pending(actions.size(), false)
+{
+	const StateLayout& layout = StateLayout::getInstance();
+	for (VariableIdx variable = 0; variable < layout.getNumVariables(); ++variable) {
+		_word_variables[layout.getWord(variable)].push_back(variable);
+	}
+
+	unsigned num_complex = 0;
+	for (ActionIdx action = 0; action < actions.size(); ++action) {
+		const fs::Formula* precondition = actions[action]->getPrecondition();
+
+		std::vector<SuccessorGenerator::Condition> equalities, inequalities;
+		if (!precondition->is_contradiction() && SuccessorGenerator::extract_conditions(precondition, equalities, inequalities)) {
+			for (const auto& condition:equalities) _equalities[condition.first][condition.second].push_back(action);
+			for (const auto& condition:inequalities) _inequalities[condition.first][condition.second].push_back(action);
+			continue;
+		}
+
+		// Contradictions are evaluated once, when the counters are first computed, and never watched afterwards
+		_is_complex[action] = true;
+		++num_complex;
+		if (precondition->is_contradiction()) continue;
+
+		fs::ScopeUtils::TermSet nested;
+		fs::ScopeUtils::computeIndirectScope(precondition, nested);
+		if (!nested.empty()) {
+			_global.push_back(action);
+			continue;
+		}
+		for (VariableIdx variable:fs::ScopeUtils::computeDirectScope(precondition)) _complex[variable].push_back(action);
+	}
+
+	LPT_INFO("main", "Delta successor generator: " << actions.size() - num_complex << " actions with precondition counters, "
+	                 << num_complex << " actions with complex preconditions, " << _global.size() << " of which are re-checked on every state");
+}
+
+DeltaSuccessorGenerator::~DeltaSuccessorGenerator() = default;
+
+std::vector<ActionIdx> DeltaSuccessorGenerator::getCandidates(const State& state) {
+	if (!_last) {
+		reset(state);
+		_last = std::unique_ptr<State>(new State(state));
+	} else {
+		// If the state is a notified successor of the last state, the effects of the action that leads to it account for all changes...
+		auto it = _successors.find(state.hash());
+		if (it != _successors.end()) apply(it->second);
+		
+		// ... otherwise (or in the unlikely case of a hash collision), we need to compare both states
+		if (*_last != state) diff(state);
+
+		for (ActionIdx action:_global) recheck(action, state);
+		for (ActionIdx action:_pending) {
+			_is_pending[action] = false;
+			recheck(action, state);
+		}
+		_pending.clear();
+	}
+	_successors.clear();
+
+	// Prune from the list of candidates the actions that are no longer applicable
+	auto inapplicable = [this](ActionIdx action) {
+		if (_unsatisfied[action] == 0) return false;
+		_listed[action] = false;
+		return true;
+	};
+	_candidates.erase(std::remove_if(_candidates.begin(), _candidates.end(), inapplicable), _candidates.end());
+	_enlisted.erase(std::remove_if(_enlisted.begin(), _enlisted.end(), inapplicable), _enlisted.end());
+
+	// Keep the candidates in the same order in which a linear scan over all actions would have found them,
+	// which only requires sorting the (typically few) newly-enlisted actions
+	std::sort(_enlisted.begin(), _enlisted.end());
+	_merged.clear();
+	std::merge(_candidates.begin(), _candidates.end(), _enlisted.begin(), _enlisted.end(), std::back_inserter(_merged));
+	_candidates.swap(_merged);
+	_enlisted.clear();
+	return _candidates;
+}
+
+void DeltaSuccessorGenerator::notify_successor(const State& state, ActionIdx action, const State& successor) {
+	// Hash collisions are detected when the successor is queried, hence comparing the hashes is enough here
+	if (!_last || state.hash() != _last->hash()) return;
+	_successors[successor.hash()] = action;
+}
+
+void DeltaSuccessorGenerator::apply(ActionIdx action) {
+	for (const Atom& atom:ApplicabilityManager::computeEffects(*_last, *_actions[action])) {
+		ObjectIdx old_value = _last->getValue(atom.getVariable());
+		if (old_value == atom.getValue()) continue;
+		update(atom.getVariable(), old_value, atom.getValue());
+		_last->set(atom);
+	}
+}
+
+void DeltaSuccessorGenerator::diff(const State& state) {
+	const StateLayout& layout = StateLayout::getInstance();
+	const std::vector<State::Word>& old_data = _last->getData();
+	const std::vector<State::Word>& new_data = state.getData();
+	for (unsigned word = 0; word < new_data.size(); ++word) {
+		if (old_data[word] == new_data[word]) continue;
+		for (VariableIdx variable:_word_variables[word]) {
+			ObjectIdx old_value = layout.get(old_data, variable), new_value = layout.get(new_data, variable);
+			if (old_value != new_value) update(variable, old_value, new_value);
+		}
+	}
+	*_last = state; // The assignment reuses the memory of the last state
+}
+
+void DeltaSuccessorGenerator::reset(const State& state) {
+	std::fill(_unsatisfied.begin(), _unsatisfied.end(), 0);
+
+	for (VariableIdx variable = 0; variable < _equalities.size(); ++variable) {
+		ObjectIdx value = state.getValue(variable);
+		for (const auto& watched:_equalities[variable]) {
+			if (watched.first == value) continue;
+			for (ActionIdx action:watched.second) ++_unsatisfied[action];
+		}
+		auto it = _inequalities[variable].find(value);
+		if (it != _inequalities[variable].end()) {
+			for (ActionIdx action:it->second) ++_unsatisfied[action];
+		}
+	}
+
+	for (ActionIdx action = 0; action < _actions.size(); ++action) {
+		if (_is_complex[action]) recheck(action, state);
+		else if (_unsatisfied[action] == 0) enlist(action);
+	}
+}
+
+void DeltaSuccessorGenerator::update(VariableIdx variable, ObjectIdx old_value, ObjectIdx new_value) {
+	// The conditions x = old_value and x != new_value become unsatisfied...
+	auto it = _equalities[variable].find(old_value);
+	if (it != _equalities[variable].end()) {
+		for (ActionIdx action:it->second) ++_unsatisfied[action];
+	}
+	it = _inequalities[variable].find(new_value);
+	if (it != _inequalities[variable].end()) {
+		for (ActionIdx action:it->second) ++_unsatisfied[action];
+	}
+
+	// ... whereas the conditions x = new_value and x != old_value become satisfied
+	it = _equalities[variable].find(new_value);
+	if (it != _equalities[variable].end()) {
+		for (ActionIdx action:it->second) {
+			if (--_unsatisfied[action] == 0) enlist(action);
+		}
+	}
+	it = _inequalities[variable].find(old_value);
+	if (it != _inequalities[variable].end()) {
+		for (ActionIdx action:it->second) {
+			if (--_unsatisfied[action] == 0) enlist(action);
+		}
+	}
+
+	for (ActionIdx action:_complex[variable]) {
+		if (_is_pending[action]) continue;
+		_is_pending[action] = true;
+		_pending.push_back(action);
+	}
+}
+
+void DeltaSuccessorGenerator::recheck(ActionIdx action, const State& state) {
+	bool holds = _actions[action]->checkPrecondition(state);
+	_unsatisfied[action] = holds ? 0 : 1;
+	if (holds) enlist(action);
+}
+
+} // namespaces
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+
+#include <fs_types.hxx>
+
+namespace fs0 {
+
+class State;
+class GroundAction;
+
+/**
+ * A successor generator that derives the set of actions whose preconditions hold in a state from the set computed for
+ * the previous state it was queried on, which during search is typically the parent of the state or a sibling of it.
+ * Only the actions whose precondition mentions some state variable whose value differs between both states are
+ * re-checked, through a variable -> actions watch index built from the precondition scopes.
+ * When the queried state is known to be the successor of the last state through some action (see 'notify_successor'),
+ * the changed variables are taken from the effects of the action; otherwise they are found by comparing the memory of
+ * both states word by word, and decoding only the variables stored in the words that differ.
+ * Actions whose precondition is a conjunction of atoms X = c and X != c keep a counter of unsatisfied conditions, which
+ * is updated in constant time per condition affected by a changed value; the precondition of the rest of the actions
+ * is re-evaluated whenever some variable in its scope changes.
+ * Note that the generator keeps track of the last queried state, and hence cannot be shared among concurrent searches.
+ */
+class DeltaSuccessorGenerator {
+public:
+	DeltaSuccessorGenerator(const std::vector<const GroundAction*>& actions);
+	~DeltaSuccessorGenerator();
+
+	DeltaSuccessorGenerator(const DeltaSuccessorGenerator&) = delete;
+	DeltaSuccessorGenerator& operator=(const DeltaSuccessorGenerator&) = delete;
+
+	//! Returns the indexes of all actions whose preconditions hold in the given state, sorted in increasing order.
+	//! Note that this does not take into account state constraints nor the validity of the action effects.
+	std::vector<ActionIdx> getCandidates(const State& state);
+
+	//! Lets the generator know that 'successor' results from applying the given action to 'state', so that if 'state'
+	//! is the last queried state and 'successor' is the next one, the changes between them can be derived from the action effects
+	void notify_successor(const State& state, ActionIdx action, const State& successor);
+
+protected:
+	typedef std::unordered_map<ObjectIdx, std::vector<ActionIdx>> WatchList;
+
+	const std::vector<const GroundAction*>& _actions;
+
+	//! '_equalities[x][c]' ('_inequalities[x][c]') contains the actions with a precondition atom x = c (x != c), once per atom
+	std::vector<WatchList> _equalities;
+	std::vector<WatchList> _inequalities;
+
+	//! '_complex[x]' contains the actions with a precondition which is not a conjunction of (in)equalities and involves variable x
+	std::vector<std::vector<ActionIdx>> _complex;
+
+	//! The actions with complex preconditions that involve nested fluents, which need to be re-checked on every state
+	std::vector<ActionIdx> _global;
+
+	//! The number of unsatisfied precondition atoms of each action in the last state. Actions with complex preconditions
+	//! have a count of 0 or 1, depending on whether their precondition holds or not.
+	std::vector<unsigned> _unsatisfied;
+
+	//! A superset of the actions applicable in the last state, sorted in increasing order, and whether each action belongs
+	//! to it or to the list of actions enlisted since the last query
+	std::vector<ActionIdx> _candidates;
+	std::vector<bool> _listed;
+
+	//! The actions enlisted since the last query, which are merged into the sorted list of candidates at the end of the query
+	std::vector<ActionIdx> _enlisted;
+	std::vector<ActionIdx> _merged;
+
+	//! Whether each action has a complex precondition
+	std::vector<bool> _is_complex;
+
+	//! The last state on which the generator was queried, if any
+	std::unique_ptr<State> _last;
+
+	//! The actions that lead from the last queried state to each of its successors notified so far, indexed by the hash of the successor
+	std::unordered_map<std::size_t, ActionIdx> _successors;
+
+	//! '_word_variables[w]' contains the state variables stored in the w-th word of the memory of a state
+	std::vector<std::vector<VariableIdx>> _word_variables;
+
+	//! Computes from scratch the counters of the given state
+	void reset(const State& state);
+
+	//! Updates the counters and the last state with the changes made by the effects of the given action
+	void apply(ActionIdx action);
+
+	//! Updates the counters and the last state with the values of the given state that differ from those of the last state
+	void diff(const State& state);
+
+	//! Updates the counters after variable 'variable' changes from value 'old_value' to 'new_value'
+	void update(VariableIdx variable, ObjectIdx old_value, ObjectIdx new_value);
+
+	//! The actions with complex preconditions that need to be re-checked in the current state, and whether each action is among them
+	std::vector<ActionIdx> _pending;
+	std::vector<bool> _is_pending;
+
+	//! Re-evaluates the complex precondition of the given action
+	void recheck(ActionIdx action, const State& state);
+
+	//! Adds the given action to the list of candidates if it is not already there
+	void enlist(ActionIdx action) {
+		if (_listed[action]) return;
+		_listed[action] = true;
+		_enlisted.push_back(action);
+	}
+};
+
+} // namespaces
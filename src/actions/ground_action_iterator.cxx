@@ -3,22 +3,25 @@
 
 namespace fs0 {
 
-GroundActionIterator::GroundActionIterator(const ApplicabilityManager& actionManager, const State& state, const std::vector<const GroundAction*>& actions) :
-	_actionManager(actionManager), _actions(actions), _state(state)
+GroundActionIterator::GroundActionIterator(const ApplicabilityManager& actionManager, const State& state, const std::vector<const GroundAction*>& actions, std::vector<ActionIdx>&& candidates) :
+	_actionManager(actionManager), _actions(actions), _state(state), _candidates(std::move(candidates))
 {}
 	
-GroundActionIterator::Iterator::Iterator(const State& state, const std::vector<const GroundAction*>& actions, const ApplicabilityManager& actionManager, unsigned currentIdx) :
+GroundActionIterator::Iterator::Iterator(const State& state, const std::vector<const GroundAction*>& actions, const std::vector<ActionIdx>& candidates, const ApplicabilityManager& actionManager, unsigned currentIdx) :
 	_actionManager(actionManager),
 	_actions(actions),
+	_candidates(candidates),
 	_state(state),
-	_currentIdx(currentIdx)
+	_currentIdx(currentIdx),
+	_successor(std::vector<State::Word>(), 0) // Overwritten by 'computeSuccessor' for every applicable action
 {
 	advance();
 }
 
 void GroundActionIterator::Iterator::advance() {
-	for (;_currentIdx != _actions.size(); ++_currentIdx) {
-		if (_actionManager.isApplicable(_state, *_actions[_currentIdx])) { // The action is applicable, break the for loop.
+	for (;_currentIdx != _candidates.size(); ++_currentIdx) {
+		// Preconditions are already known to hold, we only need to check the validity of the effects
+		if (_actionManager.computeSuccessor(_state, *_actions[_candidates[_currentIdx]], _successor, false)) { // The action is applicable, break the for loop.
 			break;
 		}
 	}
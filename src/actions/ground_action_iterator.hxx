@@ -2,13 +2,17 @@
 #pragma once
 
 #include <applicability/applicability_manager.hxx>
+#include <state.hxx>
 
 namespace fs0 {
 
-class State;
 class GroundAction;
 
 //! A simple iterator strategy to iterate over the actions applicable in a given state.
+//! The iterator receives the (sorted) list of candidate actions whose preconditions are known to hold in the state,
+//! as computed by a SuccessorGenerator, and lazily filters out those whose application would not be valid.
+//! The successor state that results from the current action, which needs to be computed anyway to check its validity,
+//! is cached in the iterator, so that the search does not need to compute it again.
 class GroundActionIterator {
 protected:
 	const ApplicabilityManager _actionManager;
@@ -17,37 +21,50 @@ protected:
 	
 	const State& _state;
 	
+	//! The indexes of the actions whose preconditions hold in the state
+	std::vector<ActionIdx> _candidates;
+	
 public:
-	GroundActionIterator(const ApplicabilityManager& actionManager, const State& state, const std::vector<const GroundAction*>& actions);
+	GroundActionIterator(const ApplicabilityManager& actionManager, const State& state, const std::vector<const GroundAction*>& actions, std::vector<ActionIdx>&& candidates);
 	
 	class Iterator {
 		friend class GroundActionIterator;
 		
 	protected:
-		Iterator(const State& state, const std::vector<const GroundAction*>& actions, const ApplicabilityManager& actionManager, unsigned currentIdx);
+		Iterator(const State& state, const std::vector<const GroundAction*>& actions, const std::vector<ActionIdx>& candidates, const ApplicabilityManager& actionManager, unsigned currentIdx);
 
 		const ApplicabilityManager& _actionManager;
 		
 		const std::vector<const GroundAction*>& _actions;
 		
+		const std::vector<ActionIdx>& _candidates;
+		
 		const State& _state;
 		
+		//! The position of the current action within the list of candidates
 		unsigned _currentIdx;
 		
+		//! The state that results from applying the current action
+		State _successor;
+		
 		void advance();
 
 	public:
 		const Iterator& operator++();
 		const Iterator operator++(int) {Iterator tmp(*this); operator++(); return tmp;}
 
-		ActionIdx operator*() const { return _currentIdx; }
+		ActionIdx operator*() const { return _candidates[_currentIdx]; }
+		
+		//! Moves out of the iterator the state that results from applying the current action.
+		//! Can be called only once per action.
+		State take_successor() { return std::move(_successor); }
 		
 		bool operator==(const Iterator &other) const { return _currentIdx == other._currentIdx; }
 		bool operator!=(const Iterator &other) const { return !(this->operator==(other)); }
 	};
 	
-	Iterator begin() const { return Iterator(_state, _actions, _actionManager, 0); }
-	Iterator end() const { return Iterator(_state,_actions, _actionManager, _actions.size() ); }
+	Iterator begin() const { return Iterator(_state, _actions, _candidates, _actionManager, 0); }
+	Iterator end() const { return Iterator(_state,_actions, _candidates, _actionManager, _candidates.size()); }
 };
 
 
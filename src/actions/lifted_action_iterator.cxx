@@ -5,6 +5,9 @@
 #include <constraints/gecode/handlers/lifted_action_csp.hxx>
 #include <languages/fstrips/formulae.hxx>
 #include <applicability/applicability_manager.hxx>
+#include <applicability/state_constraint_index.hxx>
+#include <problem.hxx>
+#include <actions/actions.hxx>
 
 namespace fs0 { namespace gecode {
 
@@ -19,7 +22,9 @@ LiftedActionIterator::Iterator::Iterator(const State& state, const std::vector<s
 	_engine(nullptr),
 	_csp(nullptr),
 	_action(nullptr),
-	_state_constraints(state_constraints)
+	_state_constraints(state_constraints),
+	_successor(std::vector<State::Word>(), 0), // The successor is only computed when needed
+	_has_successor(false)
 {
 	advance();
 }
@@ -29,6 +34,7 @@ LiftedActionIterator::Iterator::~Iterator() {
 }
 
 void LiftedActionIterator::Iterator::advance() {
+	_has_successor = false;
 	while (next_solution()) {
 		
 		// If there are no state constraints, the solution is necessarily valid
@@ -36,16 +42,27 @@ void LiftedActionIterator::Iterator::advance() {
 			return;
 		}
 		
-		// Else, we need to check whether the application of the action that results from the CSP solution violates any state constraint
+		// Else, we need to check whether the application of the action that results from the CSP solution violates any state
+		// constraint, which requires computing the successor state, that we keep.
 		// TODO - A better way to do this would be to integrate state constraints into the CSP
-		auto ground = _action->generate();
-		State next(_state, ApplicabilityManager::computeEffects(_state, *ground));
-		if (_state_constraints->interpret(next)) { // The application of the action would violate the state constraints
+		ApplicabilityManager manager(_state_constraints, &Problem::getInstance().getStateConstraintIndex());
+		std::unique_ptr<const GroundAction> ground(_action->generate());
+		if (manager.computeSuccessor(_state, *ground, _successor, false)) {
+			_has_successor = true;
 			return;
 		}
 	}
 }
 
+State LiftedActionIterator::Iterator::take_successor() {
+	if (_has_successor) {
+		_has_successor = false;
+		return std::move(_successor);
+	}
+	std::unique_ptr<const GroundAction> ground(_action->generate());
+	return State(_state, ApplicabilityManager::computeEffects(_state, *ground));
+}
+
 
 bool LiftedActionIterator::Iterator::next_solution() {
 	for (;_current_handler_idx < _handlers.size(); ++_current_handler_idx) {
@@ -5,8 +5,9 @@
 
 #include <gecode/driver.hh>
 
+#include <state.hxx>
+
 namespace fs0 {
-class State;
 class LiftedActionID;
 }
 
@@ -58,6 +59,10 @@ public:
 		//! The state constraints
 		const fs::Formula* _state_constraints;
 		
+		//! The state that results from applying the current action, if it has already been computed
+		State _successor;
+		bool _has_successor;
+		
 		void advance();
 		
 		//! Returns true iff a new solution has actually been found
@@ -72,6 +77,10 @@ public:
 
 		const LiftedActionID& operator*() const { return *_action; }
 		
+		//! Moves out of the iterator the state that results from applying the current action, computing it if it was
+		//! not needed to check the state constraints. Can be called only once per action.
+		State take_successor();
+		
 		//! This is not really true... but will work for the purpose of comparing with the end iterator.
 		bool operator==(const Iterator &other) const { return _current_handler_idx == other._current_handler_idx; }
 		bool operator!=(const Iterator &other) const { return !(this->operator==(other)); }
@@ -0,0 +1,185 @@
+
+#include <algorithm>
+#include <map>
+
+#include <actions/successor_generator.hxx>
+#include <actions/actions.hxx>
+#include <state.hxx>
+#include <languages/fstrips/language.hxx>
+#include <aptk2/tools/logging.hxx>
+
+namespace fs0 {
+
+SuccessorGenerator::SuccessorGenerator(const std::vector<const GroundAction*>& actions) :
+	_actions(actions), _nodes(), _equalities(actions.size()), _inequalities(actions.size()), _fallback()
+{
+	std::vector<ActionIdx> indexed;
+	unsigned never_applicable = 0;
+
+	for (ActionIdx action = 0; action < actions.size(); ++action) {
+		const fs::Formula* precondition = actions[action]->getPrecondition();
+		if (precondition->is_contradiction()) {
+			++never_applicable;
+			continue;
+		}
+
+		std::vector<Condition> equalities;
+		if (!extract_conditions(precondition, equalities, _inequalities[action])) {
+			_inequalities[action].clear();
+			_fallback.push_back(action);
+			continue;
+		}
+
+		if (!encode_equalities(equalities, _equalities[action])) {
+			++never_applicable;
+			continue;
+		}
+		indexed.push_back(action);
+	}
+
+	build(indexed, 0);
+
+	// We don't need the conditions anymore once the tree has been built
+	_equalities.clear();
+	_equalities.shrink_to_fit();
+
+	LPT_INFO("main", "Successor generator: " << indexed.size() << " actions indexed in a decision tree with " << _nodes.size() << " nodes, "
+	                 << _fallback.size() << " actions with complex preconditions, " << never_applicable << " actions that can never be applied");
+}
+
+std::vector<ActionIdx> SuccessorGenerator::getCandidates(const State& state) const {
+	std::vector<ActionIdx> applicable;
+	if (!_nodes.empty()) collect(0, state, applicable);
+
+	for (ActionIdx action:_fallback) {
+		if (_actions[action]->checkPrecondition(state)) applicable.push_back(action);
+	}
+
+	// Return the actions in the same order in which a linear scan over all actions would have found them
+	std::sort(applicable.begin(), applicable.end());
+	return applicable;
+}
+
+int SuccessorGenerator::build(const std::vector<ActionIdx>& actions, unsigned depth) {
+	if (actions.empty()) return -1;
+
+	int index = _nodes.size();
+	_nodes.push_back(Switch{std::numeric_limits<VariableIdx>::max(), {}, {}, -1});
+
+	// Actions with no pending equality conditions are applicable as soon as the node is reached
+	std::vector<ActionIdx> pending;
+	for (ActionIdx action:actions) {
+		if (_equalities[action].size() == depth) _nodes[index].immediate.push_back(action);
+		else pending.push_back(action);
+	}
+	if (pending.empty()) return index;
+
+	// The node switches on the lowest variable among the next conditions of all pending actions
+	VariableIdx variable = std::numeric_limits<VariableIdx>::max();
+	for (ActionIdx action:pending) variable = std::min(variable, _equalities[action][depth].first);
+	_nodes[index].variable = variable;
+
+	std::map<StateLayout::Word, std::vector<ActionIdx>> branches;
+	std::vector<ActionIdx> dont_care;
+	for (ActionIdx action:pending) {
+		const EncodedCondition& condition = _equalities[action][depth];
+		if (condition.first == variable) branches[condition.second].push_back(action);
+		else dont_care.push_back(action);
+	}
+
+	// Note that '_nodes' might get reallocated during the recursive calls, so we cannot keep references to the current node
+	for (const auto& branch:branches) {
+		int child = build(branch.second, depth + 1);
+		_nodes[index].children.push_back(std::make_pair(branch.first, child));
+	}
+	int dont_care_child = build(dont_care, depth);
+	_nodes[index].dont_care = dont_care_child;
+	return index;
+}
+
+void SuccessorGenerator::collect(int node, const State& state, std::vector<ActionIdx>& applicable) const {
+	const StateLayout& layout = StateLayout::getInstance();
+	const auto& data = state.getData();
+
+	for (; node >= 0; node = _nodes[node].dont_care) {
+		const Switch& current = _nodes[node];
+
+		for (ActionIdx action:current.immediate) {
+			bool holds = true;
+			for (const Condition& condition:_inequalities[action]) {
+				if (state.getValue(condition.first) == condition.second) {
+					holds = false;
+					break;
+				}
+			}
+			if (holds) applicable.push_back(action);
+		}
+
+		if (current.children.empty()) continue;
+
+		StateLayout::Word code = layout.code(data, current.variable);
+		auto it = std::lower_bound(current.children.begin(), current.children.end(), code,
+		                           [](const std::pair<StateLayout::Word, int>& child, StateLayout::Word c) { return child.first < c; });
+		if (it != current.children.end() && it->first == code) collect(it->second, state, applicable);
+	}
+}
+
+bool SuccessorGenerator::extract_conditions(const fs::Formula* precondition, std::vector<Condition>& equalities, std::vector<Condition>& inequalities) {
+	if (precondition->is_tautology()) return true;
+
+	if (auto atom = dynamic_cast<const fs::AtomicFormula*>(precondition)) {
+		return extract_condition(atom, equalities, inequalities);
+	}
+
+	if (auto conjunction = dynamic_cast<const fs::Conjunction*>(precondition)) {
+		for (const fs::AtomicFormula* conjunct:conjunction->getConjuncts()) {
+			if (!extract_condition(conjunct, equalities, inequalities)) return false;
+		}
+		return true;
+	}
+	return false;
+}
+
+bool SuccessorGenerator::extract_condition(const fs::AtomicFormula* atom, std::vector<Condition>& equalities, std::vector<Condition>& inequalities) {
+	auto relational = dynamic_cast<const fs::RelationalFormula*>(atom);
+	if (!relational) return false;
+
+	auto symbol = relational->symbol();
+	if (symbol != fs::RelationalFormula::Symbol::EQ && symbol != fs::RelationalFormula::Symbol::NEQ) return false;
+
+	// The state variable might appear on either side of the (symmetric) relation
+	auto variable = dynamic_cast<const fs::StateVariable*>(relational->lhs());
+	auto constant = dynamic_cast<const fs::Constant*>(relational->rhs());
+	if (!variable || !constant) {
+		variable = dynamic_cast<const fs::StateVariable*>(relational->rhs());
+		constant = dynamic_cast<const fs::Constant*>(relational->lhs());
+	}
+	if (!variable || !constant) return false;
+
+	auto& conditions = (symbol == fs::RelationalFormula::Symbol::EQ) ? equalities : inequalities;
+	conditions.push_back(std::make_pair(variable->getValue(), constant->getValue()));
+	return true;
+}
+
+bool SuccessorGenerator::encode_equalities(const std::vector<Condition>& equalities, std::vector<EncodedCondition>& encoded) {
+	const StateLayout& layout = StateLayout::getInstance();
+	std::vector<Condition> sorted(equalities);
+	std::sort(sorted.begin(), sorted.end());
+
+	encoded.clear();
+	for (unsigned i = 0; i < sorted.size(); ++i) {
+		if (i > 0 && sorted[i].first == sorted[i-1].first) {
+			if (sorted[i].second != sorted[i-1].second) return false; // The same variable is required to take two different values
+			continue;
+		}
+
+		try {
+			encoded.push_back(std::make_pair(sorted[i].first, layout.encode(sorted[i].first, sorted[i].second)));
+		} catch (const std::runtime_error& ex) { // The value lies outside of the domain of the variable
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespaces
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <fs_types.hxx>
+#include <state_layout.hxx>
+
+namespace fs0 { namespace language { namespace fstrips { class Formula; class AtomicFormula; } }}
+namespace fs = fs0::language::fstrips;
+
+namespace fs0 {
+
+class State;
+class GroundAction;
+
+/**
+ * A successor generator that retrieves the ground actions whose preconditions hold in a given state in time proportional
+ * (mostly) to the number of such actions, rather than to the total number of ground actions.
+ * Actions whose precondition is a conjunction of atoms of the form X = c and X != c, where X is a state variable and c
+ * a constant, are indexed in a decision tree, in the style of Fast Downward: each node of the tree switches on the value
+ * of some state variable, and the actions reachable from a node are those whose equality conditions are all satisfied
+ * by the values followed so far. Inequality conditions are checked afterwards on the retrieved actions only.
+ * Actions with any other type of precondition are kept in a fallback list and checked one by one, as usual.
+ */
+class SuccessorGenerator {
+public:
+	SuccessorGenerator(const std::vector<const GroundAction*>& actions);
+	~SuccessorGenerator() = default;
+
+	SuccessorGenerator(const SuccessorGenerator&) = delete;
+	SuccessorGenerator& operator=(const SuccessorGenerator&) = delete;
+
+	//! Returns the indexes of all actions whose preconditions hold in the given state, sorted in increasing order.
+	//! Note that this does not take into account state constraints nor the validity of the action effects.
+	std::vector<ActionIdx> getCandidates(const State& state) const;
+
+	//! A condition X = c or X != c
+	typedef std::pair<VariableIdx, ObjectIdx> Condition;
+
+	//! Extracts into 'equalities' and 'inequalities' the conditions of the given precondition, returning false if the
+	//! precondition is not a conjunction of conditions of the form X = c or X != c.
+	static bool extract_conditions(const fs::Formula* precondition, std::vector<Condition>& equalities, std::vector<Condition>& inequalities);
+
+protected:
+
+	//! An equality condition X = c, with c given as the code with which the StateLayout stores it
+	typedef std::pair<VariableIdx, StateLayout::Word> EncodedCondition;
+
+	//! A node of the decision tree
+	struct Switch {
+		//! The variable on which the node switches, if any
+		VariableIdx variable;
+
+		//! The actions whose equality conditions are all satisfied upon reaching the node
+		std::vector<ActionIdx> immediate;
+
+		//! Pairs <code, child>, sorted by code, such that the subtree 'child' needs to be explored when 'variable' has the given code
+		std::vector<std::pair<StateLayout::Word, int>> children;
+
+		//! The subtree of actions that do not have any condition on 'variable', or -1 if there is none
+		int dont_care;
+	};
+
+	const std::vector<const GroundAction*>& _actions;
+
+	//! The nodes of the decision tree, the root being the first one, if any
+	std::vector<Switch> _nodes;
+
+	//! '_equalities[i]' contains the equality conditions of the i-th action, sorted by variable, if the action is indexed in the tree
+	std::vector<std::vector<EncodedCondition>> _equalities;
+
+	//! '_inequalities[i]' contains the inequality conditions of the i-th action, if the action is indexed in the tree
+	std::vector<std::vector<Condition>> _inequalities;
+
+	//! The actions which could not be indexed in the tree
+	std::vector<ActionIdx> _fallback;
+
+	//! Builds the subtree for the given actions, all of which have their first 'depth' equality conditions already
+	//! accounted for, and returns the index of its root node, or -1 if the subtree is empty.
+	int build(const std::vector<ActionIdx>& actions, unsigned depth);
+
+	//! Collects the actions of the given subtree whose preconditions hold in the given state
+	void collect(int node, const State& state, std::vector<ActionIdx>& applicable) const;
+
+	static bool extract_condition(const fs::AtomicFormula* atom, std::vector<Condition>& equalities, std::vector<Condition>& inequalities);
+
+	//! Encodes the given equality conditions according to the state layout, sorted by variable, returning false if the
+	//! conditions are unsatisfiable, e.g. because they require one variable to take two different values.
+	static bool encode_equalities(const std::vector<Condition>& equalities, std::vector<EncodedCondition>& encoded);
+};
+
+} // namespaces
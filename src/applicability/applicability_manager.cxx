@@ -1,5 +1,6 @@
 
 #include <applicability/applicability_manager.hxx>
+#include <applicability/state_constraint_index.hxx>
 #include <actions/actions.hxx>
 #include <state.hxx>
 #include <problem.hxx>
@@ -8,15 +9,19 @@
 namespace fs0 {
 
 
-ApplicabilityManager::ApplicabilityManager(const fs::Formula* state_constraints)
-	: _state_constraints(state_constraints) {}
+ApplicabilityManager::ApplicabilityManager(const fs::Formula* state_constraints, const StateConstraintIndex* index)
+	: _state_constraints(state_constraints), _index(index) {}
 	
 //! An action is applicable iff its preconditions hold and its application does not violate any state constraint.
 bool ApplicabilityManager::isApplicable(const State& state, const GroundAction& action) const {
-	if (!checkFormulaHolds(action.getPrecondition(), state)) return false;
-	
+	return action.checkPrecondition(state) && checkEffectsAreValid(state, action);
+}
+
+bool ApplicabilityManager::checkEffectsAreValid(const State& state, const GroundAction& action) const {
 	auto atoms = computeEffects(state, action);
 	if (!checkAtomsWithinBounds(atoms)) return false;
+	
+	if (_index) return _index->holds(state, atoms);
 		
 	if (!_state_constraints->is_tautology()) { // If we have no constraints, we can spare the cost of creating the new state.
 		State next(state, atoms);
@@ -25,14 +30,27 @@ bool ApplicabilityManager::isApplicable(const State& state, const GroundAction&
 	return true;
 }
 
+bool ApplicabilityManager::computeSuccessor(const State& state, const GroundAction& action, State& successor, bool check_precondition) const {
+	if (check_precondition && !action.checkPrecondition(state)) return false;
+	
+	auto atoms = computeEffects(state, action);
+	if (!checkAtomsWithinBounds(atoms)) return false;
+	
+	if (_index) { // Check the constraints before building the successor, which we can then spare if they do not hold
+		if (!_index->holds(state, atoms)) return false;
+		successor = State(state, atoms);
+		return true;
+	}
+	
+	successor = State(state, atoms);
+	return _state_constraints->is_tautology() || checkFormulaHolds(_state_constraints, successor);
+}
+
 //! Note that this might return some repeated atom - and even two contradictory atoms... we don't check that here.
 std::vector<Atom> ApplicabilityManager::computeEffects(const State& state, const GroundAction& action) {
 	Atom::vctr atoms;
-	for (const fs::ActionEffect* effect:action.getEffects()) {
-		if (effect->applicable(state)) {
-			atoms.push_back(effect->apply(state));
-		}
-	}
+	atoms.reserve(action.getEffects().size());
+	action.applyEffects(state, atoms);
 	return atoms;
 }
 
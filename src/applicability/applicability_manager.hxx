@@ -8,16 +8,29 @@ namespace fs = fs0::language::fstrips;
 
 namespace fs0 {
 
-class GroundAction; class State; class Atom;
+class GroundAction; class State; class Atom; class StateConstraintIndex;
 
 //! A simple manager that only checks applicability of actions in a non-relaxed setting.
 class ApplicabilityManager {
 public:
-	ApplicabilityManager(const fs::Formula* state_constraints);
+	//! If a state constraint index is given, state constraints are checked incrementally, assuming that they hold
+	//! in the state to which actions are applied.
+	ApplicabilityManager(const fs::Formula* state_constraints, const StateConstraintIndex* index = nullptr);
 		
 	//! An action is applicable iff its preconditions hold and its application does not violate any state constraint.
 	bool isApplicable(const State& state, const GroundAction& action) const;
 	
+	//! Checks that the application of the given action, whose preconditions are assumed to hold in the given state,
+	//! yields values within the domain bounds and does not violate any state constraint.
+	bool checkEffectsAreValid(const State& state, const GroundAction& action) const;
+	
+	//! Checks whether the given action is applicable in the given state and, if so, leaves in 'successor' the state that
+	//! results from its application. This is done in a single pass: the action effects are computed only once, and the
+	//! successor state that is built to check the state constraints is the one returned.
+	//! Preconditions are checked only if 'check_precondition' is true, i.e. when they are not already known to hold.
+	//! 'successor' can be the same object as 'state'; if the action is not applicable, its contents are unspecified.
+	bool computeSuccessor(const State& state, const GroundAction& action, State& successor, bool check_precondition = true) const;
+	
 	//! Note that this might return some repeated atom - and even two contradictory atoms... we don't check that here.
 	static std::vector<Atom> computeEffects(const State& state, const GroundAction& action);
 	
@@ -29,6 +42,9 @@ public:
 protected:
 	//! The state constraints
 	const fs::Formula* _state_constraints;
+	
+	//! The index to check the state constraints incrementally, if any
+	const StateConstraintIndex* _index;
 };
 
 } // namespaces
@@ -1,6 +1,7 @@
 
 #include <applicability/formula_interpreter.hxx>
 #include <languages/fstrips/language.hxx>
+#include <languages/fstrips/compiled.hxx>
 #include <utils/utils.hxx>
 #include <aptk2/tools/logging.hxx>
 #include <constraints/gecode/handlers/formula_csp.hxx>
@@ -23,11 +24,13 @@ FormulaInterpreter* FormulaInterpreter::create(const fs::Formula* formula, const
 
 
 DirectFormulaInterpreter::DirectFormulaInterpreter(const fs::Formula* formula) :
-	_formula(formula)
+	_formula(formula), _compiled(fs::CompiledExpression::compile(formula))
 {}
 
+DirectFormulaInterpreter::~DirectFormulaInterpreter() = default;
+
 bool DirectFormulaInterpreter::satisfied(const State& state) const {
-	return _formula->interpret(state);
+	return _compiled ? _compiled->holds(state) : _formula->interpret(state);
 }
 
 
@@ -4,7 +4,7 @@
 #include <memory>
 
 namespace fs0 { class TupleIndex; }
-namespace fs0 { namespace language { namespace fstrips { class Formula; }}}
+namespace fs0 { namespace language { namespace fstrips { class Formula; class CompiledExpression; }}}
 namespace fs = fs0::language::fstrips;
 
 namespace fs0 { namespace gecode { class FormulaCSP; }}
@@ -30,7 +30,7 @@ public:
 class DirectFormulaInterpreter : public FormulaInterpreter {
 public:
 	DirectFormulaInterpreter(const fs::Formula* formula);
-	~DirectFormulaInterpreter() = default;
+	~DirectFormulaInterpreter();
 
 	//! Returns true if the formula represented by the current object is satisfied in the given state
 	bool satisfied(const State& state) const;
@@ -38,6 +38,9 @@ public:
 protected:
 	//! The formula whose satisfiability will be directly checked
 	const fs::Formula* _formula;
+	
+	//! The compiled version of the formula, or nullptr if it cannot be compiled
+	std::unique_ptr<const fs::CompiledExpression> _compiled;
 };
 
 
@@ -0,0 +1,95 @@
+
+#include <applicability/state_constraint_index.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/scopes.hxx>
+#include <languages/fstrips/compiled.hxx>
+#include <problem_info.hxx>
+#include <aptk2/tools/logging.hxx>
+
+namespace fs0 {
+
+StateConstraintIndex::StateConstraintIndex(const fs::Formula* state_constraints) :
+	_state_constraints(state_constraints),
+	_trivial(state_constraints->is_tautology()),
+	_decomposable(true),
+	_conjuncts(),
+	_index(ProblemInfo::getInstance().getNumVariables()),
+	_global(),
+	_checked(),
+	_stamp(0)
+{
+	if (_trivial) return;
+
+	std::vector<const fs::AtomicFormula*> conjuncts;
+	if (auto atom = dynamic_cast<const fs::AtomicFormula*>(state_constraints)) {
+		conjuncts.push_back(atom);
+	} else if (auto conjunction = dynamic_cast<const fs::Conjunction*>(state_constraints)) {
+		conjuncts = conjunction->getConjuncts();
+	} else {
+		_decomposable = false;
+		LPT_INFO("main", "State constraint index: the state constraints are not a conjunction of atoms and will be checked as a whole");
+		return;
+	}
+
+	for (const fs::AtomicFormula* formula:conjuncts) {
+		unsigned idx = _conjuncts.size();
+		_conjuncts.push_back(Conjunct{formula, fs::CompiledExpression::compile(formula), fs::ScopeUtils::computeDirectScope(formula)});
+
+		fs::ScopeUtils::TermSet nested;
+		fs::ScopeUtils::computeIndirectScope(formula, nested);
+		if (!nested.empty()) {
+			_global.push_back(idx);
+			continue;
+		}
+
+		for (VariableIdx variable:_conjuncts.back().scope) _index[variable].push_back(idx);
+	}
+	_checked.resize(_conjuncts.size(), 0);
+
+	LPT_INFO("main", "State constraint index: " << _conjuncts.size() << " conjuncts, " << _global.size() << " of which need to be checked on every state");
+}
+
+StateConstraintIndex::~StateConstraintIndex() = default;
+
+bool StateConstraintIndex::holds(const State& state, const std::vector<Atom>& atoms) const {
+	if (_trivial) return true;
+
+	if (!_decomposable) {
+		State next(state, atoms);
+		return _state_constraints->interpret(next);
+	}
+
+	if (++_stamp == 0) { // Avoid mistaking stale stamps for current ones once the counter wraps around
+		std::fill(_checked.begin(), _checked.end(), 0);
+		_stamp = 1;
+	}
+
+	StateOverlay overlay(state, atoms);
+	for (const Atom& atom:atoms) {
+		if (state.getValue(atom.getVariable()) == overlay.getValue(atom.getVariable())) continue; // The value does not change
+
+		for (unsigned idx:_index[atom.getVariable()]) {
+			if (_checked[idx] == _stamp) continue;
+			_checked[idx] = _stamp;
+			if (!check(_conjuncts[idx], overlay)) return false;
+		}
+	}
+
+	if (!_global.empty()) {
+		State next(state, atoms);
+		for (unsigned idx:_global) {
+			if (!_conjuncts[idx].formula->interpret(next)) return false;
+		}
+	}
+	return true;
+}
+
+bool StateConstraintIndex::check(const Conjunct& conjunct, const StateOverlay& overlay) const {
+	if (conjunct.compiled) return conjunct.compiled->holds(overlay);
+
+	PartialAssignment assignment;
+	for (VariableIdx variable:conjunct.scope) assignment.insert(std::make_pair(variable, overlay.getValue(variable)));
+	return conjunct.formula->interpret(assignment);
+}
+
+} // namespaces
@@ -0,0 +1,88 @@
+
+#pragma once
+
+#include <fs_types.hxx>
+#include <state.hxx>
+#include <atom.hxx>
+
+namespace fs0 { namespace language { namespace fstrips { class Formula; class AtomicFormula; class CompiledExpression; } }}
+namespace fs = fs0::language::fstrips;
+
+namespace fs0 {
+
+//! A lightweight view of the state that results from applying a number of atoms to some state, without actually copying it.
+//! Later atoms take precedence over earlier ones, as when building the actual state.
+class StateOverlay {
+protected:
+	const State& _state;
+	const std::vector<Atom>& _atoms;
+
+public:
+	StateOverlay(const State& state, const std::vector<Atom>& atoms) : _state(state), _atoms(atoms) {}
+
+	ObjectIdx getValue(VariableIdx variable) const {
+		for (auto it = _atoms.rbegin(); it != _atoms.rend(); ++it) {
+			if (it->getVariable() == variable) return it->getValue();
+		}
+		return _state.getValue(variable);
+	}
+};
+
+/**
+ * An index from state variables to the conjuncts of the state constraints whose scope includes them, which allows us to check
+ * whether the state constraints still hold after the application of an action by re-checking only the conjuncts affected
+ * by the action effects, and without materializing the successor state.
+ * This assumes that the state constraints hold in the state to which the action is applied. Conjuncts involving nested
+ * fluents, whose scope is not fixed, are always re-checked, and so is the whole formula when it is not a conjunction of atoms.
+ */
+class StateConstraintIndex {
+public:
+	StateConstraintIndex(const fs::Formula* state_constraints);
+	~StateConstraintIndex();
+
+	StateConstraintIndex(const StateConstraintIndex&) = delete;
+	StateConstraintIndex& operator=(const StateConstraintIndex&) = delete;
+
+	//! Returns true iff the state constraints hold in the state that results from applying the given atoms to the given state,
+	//! assuming that they hold in the given state.
+	bool holds(const State& state, const std::vector<Atom>& atoms) const;
+
+	//! Whether there are no state constraints at all
+	bool trivial() const { return _trivial; }
+
+protected:
+	//! A conjunct of the state constraint formula
+	struct Conjunct {
+		const fs::AtomicFormula* formula;
+
+		//! The compiled version of the conjunct, or nullptr if it needs to be interpreted
+		std::unique_ptr<fs::CompiledExpression> compiled;
+
+		//! The state variables relevant to the conjunct
+		std::vector<VariableIdx> scope;
+	};
+
+	const fs::Formula* _state_constraints;
+
+	bool _trivial;
+
+	//! Whether the formula is a conjunction of atoms that can be checked incrementally
+	bool _decomposable;
+
+	std::vector<Conjunct> _conjuncts;
+
+	//! '_index[x]' contains the conjuncts whose scope includes state variable 'x'
+	std::vector<std::vector<unsigned>> _index;
+
+	//! The conjuncts that need to be checked on every state, as they involve nested fluents
+	std::vector<unsigned> _global;
+
+	//! '_checked[i]' is equal to '_stamp' iff conjunct 'i' has already been checked in the current call
+	mutable std::vector<unsigned> _checked;
+	mutable unsigned _stamp;
+
+	//! Checks whether the given conjunct holds in the given overlay
+	bool check(const Conjunct& conjunct, const StateOverlay& overlay) const;
+};
+
+} // namespaces
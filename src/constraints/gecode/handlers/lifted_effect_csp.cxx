@@ -1,4 +1,6 @@
 	
+#include <set>
+
 #include <languages/fstrips/language.hxx>
 #include <problem.hxx>
 #include <actions/actions.hxx>
@@ -66,6 +68,7 @@ bool LiftedEffectCSP::init(bool use_novelty_constraint) {
 	_rhs_variable = _translator.resolveVariableIndex(get_effect()->rhs());
 	_effect_tuple = index_tuple_indexes(get_effect());
 	_achievable_tuple_idx = detect_achievable_tuple();
+	_scope_symbols = index_scope_symbols();
 
 	// Register all fluent symbols involved
 	_tuple_indexes = _translator.index_fluents(_all_terms);
@@ -93,6 +96,25 @@ TupleIdx LiftedEffectCSP::detect_achievable_tuple() const {
 	return achievable_tuple_idx;
 }
 
+std::vector<unsigned> LiftedEffectCSP::index_scope_symbols() const {
+	std::vector<const fs::Term*> terms = get_precondition()->all_terms();
+	auto rhs_terms = get_effect()->rhs()->all_terms();
+	terms.insert(terms.end(), rhs_terms.begin(), rhs_terms.end());
+	auto condition_terms = get_effect()->condition()->all_terms();
+	terms.insert(terms.end(), condition_terms.begin(), condition_terms.end());
+	for (const fs::Term* subterm:check_valid_effect(get_effect())->getSubterms()) {
+		auto subterms = subterm->all_terms();
+		terms.insert(terms.end(), subterms.begin(), subterms.end());
+	}
+	
+	std::set<unsigned> symbols;
+	for (const fs::Term* term:terms) {
+		if (auto statevar = dynamic_cast<const fs::StateVariable*>(term)) symbols.insert(statevar->getSymbolId());
+		else if (auto nested = dynamic_cast<const fs::FluentHeadedNestedTerm*>(term)) symbols.insert(nested->getSymbolId());
+	}
+	return std::vector<unsigned>(symbols.begin(), symbols.end());
+}
+
 ValueTuple LiftedEffectCSP::index_tuple_indexes(const fs::ActionEffect* effect) {
 	auto lhs_statevar = check_valid_effect(effect);
 	
@@ -127,6 +149,13 @@ const fs::StateVariable* LiftedEffectCSP::check_valid_effect(const fs::ActionEff
 
 
 void LiftedEffectCSP::seek_novel_tuples(RPGIndex& rpg) const {
+	seek_novel_tuples(rpg, [this, &rpg](TupleIdx tuple, const GecodeCSP* solution) {
+		// The tuple is actually new - we extract the actual support from the solution
+		rpg.add(tuple, get_action_id(solution), extract_support(solution));
+	});
+}
+
+void LiftedEffectCSP::seek_novel_tuples(const RPGIndex& rpg, const SolutionProcessor& process) const {
 	if (GecodeCSP* csp = instantiate(rpg)) {
 		if (!csp->checkConsistency()) {
 			LPT_EDEBUG("heuristic", "The effect CSP cannot produce any new tuple");
@@ -136,7 +165,10 @@ void LiftedEffectCSP::seek_novel_tuples(RPGIndex& rpg) const {
 			unsigned num_solutions = 0;
 			while (GecodeCSP* solution = engine.next()) {
 		// 		LPT_EDEBUG("heuristic", std::endl << "Processing action CSP solution #"<< num_solutions + 1 << ": " << print::csp(_translator, *solution))
-				process_effect_solution(solution, rpg);
+				TupleIdx tuple_idx = compute_reached_tuple(solution);
+				bool reached = rpg.reached(tuple_idx);
+				LPT_EDEBUG("heuristic", "Processing effect \"" << *get_effect() << "\" produces " << (reached ? "repeated" : "new") << " tuple " << tuple_idx);
+				if (!reached) process(tuple_idx, solution);
 				++num_solutions;
 				delete solution;
 			}
@@ -156,17 +188,8 @@ TupleIdx LiftedEffectCSP::compute_reached_tuple(const GecodeCSP* solution) const
 	return tuple_idx;
 }
 
-void LiftedEffectCSP::process_effect_solution(const GecodeCSP* solution, RPGIndex& rpg) const {
-	TupleIdx tuple_idx = compute_reached_tuple(solution);
-	
-	bool reached = rpg.reached(tuple_idx);
-	LPT_EDEBUG("heuristic", "Processing effect \"" << *get_effect() << "\" produces " << (reached ? "repeated" : "new") << " tuple " << tuple_idx);
-	
-	if (reached) return; // The value has already been reached before
-	
-	// Otherwise, the value is actually new - we extract the actual support from the solution
-	std::vector<TupleIdx> support = Supports::extract_support(solution, _translator, _tuple_indexes, _necessary_tuples);
-	rpg.add(tuple_idx, get_action_id(solution), std::move(support));
+std::vector<TupleIdx> LiftedEffectCSP::extract_support(const GecodeCSP* solution) const {
+	return Supports::extract_support(solution, _translator, _tuple_indexes, _necessary_tuples);
 }
 
 
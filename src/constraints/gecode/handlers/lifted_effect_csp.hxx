@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include <constraints/gecode/handlers/lifted_action_csp.hxx>
 #include <gecode/int.hh>
 
@@ -16,6 +18,9 @@ class RPGIndex;
 //! A CSP modeling and solving the effect of an action effect on a certain RPG layer
 class LiftedEffectCSP : public LiftedActionCSP {
 public:
+	//! A function processing a tuple produced by the effect, along with the CSP solution that produces it
+	typedef std::function<void(TupleIdx, const GecodeCSP*)> SolutionProcessor;
+	
 	//! Factory method
 	static std::vector<std::unique_ptr<LiftedEffectCSP>> create_smart(const std::vector<const PartiallyGroundedAction*>& schemata, const TupleIndex& tuple_index, bool approximate, bool novelty);
 
@@ -31,6 +36,17 @@ public:
 	
 	void seek_novel_tuples(RPGIndex& rpg) const;
 	
+	//! Same as above, but instead of adding the tuples not yet reached in the RPG to it, passes them to the given function
+	void seek_novel_tuples(const RPGIndex& rpg, const SolutionProcessor& process) const;
+	
+	//! Returns the support of the tuple produced by the effect in the given CSP solution
+	std::vector<TupleIdx> extract_support(const GecodeCSP* solution) const;
+	
+	using LiftedActionCSP::get_action_id;
+	
+	//! Returns the (sorted) fluent symbols whose reached tuples can make a difference in the solutions of the CSP
+	const std::vector<unsigned>& get_scope_symbols() const { return _scope_symbols; }
+	
 	TupleIdx get_achievable_tuple() const { return _achievable_tuple_idx; }
 	
 	//! Raises an exception if the given effect is not valid for this type of effect handler, i.e. because it has nested fluents on the effect head.
@@ -45,8 +61,6 @@ protected:
 	//! to return a vector of effects. By construction, we have that _effects.size() == 1
 	const std::vector<const fs::ActionEffect*> _effects;
 	
-	void process_effect_solution(const GecodeCSP* solution, RPGIndex& rpg) const;
-	
 	//! Returns the novel tuple generated by the current effect in the given CSP solution
 	TupleIdx compute_reached_tuple(const GecodeCSP* solution) const;
 
@@ -81,6 +95,11 @@ protected:
 	// Returns a tuple index if the current effect has a fixed achievable tuple, or INVALID_TUPLE otherwise.
 	TupleIdx detect_achievable_tuple() const;
 	
+	//! The fluent symbols of the precondition and of the effect terms and condition
+	std::vector<unsigned> _scope_symbols;
+	
+	std::vector<unsigned> index_scope_symbols() const;
+	
 	void create_novelty_constraint() override;
 	
 	void post_novelty_constraint(GecodeCSP& csp, const RPGIndex& rpg) const override;
@@ -37,11 +37,11 @@ void LiftedPlanExtractor::processTuple(TupleIdx tuple) {
 	
 	const RPGIndex::TupleSupport& support = _graph.getTupleSupport(tuple);
 	
-	const ActionID* action_id = std::get<1>(support);
+	const ActionID* action_id = support.action;
 	assert(action_id);
-// 	std::cout << "Inserting: " << *action_id << " on layer #" << std::get<0>(support) << ", support size: " << std::get<2>(support).size() << std::endl;
-	perLayerSupporters[std::get<0>(support)].insert(action_id);
-	enqueueTuples(std::get<2>(support)); // Push the full support of the atom
+// 	std::cout << "Inserting: " << *action_id << " on layer #" << support.layer << ", support size: " << support.length << std::endl;
+	perLayerSupporters[support.layer].insert(action_id);
+	enqueueTuples(_graph.getSupportTuples(support)); // Push the full support of the atom
 	processed.insert(tuple); // Tag the atom as processed.
 }
 
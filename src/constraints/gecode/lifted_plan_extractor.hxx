@@ -6,6 +6,7 @@
 #include <unordered_set>
 
 #include <fs_types.hxx>
+#include <heuristics/relaxed_plan/rpg_arena.hxx>
 
 
 namespace fs0 { class State; class ActionID; class TupleIndex; }
@@ -43,9 +44,13 @@ public:
 	 */
 	long computeRelaxedPlanCost(const std::vector<TupleIdx>& tuples);
 	
+	//! The tuples achieved by the relaxed plan (i.e. not in the seed state), once the relaxed plan has been computed
+	const std::set<TupleIdx>& getRelaxedPlanTuples() const { return processed; }
+	
 protected:
 	//! Put all the atoms in a given vector of atoms in the queue to be processed.
 	inline void enqueueTuples(const std::vector<TupleIdx>& tuples) { for(const auto& tuple:tuples) pending.push(tuple); }
+	inline void enqueueTuples(const TupleRange& tuples) { for(const auto& tuple:tuples) pending.push(tuple); }
 
 	//! Process a single atom by seeking its supports left-to-right in the RPG and enqueuing them to be further processed
 	void processTuple(TupleIdx tuple);
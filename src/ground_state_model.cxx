@@ -4,9 +4,29 @@
 #include <state.hxx>
 #include <applicability/formula_interpreter.hxx>
 #include <actions/ground_action_iterator.hxx>
+#include <actions/successor_generator.hxx>
+#include <actions/delta_successor_generator.hxx>
+#include <actions/batch_applicability.hxx>
+#include <utils/config.hxx>
+#include <applicability/state_constraint_index.hxx>
 
 namespace fs0 {
 
+GroundStateModel::GroundStateModel(const Problem& problem) :
+	task(problem), _successor_generator(nullptr), _delta_generator(nullptr), _batch_checker(nullptr)
+{
+	std::string generation = Config::instance().getOption<std::string>("successor_generation", "tree");
+	if (generation == "delta") {
+		_delta_generator = std::make_shared<DeltaSuccessorGenerator>(problem.getGroundActions());
+	} else if (generation == "batch") {
+		_batch_checker = std::make_shared<BatchApplicabilityChecker>(problem.getGroundActions());
+	} else if (generation == "tree") {
+		_successor_generator = std::make_shared<SuccessorGenerator>(problem.getGroundActions());
+	} else {
+		throw std::runtime_error("Unknown successor generation mode: " + generation);
+	}
+}
+
 State GroundStateModel::init() const {
 	// We need to make a copy so that we can return it as non-const.
 	// Ugly, but this way we make it fit the search engine interface without further changes,
@@ -27,12 +47,22 @@ State GroundStateModel::next(const State& state, const GroundAction& a) const {
 	return State(state, manager.computeEffects(state, a)); // Copy everything into the new state and apply the changeset
 }
 
+State GroundStateModel::next(const State& state, GroundActionIterator::Iterator& it) const {
+	State successor = it.take_successor();
+	if (_delta_generator) _delta_generator->notify_successor(state, *it, successor);
+	return successor;
+}
+
 void GroundStateModel::print(std::ostream& os) const {
 	os << task;
 }
 
 GroundAction::ApplicableSet GroundStateModel::applicable_actions(const State& state) const {
-	return GroundActionIterator(ApplicabilityManager(task.getStateConstraints()), state, task.getGroundActions());
+	std::vector<ActionIdx> candidates;
+	if (_delta_generator) candidates = _delta_generator->getCandidates(state);
+	else if (_batch_checker) candidates = _batch_checker->getCandidates(state);
+	else candidates = _successor_generator->getCandidates(state);
+	return GroundActionIterator(ApplicabilityManager(task.getStateConstraints(), &task.getStateConstraintIndex()), state, task.getGroundActions(), std::move(candidates));
 }
 
 } // namespaces
@@ -1,17 +1,28 @@
 
 #pragma once
 
+#include <memory>
+
 #include <aptk2/search/interfaces/det_state_model.hxx>
 #include <actions/actions.hxx>
+#include <actions/ground_action_iterator.hxx>
 
 namespace fs0 {
 
 class Problem;
 class State;
+class SuccessorGenerator;
+class DeltaSuccessorGenerator;
+class BatchApplicabilityChecker;
 
 class GroundStateModel : public aptk::DetStateModel<State, GroundAction> {
 public:
-	GroundStateModel(const Problem& problem) : task(problem) {}
+	//! Note that the ground actions of the problem must have been set already.
+	//! The applicable actions of each state are computed from scratch through a decision tree, unless the
+	//! configuration option 'successor_generation' is set to 'delta', in which case they are derived from the
+	//! actions applicable in the previously queried state, or to 'batch', in which case the preconditions of all
+	//! actions are evaluated at once through SIMD kernels.
+	GroundStateModel(const Problem& problem);
 	~GroundStateModel() = default;
 	
 	GroundStateModel(const GroundStateModel& other) = default;
@@ -31,6 +42,10 @@ public:
 	//! Returns the state resulting from applying the given action action on the given state
 	State next(const State& state, const GroundAction::IdType& id) const;
 	State next(const State& state, const GroundAction& a) const;
+	
+	//! Returns the state resulting from applying the current action of the given iterator over the actions applicable
+	//! in the given state, which the iterator has already computed when checking the applicability of the action.
+	State next(const State& state, GroundActionIterator::Iterator& it) const;
 
 	void print(std::ostream &os) const;
 	
@@ -39,6 +54,16 @@ public:
 protected:
 	// The underlying planning problem.
 	const Problem& task;
+	
+	//! The successor generator of the problem ground actions, shared among all copies of the model
+	std::shared_ptr<const SuccessorGenerator> _successor_generator;
+	
+	//! The delta-driven successor generator, if used instead of the decision tree. Note that it keeps track of the
+	//! last state it has been queried on, and hence is also shared among all copies of the model.
+	std::shared_ptr<DeltaSuccessorGenerator> _delta_generator;
+	
+	//! The batch applicability checker, if used instead of the decision tree
+	std::shared_ptr<const BatchApplicabilityChecker> _batch_checker;
 };
 
 } // namespaces
@@ -0,0 +1,126 @@
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <heuristics/heuristic_cache.hxx>
+#include <search/statistics.hxx>
+#include <state_layout.hxx>
+#include <utils/config.hxx>
+#include <aptk2/tools/logging.hxx>
+
+namespace fs0 {
+
+const unsigned HeuristicCache::WAYS;
+const std::size_t HeuristicCache::NO_SLOT;
+const long HeuristicCache::EMPTY;
+
+HeuristicCache::HeuristicCache(std::size_t max_memory, Policy policy, bool store_atoms) :
+	_policy(policy), _store_atoms(store_atoms), _num_words(StateLayout::getInstance().getNumWords()), _num_sets(1),
+	_hashes(), _values(), _states(), _atoms(), _has_atoms(), _max_atoms_memory(store_atoms ? max_memory / 2 : 0), _atoms_memory(0),
+	_oldest(), _hits(0), _misses(0), _replaced(0), _discarded(0), _reporter(0)
+{
+	std::size_t slot_memory = sizeof(std::size_t) + sizeof(long) + _num_words * sizeof(State::Word);
+	if (store_atoms) slot_memory += sizeof(std::vector<Atom>) + sizeof(uint8_t);
+	std::size_t set_memory = WAYS * slot_memory + sizeof(uint8_t);
+
+	std::size_t table_memory = max_memory - _max_atoms_memory;
+	while (2 * _num_sets * set_memory <= table_memory) _num_sets *= 2;
+
+	std::size_t num_slots = _num_sets * WAYS;
+	_hashes.resize(num_slots, 0);
+	_values.resize(num_slots, EMPTY);
+	_states.resize(num_slots * _num_words, 0);
+	if (store_atoms) {
+		_atoms.resize(num_slots);
+		_has_atoms.resize(num_slots, false);
+	}
+	_oldest.resize(_num_sets, 0);
+
+	_reporter = drivers::SearchStatistics::instance().add([this](drivers::SearchStatistics::Entries& entries) {
+		unsigned long lookups = _hits + _misses;
+		entries.push_back(std::make_pair("heuristic_cache_hits", std::to_string(_hits)));
+		entries.push_back(std::make_pair("heuristic_cache_misses", std::to_string(_misses)));
+		entries.push_back(std::make_pair("heuristic_cache_hit_rate", std::to_string(lookups > 0 ? double(_hits) / lookups : 0.0)));
+		entries.push_back(std::make_pair("heuristic_cache_replaced", std::to_string(_replaced)));
+		entries.push_back(std::make_pair("heuristic_cache_discarded", std::to_string(_discarded)));
+	});
+
+	LPT_INFO("main", "Heuristic cache: " << num_slots << " slots in sets of " << WAYS << " (approx. " << memory() / 1024 << " KB)");
+}
+
+HeuristicCache::~HeuristicCache() {
+	drivers::SearchStatistics::instance().remove(_reporter);
+	unsigned long lookups = _hits + _misses;
+	LPT_INFO("main", "Heuristic cache: " << _hits << " hits out of " << lookups << " lookups, " << _replaced << " entries replaced, " << _discarded << " discarded");
+}
+
+std::size_t HeuristicCache::find(const State& state) const {
+	const std::vector<State::Word>& data = state.getData();
+	std::size_t first = set_of(state) * WAYS;
+	for (std::size_t slot = first; slot < first + WAYS; ++slot) {
+		if (_values[slot] == EMPTY) return NO_SLOT; // The slots of a set are filled in order and never emptied
+		if (_hashes[slot] == state.hash() && std::equal(data.begin(), data.end(), _states.begin() + slot * _num_words)) return slot;
+	}
+	return NO_SLOT;
+}
+
+void HeuristicCache::insert(const State& state, long value, const std::vector<Atom>* atoms) {
+	std::size_t set = set_of(state);
+	std::size_t first = set * WAYS;
+	std::size_t slot = find(state);
+
+	if (slot == NO_SLOT) {
+		for (slot = first; slot < first + WAYS && _values[slot] != EMPTY; ++slot) {}
+	}
+
+	if (slot == first + WAYS) { // The set is full
+		if (_policy == Policy::KEEP) {
+			++_discarded;
+			return;
+		}
+		slot = first + _oldest[set];
+		_oldest[set] = (_oldest[set] + 1) % WAYS;
+		++_replaced;
+	}
+
+	const std::vector<State::Word>& data = state.getData();
+	_hashes[slot] = state.hash();
+	_values[slot] = value;
+	std::copy(data.begin(), data.end(), _states.begin() + slot * _num_words);
+
+	if (_store_atoms) {
+		_atoms_memory -= _atoms[slot].capacity() * sizeof(Atom);
+		std::vector<Atom>().swap(_atoms[slot]);
+		_has_atoms[slot] = atoms && _atoms_memory + atoms->size() * sizeof(Atom) <= _max_atoms_memory;
+		if (_has_atoms[slot]) {
+			_atoms[slot] = *atoms;
+			_atoms_memory += _atoms[slot].capacity() * sizeof(Atom);
+		}
+	}
+}
+
+std::size_t HeuristicCache::memory() const {
+	return _hashes.capacity() * sizeof(std::size_t) + _values.capacity() * sizeof(long) + _states.capacity() * sizeof(State::Word)
+	     + _atoms.capacity() * sizeof(std::vector<Atom>) + _has_atoms.capacity() + _atoms_memory + _oldest.capacity();
+}
+
+HeuristicCache::Policy HeuristicCache::parse_policy(const std::string& policy) {
+	if (policy == "replace") return Policy::REPLACE;
+	if (policy == "keep") return Policy::KEEP;
+	throw std::runtime_error("Unknown heuristic cache policy: " + policy);
+}
+
+std::size_t HeuristicCache::configured_memory(const Config& config) {
+	int megabytes = config.getOption<int>("engine.heuristic_cache_memory", 0);
+	if (megabytes < 0) throw std::runtime_error("The memory of the heuristic cache cannot be negative");
+	return std::size_t(megabytes) << 20;
+}
+
+std::unique_ptr<HeuristicCache> HeuristicCache::create(const Config& config, bool store_atoms) {
+	std::size_t memory = configured_memory(config);
+	if (memory == 0) return nullptr;
+	Policy policy = parse_policy(config.getOption<std::string>("engine.heuristic_cache_policy", "replace"));
+	return std::unique_ptr<HeuristicCache>(new HeuristicCache(memory, policy, store_atoms));
+}
+
+} // namespaces
@@ -0,0 +1,155 @@
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <state.hxx>
+#include <atom.hxx>
+
+namespace fs0 {
+
+class Config;
+
+/**
+ * A bounded transposition table of heuristic values, and optionally of the atoms of the relaxed plans that support them.
+ * The table is set-associative: the (Zobrist) hash of a state selects a set of WAYS slots, and a lookup compares first the
+ * full hash and then the whole memory of the state stored in each slot, so that hash collisions never return wrong values.
+ * All slots are laid out in flat arrays, sized once from the given memory budget. The cache is not thread-safe.
+ * When a set is full, the insertion policy decides whether the oldest entry of the set is replaced (REPLACE) or the
+ * new entry is discarded (KEEP).
+ * The hits and misses of the cache are reported with the search statistics.
+ */
+class HeuristicCache {
+public:
+	enum class Policy { REPLACE, KEEP };
+
+	//! The number of slots of each set
+	static const unsigned WAYS = 4;
+
+	//! If 'store_atoms' is true, half of the memory budget (in bytes) is reserved for the relaxed plan atoms
+	HeuristicCache(std::size_t max_memory, Policy policy, bool store_atoms = false);
+	~HeuristicCache();
+
+	HeuristicCache(const HeuristicCache&) = delete;
+	HeuristicCache& operator=(const HeuristicCache&) = delete;
+
+	//! Returns the value of the given heuristic on the given state, retrieving it from the cache if possible
+	template <typename HeuristicT>
+	long evaluate(HeuristicT& heuristic, const State& state) {
+		std::size_t slot = find(state);
+		if (slot != NO_SLOT) {
+			++_hits;
+			return _values[slot];
+		}
+		++_misses;
+		long value = heuristic.evaluate(state);
+		insert(state, value, nullptr);
+		return value;
+	}
+
+	//! Same as above, but retrieving also the atoms of the relaxed plan computed by the heuristic
+	template <typename HeuristicT>
+	long evaluate(HeuristicT& heuristic, const State& state, std::vector<Atom>& atoms) {
+		std::size_t slot = find(state);
+		if (slot != NO_SLOT && _has_atoms[slot]) {
+			++_hits;
+			atoms = _atoms[slot];
+			return _values[slot];
+		}
+		++_misses;
+		long value = heuristic.evaluate(state, atoms);
+		insert(state, value, &atoms);
+		return value;
+	}
+
+	unsigned long hits() const { return _hits; }
+	unsigned long misses() const { return _misses; }
+
+	//! An estimate of the memory taken by the cache, in bytes
+	std::size_t memory() const;
+
+	static Policy parse_policy(const std::string& policy);
+	
+	//! The memory budget (in bytes) of the heuristic caches of all drivers, given in MB by option 'engine.heuristic_cache_memory'.
+	//! Caches are disabled (zero budget) unless configured.
+	static std::size_t configured_memory(const Config& config);
+
+	//! Creates a cache with the configured memory budget and policy ('engine.heuristic_cache_policy'), or returns nullptr
+	//! if caches are disabled
+	static std::unique_ptr<HeuristicCache> create(const Config& config, bool store_atoms = false);
+
+protected:
+	static const std::size_t NO_SLOT = std::numeric_limits<std::size_t>::max();
+
+	//! The value of the empty slots, which no heuristic can return
+	static const long EMPTY = std::numeric_limits<long>::min();
+
+	Policy _policy;
+
+	bool _store_atoms;
+
+	//! The number of words of each state, and the number of sets of the table, which is a power of two
+	std::size_t _num_words;
+	std::size_t _num_sets;
+
+	//! The hash, heuristic value and memory of the state stored in slot 'i' are '_hashes[i]', '_values[i]' and
+	//! '_states[i * _num_words]' to '_states[(i + 1) * _num_words - 1]'
+	std::vector<std::size_t> _hashes;
+	std::vector<long> _values;
+	std::vector<State::Word> _states;
+
+	//! The relaxed plan atoms of slot 'i', if '_has_atoms[i]' is true
+	std::vector<std::vector<Atom>> _atoms;
+	std::vector<uint8_t> _has_atoms;
+
+	//! The memory budget and the memory taken by the relaxed plan atoms
+	std::size_t _max_atoms_memory;
+	std::size_t _atoms_memory;
+
+	//! '_oldest[s]' is the way of set 's' that is replaced next
+	std::vector<uint8_t> _oldest;
+
+	unsigned long _hits;
+	unsigned long _misses;
+	unsigned long _replaced;
+	unsigned long _discarded;
+
+	//! The identifier of the reporter of the cache statistics
+	unsigned _reporter;
+
+	//! Returns the slot of the table where the given state is stored, or NO_SLOT if it is not in the table
+	std::size_t find(const State& state) const;
+
+	//! Stores the given value of the state and, if given, the relaxed plan atoms
+	void insert(const State& state, long value, const std::vector<Atom>* atoms);
+
+	std::size_t set_of(const State& state) const { return state.hash() & (_num_sets - 1); }
+};
+
+//! A heuristic which memoizes the values of a given heuristic in a HeuristicCache
+template <typename HeuristicT>
+class CachedHeuristic {
+public:
+	CachedHeuristic(HeuristicT&& heuristic, std::size_t max_memory, HeuristicCache::Policy policy, bool store_atoms = false)
+		: _heuristic(std::move(heuristic)), _cache(new HeuristicCache(max_memory, policy, store_atoms))
+	{}
+
+	CachedHeuristic(CachedHeuristic&&) = default;
+	CachedHeuristic(const CachedHeuristic&) = delete;
+	CachedHeuristic& operator=(const CachedHeuristic&) = delete;
+
+	long evaluate(const State& state) { return _cache->evaluate(_heuristic, state); }
+
+	long evaluate(const State& state, std::vector<Atom>& atoms) { return _cache->evaluate(_heuristic, state, atoms); }
+
+protected:
+	HeuristicT _heuristic;
+
+	std::unique_ptr<HeuristicCache> _cache;
+};
+
+} // namespaces
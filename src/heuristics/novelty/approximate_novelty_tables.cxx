@@ -0,0 +1,100 @@
+
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+#include <heuristics/novelty/approximate_novelty_tables.hxx>
+
+namespace fs0 {
+
+BlockedBloomFilter::BlockedBloomFilter(std::size_t memory, unsigned num_hashes) :
+	_num_hashes(num_hashes), _bits(), _num_lines(memory * 8 / LINE_BITS), _num_set(0)
+{
+	if (num_hashes < 1 || num_hashes > MAX_HASHES) throw std::runtime_error("The number of hashes of the approximate novelty tables must be between 1 and " + std::to_string(MAX_HASHES));
+	if (_num_lines == 0) throw std::runtime_error("The memory budget of the approximate novelty tables is too small");
+	_bits = AlignedBitset(_num_lines * LINE_BITS);
+}
+
+double BlockedBloomFilter::estimated_false_positive_rate() const {
+	return std::pow(static_cast<double>(_num_set) / _bits.size(), _num_hashes);
+}
+
+bool BlockedBloomFilter::insert(uint64_t hash) {
+	const std::size_t line = (hash % _num_lines) * LINE_BITS;
+	
+	// The bits within the line are taken from consecutive 9-bit chunks of a second hash
+	uint64_t bits = mix(hash);
+	bool novel = false;
+	for (unsigned h = 0; h < _num_hashes; ++h, bits >>= 9) {
+		if (!_bits.test_and_set(line + (bits & (LINE_BITS - 1)))) {
+			novel = true;
+			++_num_set;
+		}
+	}
+	return novel;
+}
+
+
+ApproximateNoveltyTables::ApproximateNoveltyTables(unsigned num_features, unsigned max_novelty, std::size_t memory, unsigned num_hashes) :
+	ApproximateNoveltyTables(num_features, max_novelty, std::make_shared<BlockedBloomFilter>(memory, num_hashes), 0)
+{}
+
+ApproximateNoveltyTables::ApproximateNoveltyTables(unsigned num_features, unsigned max_novelty, const std::shared_ptr<BlockedBloomFilter>& filter, uint64_t seed) :
+	_max_novelty(max_novelty), _filter(filter), _seed(BlockedBloomFilter::mix(seed)), _num_states(max_novelty + 2, 0), _hashes(num_features), _candidates(), _changed(num_features, false)
+{
+	if (max_novelty < 1) throw std::runtime_error("Approximate novelty tables require a novelty bound of at least 1");
+	_candidates.reserve(num_features);
+}
+
+void ApproximateNoveltyTables::compute_hashes(const std::vector<aptk::ValueIndex>& valuation) {
+	assert(valuation.size() == _hashes.size());
+	for (unsigned i = 0; i < valuation.size(); ++i) {
+		_hashes[i] = BlockedBloomFilter::mix((uint64_t(i) << 32) ^ uint32_t(valuation[i]));
+	}
+}
+
+unsigned ApproximateNoveltyTables::evaluate(const std::vector<aptk::ValueIndex>& valuation) {
+	compute_hashes(valuation);
+	_candidates.clear();
+	for (unsigned i = 0; i < valuation.size(); ++i) _candidates.push_back(i);
+	
+	unsigned novelty = _max_novelty + 1;
+	for (unsigned k = _max_novelty; k >= 1; --k) {
+		if (record_combinations(0, k, 0, k)) novelty = k;
+	}
+	
+	++_num_states[novelty];
+	return novelty;
+}
+
+unsigned ApproximateNoveltyTables::evaluate(const std::vector<aptk::ValueIndex>& valuation, const std::vector<unsigned>& changed) {
+	compute_hashes(valuation);
+	for (unsigned i:changed) _changed[i] = true;
+	
+	// Each tuple with some changed feature is enumerated only once, from the changed feature of lowest index in the tuple
+	unsigned novelty = _max_novelty + 1;
+	for (unsigned i:changed) {
+		_candidates.clear();
+		for (unsigned j = 0; j < valuation.size(); ++j) {
+			if (j != i && !(_changed[j] && j < i)) _candidates.push_back(j);
+		}
+		for (unsigned k = _max_novelty; k >= 1; --k) {
+			if (record_combinations(0, k - 1, _hashes[i], k) && novelty > k) novelty = k;
+		}
+	}
+	
+	for (unsigned i:changed) _changed[i] = false;
+	++_num_states[novelty];
+	return novelty;
+}
+
+bool ApproximateNoveltyTables::record_combinations(unsigned from, unsigned missing, uint64_t partial, unsigned size) {
+	if (missing == 0) return record(partial, size);
+	bool novel = false;
+	for (unsigned i = from; i + missing <= _candidates.size(); ++i) {
+		if (record_combinations(i + 1, missing - 1, partial + _hashes[_candidates[i]], size)) novel = true;
+	}
+	return novel;
+}
+
+} // namespaces
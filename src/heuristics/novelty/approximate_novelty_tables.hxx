@@ -0,0 +1,118 @@
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <heuristics/novelty/bitset_novelty_tables.hxx>
+
+namespace fs0 {
+
+/**
+ * A blocked Bloom filter of fixed size: each element is hashed into a single cache line of the filter, in which it sets
+ * a fixed number of bits, and is deemed to have been inserted before iff all of these bits were already set.
+ */
+class BlockedBloomFilter {
+public:
+	//! The maximum number of bits set per element
+	static const unsigned MAX_HASHES = 7;
+	
+	//! A filter using (at most) 'memory' bytes, and setting 'num_hashes' bits per element
+	BlockedBloomFilter(std::size_t memory, unsigned num_hashes);
+	
+	//! Inserts the element with the given (well-mixed) hash, returning true iff it had not been inserted before
+	bool insert(uint64_t hash);
+	
+	//! The number of bytes allocated for the filter
+	std::size_t memory() const { return _bits.memory(); }
+	
+	//! An estimate of the probability that an element not inserted before is deemed to have been inserted, given the current fill ratio of the filter
+	double estimated_false_positive_rate() const;
+	
+	//! The SplitMix64 finalizer, with which the hashes of the elements are mixed
+	static uint64_t mix(uint64_t x) {
+		x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+		x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+		return x ^ (x >> 31);
+	}
+
+protected:
+	//! The number of bits of a cache line, within which all the bits of an element are set
+	static const std::size_t LINE_BITS = 512;
+	
+	unsigned _num_hashes;
+	
+	AlignedBitset _bits;
+	
+	std::size_t _num_lines;
+	
+	//! The number of bits set in the filter
+	std::size_t _num_set;
+};
+
+/**
+ * Approximate novelty tables of any width, which record the tuples of feature values seen so far in a (blocked) Bloom
+ * filter of fixed size, instead of in tables whose size grows exponentially with the width.
+ * A tuple might be wrongly deemed to have been seen before (a false positive), which results in an overestimation of
+ * the novelty of a state, but never the opposite.
+ * The filter can be shared among several tables, e.g. those of the different partitions of a novelty heuristic, so that
+ * a single memory budget bounds all of them; the tuples of each table are then told apart by mixing a different seed into their hashes.
+ */
+class ApproximateNoveltyTables {
+public:
+	ApproximateNoveltyTables() = default;
+	
+	//! Tables for valuations of 'num_features' features, using their own filter of (at most) 'memory' bytes, and setting 'num_hashes' bits per tuple
+	ApproximateNoveltyTables(unsigned num_features, unsigned max_novelty, std::size_t memory, unsigned num_hashes);
+	
+	//! Tables for valuations of 'num_features' features, recording their tuples in the given (shared) filter with the given seed
+	ApproximateNoveltyTables(unsigned num_features, unsigned max_novelty, const std::shared_ptr<BlockedBloomFilter>& filter, uint64_t seed);
+	
+	//! Returns the (approximate) novelty of the given valuation, recording all its tuples as seen
+	unsigned evaluate(const std::vector<aptk::ValueIndex>& valuation);
+	
+	//! Same as above, but assuming that the valuation differs only in the given features from some valuation that has
+	//! already been evaluated, so that only the tuples containing at least one of those features need to be tested.
+	unsigned evaluate(const std::vector<aptk::ValueIndex>& valuation, const std::vector<unsigned>& changed);
+	
+	//! The number of evaluated valuations which had the given novelty
+	unsigned get_num_states(unsigned novelty) const { return novelty < _num_states.size() ? _num_states[novelty] : 0; }
+	
+	//! The number of bytes allocated for the filter, which might be shared with other tables
+	std::size_t memory() const { return _filter ? _filter->memory() : 0; }
+	
+	//! An estimate of the probability that a tuple not seen before is deemed to have been seen, given the current fill ratio of the filter
+	double estimated_false_positive_rate() const { return _filter ? _filter->estimated_false_positive_rate() : 0; }
+
+protected:
+	unsigned _max_novelty = 0;
+	
+	std::shared_ptr<BlockedBloomFilter> _filter;
+	
+	//! The seed mixed into the hashes of all tuples, which tells them apart from those of other tables sharing the filter
+	uint64_t _seed = 0;
+	
+	//! '_num_states[k]' is the number of valuations of novelty k
+	std::vector<unsigned> _num_states;
+	
+	//! '_hashes[i]' is the hash of the value of the i-th feature in the valuation being evaluated.
+	//! The hash of a tuple is the sum of the hashes of its elements, so that it does not depend on their order.
+	std::vector<uint64_t> _hashes;
+	
+	//! The features from which the tuples being enumerated are drawn, and whether each feature is among the changed ones
+	std::vector<unsigned> _candidates;
+	std::vector<bool> _changed;
+	
+	void compute_hashes(const std::vector<aptk::ValueIndex>& valuation);
+	
+	//! Records all tuples made of 'partial' plus 'missing' more features drawn from '_candidates[from...]', returning
+	//! true iff any of them had not been seen before. 'size' is the total size of the tuples.
+	bool record_combinations(unsigned from, unsigned missing, uint64_t partial, unsigned size);
+	
+	//! Records the tuple with the given hash and size, returning true iff it had not been seen before
+	bool record(uint64_t hash, unsigned size) { return _filter->insert(BlockedBloomFilter::mix(hash ^ _seed ^ (uint64_t(size) * 0x9e3779b97f4a7c15ULL))); }
+	
+};
+
+} // namespaces
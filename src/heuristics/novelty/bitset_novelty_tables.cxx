@@ -0,0 +1,136 @@
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include <heuristics/novelty/bitset_novelty_tables.hxx>
+
+namespace fs0 {
+
+AlignedBitset::AlignedBitset(std::size_t size) : _size(size), _words(nullptr, &std::free) {
+	allocate();
+	if (_words) std::memset(_words.get(), 0, memory()); // An empty bitset has no memory at all
+}
+
+AlignedBitset::AlignedBitset(const AlignedBitset& other) : _size(other._size), _words(nullptr, &std::free) {
+	if (!other._words) return;
+	allocate();
+	std::memcpy(_words.get(), other._words.get(), memory());
+}
+
+AlignedBitset& AlignedBitset::operator=(const AlignedBitset& other) {
+	if (this != &other) {
+		AlignedBitset copy(other);
+		*this = std::move(copy);
+	}
+	return *this;
+}
+
+std::size_t AlignedBitset::num_words() const {
+	const std::size_t words_per_line = CACHE_LINE_SIZE / sizeof(uint64_t);
+	std::size_t words = (_size + 63) / 64;
+	return ((words + words_per_line - 1) / words_per_line) * words_per_line;
+}
+
+void AlignedBitset::allocate() {
+	void* memory = nullptr;
+	if (num_words() > 0 && posix_memalign(&memory, CACHE_LINE_SIZE, num_words() * sizeof(uint64_t)) != 0) {
+		throw std::bad_alloc();
+	}
+	_words.reset(static_cast<uint64_t*>(memory));
+}
+
+
+BitsetNoveltyTables::BitsetNoveltyTables(const std::vector<std::vector<aptk::ValueIndex>>& domains, unsigned max_novelty) :
+	_max_novelty(max_novelty), _lower(), _upper(), _offsets(), _num_atoms(0), _width1(), _width2(), _num_states(max_novelty + 2, 0), _atoms()
+{
+	if (!supported(domains, max_novelty)) throw std::runtime_error("Bitset novelty tables do not support the given features / novelty bound");
+
+	for (const auto& domain:domains) {
+		auto bounds = std::minmax_element(domain.begin(), domain.end());
+		_lower.push_back(*bounds.first);
+		_upper.push_back(*bounds.second);
+		_offsets.push_back(_num_atoms);
+		_num_atoms += *bounds.second - *bounds.first + 1;
+	}
+
+	_width1 = AlignedBitset(_num_atoms);
+	if (_max_novelty >= 2) _width2 = AlignedBitset(_num_atoms * (_num_atoms - 1) / 2);
+	_atoms.resize(domains.size());
+	_changed.resize(domains.size(), false);
+}
+
+bool BitsetNoveltyTables::supported(const std::vector<std::vector<aptk::ValueIndex>>& domains, unsigned max_novelty) {
+	if (max_novelty < 1 || max_novelty > MAX_SUPPORTED_NOVELTY) return false;
+	for (const auto& domain:domains) {
+		if (domain.empty()) return false;
+	}
+	return true;
+}
+
+void BitsetNoveltyTables::compute_atoms(const std::vector<aptk::ValueIndex>& valuation) {
+	assert(valuation.size() == _atoms.size());
+	for (unsigned i = 0; i < valuation.size(); ++i) {
+		if (valuation[i] < _lower[i] || valuation[i] > _upper[i]) throw std::runtime_error("Novelty feature value out of its domain");
+		_atoms[i] = _offsets[i] + (valuation[i] - _lower[i]);
+	}
+}
+
+unsigned BitsetNoveltyTables::evaluate(const std::vector<aptk::ValueIndex>& valuation) {
+	compute_atoms(valuation);
+	unsigned novelty = _max_novelty + 1;
+
+	for (std::size_t atom:_atoms) {
+		if (!_width1.test_and_set(atom)) novelty = 1;
+	}
+
+	if (_max_novelty >= 2) {
+		// Atoms are sorted in increasing order, as are the feature offsets, so that p < q below
+		bool novel = false;
+		for (unsigned i = 0; i < _atoms.size(); ++i) {
+			const std::size_t p = _atoms[i];
+			const std::size_t row = pair_index(p, p + 1);
+			for (unsigned j = i + 1; j < _atoms.size(); ++j) {
+				if (!_width2.test_and_set(row + (_atoms[j] - p - 1))) novel = true;
+			}
+		}
+		if (novel && novelty > 2) novelty = 2;
+	}
+
+	++_num_states[novelty];
+	return novelty;
+}
+
+unsigned BitsetNoveltyTables::evaluate(const std::vector<aptk::ValueIndex>& valuation, const std::vector<unsigned>& changed) {
+	compute_atoms(valuation);
+	unsigned novelty = _max_novelty + 1;
+
+	for (unsigned i:changed) {
+		if (!_width1.test_and_set(_atoms[i])) novelty = 1;
+	}
+
+	if (_max_novelty >= 2) {
+		for (unsigned i:changed) _changed[i] = true;
+
+		// Pairs of two changed features are tested only from the side of the feature with lower index
+		bool novel = false;
+		for (unsigned i:changed) {
+			const std::size_t p = _atoms[i];
+			for (unsigned j = 0; j < _atoms.size(); ++j) {
+				if (j == i || (_changed[j] && j < i)) continue;
+				const std::size_t q = _atoms[j];
+				if (!_width2.test_and_set(j < i ? pair_index(q, p) : pair_index(p, q))) novel = true;
+			}
+		}
+		if (novel && novelty > 2) novelty = 2;
+
+		for (unsigned i:changed) _changed[i] = false;
+	}
+
+	++_num_states[novelty];
+	return novelty;
+}
+
+} // namespaces
@@ -0,0 +1,115 @@
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include <aptk2/heuristics/novelty/fd_novelty_evaluator.hxx>
+
+namespace fs0 {
+
+//! A fixed-size set of bits stored in memory aligned to cache lines
+class AlignedBitset {
+public:
+	AlignedBitset() : _size(0), _words(nullptr, &std::free) {}
+	explicit AlignedBitset(std::size_t size);
+
+	AlignedBitset(const AlignedBitset& other);
+	AlignedBitset& operator=(const AlignedBitset& other);
+	AlignedBitset(AlignedBitset&& other) = default;
+	AlignedBitset& operator=(AlignedBitset&& other) = default;
+
+	//! Sets the i-th bit and returns its previous value
+	bool test_and_set(std::size_t i) {
+		uint64_t& word = _words.get()[i >> 6];
+		uint64_t mask = uint64_t(1) << (i & 63);
+		bool previous = word & mask;
+		word |= mask;
+		return previous;
+	}
+
+	bool test(std::size_t i) const { return _words.get()[i >> 6] & (uint64_t(1) << (i & 63)); }
+
+	std::size_t size() const { return _size; }
+
+	//! The number of bytes allocated for the bitset
+	std::size_t memory() const { return num_words() * sizeof(uint64_t); }
+
+protected:
+	static const std::size_t CACHE_LINE_SIZE = 64;
+
+	std::size_t _size;
+
+	std::unique_ptr<uint64_t, void(*)(void*)> _words;
+
+	//! The number of words, rounded up to a whole number of cache lines
+	std::size_t num_words() const;
+
+	void allocate();
+};
+
+/**
+ * Novelty tables specialized for widths 1 and 2, which record the tuples of feature values seen so far in dense bitsets,
+ * one bit per feature value and one bit per pair of values of different features, sized from the actual feature domains.
+ * Each feature value is mapped to an "atom" index, and the novelty of a valuation is computed by testing (and setting)
+ * directly the bits of its atoms and pairs of atoms, without any intermediate tuple representation.
+ */
+class BitsetNoveltyTables {
+public:
+	//! The maximum novelty supported by the tables
+	static const unsigned MAX_SUPPORTED_NOVELTY = 2;
+
+	BitsetNoveltyTables() = default;
+
+	//! 'domains[i]' contains all the values that the i-th feature can take
+	BitsetNoveltyTables(const std::vector<std::vector<aptk::ValueIndex>>& domains, unsigned max_novelty);
+
+	//! Returns the novelty of the given valuation of the features, i.e. the size of the smallest tuple of feature values
+	//! not seen in any previous evaluation, or 'max_novelty' + 1 if there is no such tuple of size up to 'max_novelty'.
+	//! All the tuples of the valuation are recorded as seen.
+	unsigned evaluate(const std::vector<aptk::ValueIndex>& valuation);
+	
+	//! Same as above, but assuming that the valuation differs only in the given features from some valuation that has
+	//! already been evaluated, so that only the tuples containing at least one of those features need to be tested.
+	unsigned evaluate(const std::vector<aptk::ValueIndex>& valuation, const std::vector<unsigned>& changed);
+
+	//! The number of evaluated valuations which had the given novelty
+	unsigned get_num_states(unsigned novelty) const { return novelty < _num_states.size() ? _num_states[novelty] : 0; }
+
+	//! The number of bytes allocated for the tables
+	std::size_t memory() const { return _width1.memory() + _width2.memory(); }
+
+	//! Returns true iff tables can be built for the given domains and max novelty
+	static bool supported(const std::vector<std::vector<aptk::ValueIndex>>& domains, unsigned max_novelty);
+
+protected:
+	unsigned _max_novelty = 0;
+
+	//! The atom of the i-th feature taking value v is '_offsets[i] + v - _lower[i]'
+	std::vector<aptk::ValueIndex> _lower;
+	std::vector<aptk::ValueIndex> _upper;
+	std::vector<std::size_t> _offsets;
+
+	std::size_t _num_atoms = 0;
+
+	//! One bit per atom, and one bit per pair of atoms p < q, stored in row-major order of the upper triangular matrix
+	AlignedBitset _width1;
+	AlignedBitset _width2;
+
+	//! '_num_states[k]' is the number of valuations of novelty k
+	std::vector<unsigned> _num_states;
+
+	//! A buffer with the atoms of the valuation being evaluated, and whether each feature is among the changed ones
+	std::vector<std::size_t> _atoms;
+	std::vector<bool> _changed;
+	
+	//! Computes the atoms of the given valuation into '_atoms'
+	void compute_atoms(const std::vector<aptk::ValueIndex>& valuation);
+	
+	//! The index of the bit of the pair of atoms p < q in the width-2 table
+	std::size_t pair_index(std::size_t p, std::size_t q) const { return p * _num_atoms - p * (p + 1) / 2 + (q - p - 1); }
+};
+
+} // namespaces
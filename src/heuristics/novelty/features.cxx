@@ -1,11 +1,97 @@
 
+#include <numeric>
+#include <set>
+#include <map>
+#include <typeinfo>
+
 #include <heuristics/novelty/features.hxx>
 #include <state.hxx>
+#include <state_layout.hxx>
+#include <problem_info.hxx>
+#include <languages/fstrips/scopes.hxx>
+#include <languages/fstrips/terms.hxx>
 
 namespace fs0 {
 
+DenseValueMap::DenseValueMap(const std::vector<aptk::ValueIndex>& values) :
+	_identity(true), _lower(0), _table(), _domain(values)
+{
+	if (values.empty()) return;
+	std::set<aptk::ValueIndex> sorted(values.begin(), values.end());
+	aptk::ValueIndex lower = *sorted.begin(), upper = *sorted.rbegin();
+	std::size_t range = std::size_t(upper - lower) + 1;
+	if (range > MAX_TABULATED_RANGE) return;
+	
+	_identity = (lower == 0 && range == sorted.size());
+	_lower = lower;
+	if (range != sorted.size()) {
+		_table.assign(range, -1);
+		aptk::ValueIndex image = 0;
+		for (aptk::ValueIndex value:sorted) _table[value - lower] = image++;
+	}
+	_domain.resize(sorted.size());
+	std::iota(_domain.begin(), _domain.end(), 0);
+}
+
+unsigned AtomEvaluationCache::index(const fs::AtomicFormula* atom) {
+	auto& bucket = _buckets[hash(atom)];
+	for (unsigned i:bucket) {
+		if (equal(_atoms[i], atom)) return i;
+	}
+	unsigned i = _atoms.size();
+	_atoms.push_back(atom);
+	bucket.push_back(i);
+	return i;
+}
+
+void AtomEvaluationCache::indexScopes(unsigned num_variables) {
+	_atoms_by_variable.assign(num_variables, std::vector<unsigned>());
+	_global_atoms.clear();
+	for (unsigned i = 0; i < _atoms.size(); ++i) {
+		fs::ScopeUtils::TermSet nested;
+		fs::ScopeUtils::computeIndirectScope(_atoms[i], nested);
+		if (!nested.empty()) {
+			_global_atoms.push_back(i);
+			continue;
+		}
+		for (VariableIdx variable:fs::ScopeUtils::computeDirectScope(_atoms[i])) _atoms_by_variable[variable].push_back(i);
+	}
+}
+
+void AtomEvaluationCache::evaluate(const State& s, std::vector<uint64_t>& satisfied) const {
+	satisfied.assign((_atoms.size() + 63) / 64, 0);
+	for (unsigned i = 0; i < _atoms.size(); ++i) {
+		if (_atoms[i]->interpret(s)) satisfied[i >> 6] |= uint64_t(1) << (i & 63);
+	}
+}
+
+std::size_t AtomEvaluationCache::hash(const fs::AtomicFormula* atom) {
+	std::size_t seed = typeid(*atom).hash_code();
+	for (const fs::Term* subterm:atom->getSubterms()) {
+		seed ^= subterm->hash_code() + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	}
+	return seed;
+}
+
+bool AtomEvaluationCache::equal(const fs::AtomicFormula* a1, const fs::AtomicFormula* a2) {
+	if (typeid(*a1) != typeid(*a2)) return false;
+	const auto& s1 = a1->getSubterms();
+	const auto& s2 = a2->getSubterms();
+	if (s1.size() != s2.size()) return false;
+	for (unsigned i = 0; i < s1.size(); ++i) {
+		if (*s1[i] != *s2[i]) return false;
+	}
+	return true;
+}
+
 aptk::ValueIndex StateVariableFeature::evaluate( const State& s ) const { return s.getValue(_variable); }
 
+std::vector<aptk::ValueIndex> StateVariableFeature::domain() const {
+	// The variable can take any value that the state layout can store, e.g. 0 if it was not explicitly initialized
+	const auto domain = StateLayout::compute_domain(ProblemInfo::getInstance(), _variable);
+	return std::vector<aptk::ValueIndex>(domain.begin(), domain.end());
+}
+
 aptk::ValueIndex ConditionSetFeature::evaluate( const State& s ) const {
 	aptk::ValueIndex satisfied = 0;
 	for ( const fs::AtomicFormula* c : _conditions ) {
@@ -14,4 +100,45 @@ aptk::ValueIndex ConditionSetFeature::evaluate( const State& s ) const {
 	return satisfied;
 }
 
+std::vector<aptk::ValueIndex> ConditionSetFeature::domain() const {
+	std::vector<aptk::ValueIndex> values(_conditions.size() + 1);
+	std::iota(values.begin(), values.end(), 0);
+	return values;
+}
+
+void ConditionSetFeature::indexConditions(AtomEvaluationCache& cache) {
+	std::map<unsigned, uint64_t> words;
+	std::map<unsigned, unsigned> occurrences;
+	for (const fs::AtomicFormula* condition:_conditions) {
+		unsigned atom = cache.index(condition);
+		if (occurrences[atom]++ == 0) words[atom >> 6] |= uint64_t(1) << (atom & 63);
+	}
+	_mask.assign(words.begin(), words.end());
+	_repeated.clear();
+	for (const auto& occurrence:occurrences) {
+		if (occurrence.second > 1) _repeated.push_back(std::make_pair(occurrence.first, occurrence.second - 1));
+	}
+}
+
+aptk::ValueIndex ConditionSetFeature::evaluate(const std::vector<uint64_t>& satisfied) const {
+	aptk::ValueIndex count = 0;
+	for (const auto& word:_mask) count += __builtin_popcountll(satisfied[word.first] & word.second);
+	for (const auto& repeated:_repeated) {
+		if (satisfied[repeated.first >> 6] & (uint64_t(1) << (repeated.first & 63))) count += repeated.second;
+	}
+	return count;
+}
+
+bool ConditionSetFeature::computeScope(std::vector<VariableIdx>& scope) const {
+	std::set<VariableIdx> variables;
+	for (const fs::AtomicFormula* condition:_conditions) {
+		fs::ScopeUtils::TermSet nested;
+		fs::ScopeUtils::computeIndirectScope(condition, nested);
+		if (!nested.empty()) return false;
+		fs::ScopeUtils::computeDirectScope(condition, variables);
+	}
+	scope.assign(variables.begin(), variables.end());
+	return true;
+}
+
 }
@@ -1,6 +1,10 @@
 
 #pragma once
 
+#include <cassert>
+#include <cstdint>
+#include <unordered_map>
+
 #include <aptk2/heuristics/novelty/fd_novelty_evaluator.hxx>
 #include <fs_types.hxx>
 #include <languages/fstrips/formulae.hxx>
@@ -18,6 +22,95 @@ public:
 
 	virtual ~NoveltyFeature() {}
 	virtual aptk::ValueIndex evaluate( const State& s ) const = 0;
+	
+	//! Returns all the values that the feature can take, or an empty vector if the set of values is not finite
+	virtual std::vector<aptk::ValueIndex> domain() const = 0;
+	
+	//! Computes the state variables on which the value of the feature depends, returning false if these cannot be
+	//! determined in advance, e.g. because of nested fluents
+	virtual bool computeScope(std::vector<VariableIdx>& scope) const = 0;
+};
+
+//! A one-to-one mapping of the values that a feature can take onto the dense range [0, n), so that novelty tables
+//! can be sized exactly after the number of values of each feature, regardless of the actual (e.g. object) values
+class DenseValueMap {
+public:
+	//! Maps the given set of values, or acts as the identity if the set is empty (i.e. not finite)
+	//! or its range is too large to be tabulated
+	DenseValueMap(const std::vector<aptk::ValueIndex>& values);
+	
+	aptk::ValueIndex operator()(aptk::ValueIndex value) const {
+		if (_identity) return value;
+		if (_table.empty()) return value - _lower;
+		assert(value >= _lower && value - _lower < (aptk::ValueIndex) _table.size() && _table[value - _lower] >= 0);
+		return _table[value - _lower];
+	}
+	
+	//! Whether the mapping is the identity
+	bool identity() const { return _identity; }
+	
+	//! The values that the feature can take after the mapping
+	const std::vector<aptk::ValueIndex>& domain() const { return _domain; }
+
+protected:
+	static const std::size_t MAX_TABULATED_RANGE = 1 << 20;
+	
+	bool _identity;
+	
+	//! The lowest value, and, if the values are not contiguous, a table of the image of every value in [_lower, _upper],
+	//! where values not in the domain are mapped to -1
+	aptk::ValueIndex _lower;
+	std::vector<aptk::ValueIndex> _table;
+	
+	std::vector<aptk::ValueIndex> _domain;
+};
+
+//! The distinct atomic formulas appearing in a set of features, which are interpreted only once per state into a bitset
+//! of satisfied atoms, so that features sharing the same atoms do not need to interpret them again. The cache itself is
+//! immutable once all atoms have been registered: the bitsets belong to whoever evaluates the features, so that the
+//! cache can be shared among any number of evaluators.
+class AtomEvaluationCache {
+public:
+	AtomEvaluationCache() = default;
+	
+	//! Returns the index of the given atom, registering it if no structurally equal atom had been registered before
+	unsigned index(const fs::AtomicFormula* atom);
+	
+	//! Indexes the registered atoms by the state variables on which they depend
+	void indexScopes(unsigned num_variables);
+	
+	//! Interprets all registered atoms on the given state into the given bitset
+	void evaluate(const State& s, std::vector<uint64_t>& satisfied) const;
+	
+	//! Re-interprets on the given state the atoms that depend on the given state variable
+	void update(const State& s, VariableIdx variable, std::vector<uint64_t>& satisfied) const {
+		for (unsigned atom:_atoms_by_variable[variable]) interpret(s, atom, satisfied);
+	}
+	
+	//! Re-interprets on the given state the atoms whose scope cannot be determined in advance, e.g. because of nested fluents
+	void updateGlobal(const State& s, std::vector<uint64_t>& satisfied) const {
+		for (unsigned atom:_global_atoms) interpret(s, atom, satisfied);
+	}
+	
+	unsigned size() const { return _atoms.size(); }
+
+protected:
+	//! The distinct atoms, and the indexes of the atoms with a given hash code
+	std::vector<const fs::AtomicFormula*> _atoms;
+	std::unordered_map<std::size_t, std::vector<unsigned>> _buckets;
+	
+	//! '_atoms_by_variable[x]' contains the atoms that depend on state variable 'x'
+	std::vector<std::vector<unsigned>> _atoms_by_variable;
+	std::vector<unsigned> _global_atoms;
+	
+	void interpret(const State& s, unsigned atom, std::vector<uint64_t>& satisfied) const {
+		uint64_t bit = uint64_t(1) << (atom & 63);
+		if (_atoms[atom]->interpret(s)) satisfied[atom >> 6] |= bit;
+		else satisfied[atom >> 6] &= ~bit;
+	}
+	
+	static std::size_t hash(const fs::AtomicFormula* atom);
+	static bool equal(const fs::AtomicFormula* a1, const fs::AtomicFormula* a2);
 };
 
 //! A state variable-based feature that simply returs the value of a certain variable in the state
@@ -26,6 +119,8 @@ public:
 	StateVariableFeature( VariableIdx variable ) : _variable(variable) {}
 	~StateVariableFeature() {}
 	aptk::ValueIndex  evaluate( const State& s ) const;
+	std::vector<aptk::ValueIndex> domain() const;
+	bool computeScope(std::vector<VariableIdx>& scope) const { scope = {_variable}; return true; }
 
 protected:
 	VariableIdx _variable;
@@ -39,11 +134,27 @@ public:
 	~ConditionSetFeature() {}
 
 	void addCondition(const fs::AtomicFormula* condition) { _conditions.push_back(condition); }
+	const std::vector<const fs::AtomicFormula*>& getConditions() const { return _conditions; }
 
 	aptk::ValueIndex  evaluate( const State& s ) const;
+	std::vector<aptk::ValueIndex> domain() const;
+	bool computeScope(std::vector<VariableIdx>& scope) const;
+	
+	//! Registers the conditions of the feature in the given cache, after which the feature can be evaluated
+	//! from the atoms evaluated by the cache
+	void indexConditions(AtomEvaluationCache& cache);
+	
+	//! Evaluates the feature from the bitset of satisfied atoms computed by the cache in which the conditions were indexed
+	aptk::ValueIndex evaluate(const std::vector<uint64_t>& satisfied) const;
 
 protected:
 	std::vector<const fs::AtomicFormula*> _conditions;
+	
+	//! The mask of the conditions over the words of the cache bitset, as pairs (word index, mask), sorted by word index
+	std::vector<std::pair<unsigned, uint64_t>> _mask;
+	
+	//! The atoms that appear more than once among the conditions, along with their number of extra occurrences
+	std::vector<std::pair<unsigned, unsigned>> _repeated;
 };
 
 } // namespaces
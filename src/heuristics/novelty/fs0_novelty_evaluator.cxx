@@ -8,27 +8,29 @@
 #include <aptk2/tools/logging.hxx>
 #include <utils/printers/feature_set.hxx>
 #include <actions/actions.hxx>
+#include <problem_info.hxx>
 
 namespace fs0 {
 
-GenericStateAdapter::GenericStateAdapter( const State& s, const GenericNoveltyEvaluator& featureMap )
-	: _adapted( s ), _featureMap( featureMap) {}
+GenericStateAdapter::GenericStateAdapter( const State& s, const GenericNoveltyEvaluator& featureMap, const std::vector<aptk::ValueIndex>* valuation )
+	: _adapted( s ), _featureMap( featureMap), _valuation(valuation) {}
 
 GenericStateAdapter::~GenericStateAdapter() {}
 
-GenericNoveltyEvaluator::GenericNoveltyEvaluator(const Problem& problem, unsigned novelty_bound, const NoveltyFeaturesConfiguration& feature_configuration)
-	: Base()
+NoveltyFeatureSet::NoveltyFeatureSet(const Problem& problem, const NoveltyFeaturesConfiguration& feature_configuration)
+	: _features(), _features_by_variable(), _global_features(), _atoms(), _condition_features(), _value_maps()
 {
-	set_max_novelty(novelty_bound);
 	selectFeatures(problem, feature_configuration);
+	indexFeatureScopes();
+	indexFeatureAtoms();
+	computeValueMaps();
 }
 
-GenericNoveltyEvaluator::~GenericNoveltyEvaluator() {
+NoveltyFeatureSet::~NoveltyFeatureSet() {
 	for ( NoveltyFeature::ptr f : _features ) delete f;
 }
 
-
-void GenericNoveltyEvaluator::selectFeatures(const Problem& problem, const NoveltyFeaturesConfiguration& feature_configuration) {
+void NoveltyFeatureSet::selectFeatures(const Problem& problem, const NoveltyFeaturesConfiguration& feature_configuration) {
 	std::set< VariableIdx > relevantVars;
 
 	if ( feature_configuration.useGoal() ) {
@@ -62,7 +64,144 @@ void GenericNoveltyEvaluator::selectFeatures(const Problem& problem, const Novel
 			_features.push_back( new StateVariableFeature( x ) );
 		}
 	}
-	LPT_INFO("main", "Novelty From Constraints: # features: " << numFeatures());
+	LPT_INFO("main", "Novelty From Constraints: # features: " << size());
+}
+
+void NoveltyFeatureSet::indexFeatureScopes() {
+	_features_by_variable.resize(ProblemInfo::getInstance().getNumVariables());
+	for (unsigned k = 0; k < _features.size(); ++k) {
+		std::vector<VariableIdx> scope;
+		if (!_features[k]->computeScope(scope)) {
+			_global_features.push_back(k);
+			continue;
+		}
+		for (VariableIdx variable:scope) _features_by_variable[variable].push_back(k);
+	}
+}
+
+void NoveltyFeatureSet::indexFeatureAtoms() {
+	unsigned num_conditions = 0;
+	for (NoveltyFeature::ptr feature:_features) {
+		ConditionSetFeature* condition_feature = dynamic_cast<ConditionSetFeature*>(feature);
+		if (condition_feature) {
+			condition_feature->indexConditions(_atoms);
+			num_conditions += condition_feature->getConditions().size();
+		}
+		_condition_features.push_back(condition_feature);
+	}
+	_atoms.indexScopes(ProblemInfo::getInstance().getNumVariables());
+	if (num_conditions > 0) LPT_INFO("main", "Novelty features: " << num_conditions << " conditions over " << _atoms.size() << " distinct atoms");
+}
+
+void NoveltyFeatureSet::computeValueMaps() {
+	unsigned remapped = 0;
+	for (NoveltyFeature::ptr feature:_features) {
+		_value_maps.push_back(DenseValueMap(feature->domain()));
+		if (!_value_maps.back().identity()) ++remapped;
+	}
+	LPT_DEBUG("main", "Novelty features: " << remapped << " features with remapped values");
+}
+
+void NoveltyFeatureSet::evaluate(const State& s, std::vector<aptk::ValueIndex>& valuation, std::vector<uint64_t>& satisfied) const {
+	valuation.resize(_features.size());
+	_atoms.evaluate(s, satisfied);
+	for (unsigned k = 0; k < _features.size(); ++k) {
+		// Condition-set features always take values in the dense range [0, #conditions]
+		valuation[k] = _condition_features[k] ? _condition_features[k]->evaluate(satisfied) : _value_maps[k](_features[k]->evaluate(s));
+	}
+}
+
+std::vector<std::vector<aptk::ValueIndex>> NoveltyFeatureSet::getDomains() const {
+	std::vector<std::vector<aptk::ValueIndex>> domains;
+	for (const DenseValueMap& map:_value_maps) domains.push_back(map.domain());
+	return domains;
+}
+
+
+GenericNoveltyEvaluator::GenericNoveltyEvaluator(const Problem& problem, unsigned novelty_bound, const NoveltyFeaturesConfiguration& feature_configuration)
+	: GenericNoveltyEvaluator(std::make_shared<const NoveltyFeatureSet>(problem, feature_configuration), novelty_bound, feature_configuration)
+{}
+
+GenericNoveltyEvaluator::GenericNoveltyEvaluator(const std::shared_ptr<const NoveltyFeatureSet>& features, unsigned novelty_bound, const NoveltyFeaturesConfiguration& feature_configuration,
+                                                 const std::shared_ptr<BlockedBloomFilter>& filter, uint64_t partition)
+	: Base(), _features(features), _use_bitset_tables(false), _bitset_tables(), _use_approximate_tables(false), _approximate_tables(),
+	  _valuation(features->size()), _satisfied(), _parent(nullptr), _parent_valuation(), _parent_satisfied(),
+	  _changed_variables(), _changed(), _considered(), _is_considered(features->size(), false)
+{
+	set_max_novelty(novelty_bound);
+	if (feature_configuration.tables() == NoveltyFeaturesConfiguration::Tables::BITSET) setupBitsetTables(novelty_bound);
+	if (feature_configuration.tables() == NoveltyFeaturesConfiguration::Tables::APPROXIMATE) {
+		_use_approximate_tables = true;
+		if (filter) _approximate_tables = ApproximateNoveltyTables(_features->size(), novelty_bound, filter, partition);
+		else _approximate_tables = ApproximateNoveltyTables(_features->size(), novelty_bound, std::size_t(feature_configuration.approximateMemory()) << 20, feature_configuration.approximateHashes());
+	}
+}
+
+void GenericNoveltyEvaluator::setupBitsetTables(unsigned novelty_bound) {
+	std::vector<std::vector<aptk::ValueIndex>> domains = _features->getDomains();
+	
+	if (!BitsetNoveltyTables::supported(domains, novelty_bound)) {
+		LPT_INFO("main", "Bitset novelty tables do not support novelty bound " << novelty_bound << " or some feature with an infinite domain, using the aptk tables instead");
+		return;
+	}
+	
+	_use_bitset_tables = true;
+	_bitset_tables = BitsetNoveltyTables(domains, novelty_bound);
+	LPT_DEBUG("main", "Bitset novelty tables: " << _bitset_tables.memory() / 1024 << " KB");
+}
+
+unsigned GenericNoveltyEvaluator::evaluate(const State& s) {
+	_features->evaluate(s, _valuation, _satisfied);
+	if (_use_bitset_tables) return _bitset_tables.evaluate(_valuation);
+	if (_use_approximate_tables) return _approximate_tables.evaluate(_valuation);
+	GenericStateAdapter adaptee( s, *this, &_valuation );
+	return evaluate( adaptee );
+}
+
+unsigned GenericNoveltyEvaluator::evaluate(const State& s, const State& parent) {
+	// The siblings of a state are usually evaluated one after the other, so that we evaluate the parent only once for all of them
+	if (!_parent || *_parent != parent) {
+		_parent = std::make_shared<const State>(parent);
+		_features->evaluate(parent, _parent_valuation, _parent_satisfied);
+	}
+	
+	_valuation = _parent_valuation;
+	_satisfied = _parent_satisfied;
+	_changed_variables.clear();
+	_changed.clear();
+	_considered.clear();
+	
+	auto reevaluate = [&](unsigned feature) {
+		if (_is_considered[feature]) return;
+		_is_considered[feature] = true;
+		_considered.push_back(feature);
+		_valuation[feature] = _features->evaluate(s, feature, _satisfied);
+		if (_valuation[feature] != _parent_valuation[feature]) _changed.push_back(feature);
+	};
+	
+	// The atoms that depend on the changed variables are re-interpreted before any feature is re-evaluated, since
+	// condition-set features take their value from the atoms, which might depend on several changed variables
+	const AtomEvaluationCache& atoms = _features->getAtoms();
+	const StateLayout& layout = StateLayout::getInstance();
+	const auto& data = s.getData();
+	const auto& parent_data = parent.getData();
+	for (VariableIdx variable = 0; variable < _features->getNumVariables(); ++variable) {
+		if (layout.code(data, variable) == layout.code(parent_data, variable)) continue;
+		_changed_variables.push_back(variable);
+		atoms.update(s, variable, _satisfied);
+	}
+	atoms.updateGlobal(s, _satisfied);
+	
+	for (VariableIdx variable:_changed_variables) {
+		for (unsigned feature:_features->getFeatures(variable)) reevaluate(feature);
+	}
+	for (unsigned feature:_features->getGlobalFeatures()) reevaluate(feature);
+	for (unsigned feature:_considered) _is_considered[feature] = false;
+	
+	if (_use_bitset_tables) return _bitset_tables.evaluate(_valuation, _changed);
+	if (_use_approximate_tables) return _approximate_tables.evaluate(_valuation, _changed);
+	GenericStateAdapter adaptee( s, *this, &_valuation );
+	return evaluate( adaptee );
 }
 
 void GenericStateAdapter::get_valuation(std::vector<aptk::VariableIndex>& varnames, std::vector<aptk::ValueIndex>& values) const {
@@ -76,7 +215,7 @@ void GenericStateAdapter::get_valuation(std::vector<aptk::VariableIndex>& varnam
 
 	for ( unsigned k = 0; k < _featureMap.numFeatures(); k++ ) {
 		varnames[k] = k;
-		values[k] = _featureMap.feature( k )->evaluate( _adapted );
+		values[k] = _valuation ? (*_valuation)[k] : _featureMap.evaluateFeature( k, _adapted );
 	}
 
 	LPT_DEBUG("heuristic", "Feature evaluation: " << std::endl << print::feature_set(varnames, values));
@@ -3,18 +3,92 @@
 
 #include <aptk2/heuristics/novelty/fd_novelty_evaluator.hxx>
 #include <heuristics/novelty/features.hxx>
+#include <heuristics/novelty/bitset_novelty_tables.hxx>
+#include <heuristics/novelty/approximate_novelty_tables.hxx>
+#include <heuristics/novelty/novelty_features_configuration.hxx>
 #include <state.hxx>
 #include <problem.hxx>
 
 namespace fs0 {
 
-class NoveltyFeaturesConfiguration;
-
 class GenericNoveltyEvaluator;
 
+//! The set of features on which the novelty of a state is computed, along with an index of the state variables on
+//! which each feature depends. The set is immutable once built, so that it can be shared among any number of evaluators;
+//! in particular, the bitsets of atoms satisfied by the evaluated states belong to the evaluators, not to the set.
+class NoveltyFeatureSet {
+public:
+	NoveltyFeatureSet(const Problem& problem, const NoveltyFeaturesConfiguration& feature_configuration);
+	~NoveltyFeatureSet();
+	
+	NoveltyFeatureSet(const NoveltyFeatureSet&) = delete;
+	NoveltyFeatureSet& operator=(const NoveltyFeatureSet&) = delete;
+	
+	unsigned size() const { return _features.size(); }
+	const NoveltyFeature* feature(unsigned i) const { return _features[i]; }
+	
+	//! Computes the valuation of all features on the given state into 'valuation', with the values of each feature
+	//! remapped onto the dense range [0, n) of its n possible values, and the atoms of the condition-set features
+	//! that hold in the state into the bitset 'satisfied'
+	void evaluate(const State& s, std::vector<aptk::ValueIndex>& valuation, std::vector<uint64_t>& satisfied) const;
+	
+	//! Returns the (remapped) value of the given feature on the given state
+	aptk::ValueIndex evaluate(const State& s, unsigned feature) const { return _value_maps[feature](_features[feature]->evaluate(s)); }
+	
+	//! Same as above, but taking the value of condition-set features from the given (up-to-date) bitset of satisfied atoms
+	aptk::ValueIndex evaluate(const State& s, unsigned feature, const std::vector<uint64_t>& satisfied) const {
+		return _condition_features[feature] ? _condition_features[feature]->evaluate(satisfied) : evaluate(s, feature);
+	}
+	
+	//! The distinct atoms of all condition-set features
+	const AtomEvaluationCache& getAtoms() const { return _atoms; }
+	
+	//! Returns the features whose value depends on the given state variable
+	const std::vector<unsigned>& getFeatures(VariableIdx variable) const { return _features_by_variable[variable]; }
+	unsigned getNumVariables() const { return _features_by_variable.size(); }
+	
+	//! Returns the features whose value cannot be determined to depend on a fixed set of state variables
+	const std::vector<unsigned>& getGlobalFeatures() const { return _global_features; }
+	
+	//! Returns the domain of each of the features, after the remapping of its values
+	std::vector<std::vector<aptk::ValueIndex>> getDomains() const;
+	
+protected:
+	//! Select and create the state features that we will use henceforth to compute the novelty
+	void selectFeatures(const Problem& problem, const NoveltyFeaturesConfiguration& feature_configuration);
+	
+	//! Index the features by the state variables on which they depend
+	void indexFeatureScopes();
+	
+	//! Register the atoms of all condition-set features in the atom cache
+	void indexFeatureAtoms();
+	
+	//! Compute the dense remapping of the values of each feature
+	void computeValueMaps();
+	
+	//! An array with all the features that we take into account when computing the novelty
+	std::vector<NoveltyFeature::ptr> _features;
+	
+	//! '_features_by_variable[x]' contains the features whose value depends on state variable 'x'
+	std::vector<std::vector<unsigned>> _features_by_variable;
+	
+	//! The features whose value cannot be determined to depend on a fixed set of state variables
+	std::vector<unsigned> _global_features;
+	
+	//! The distinct atoms of all condition-set features, which are interpreted only once per evaluated state
+	AtomEvaluationCache _atoms;
+	
+	//! '_condition_features[k]' is the k-th feature if it is a condition-set feature, or null otherwise
+	std::vector<const ConditionSetFeature*> _condition_features;
+	
+	//! '_value_maps[k]' maps the values of the k-th feature onto a dense range
+	std::vector<DenseValueMap> _value_maps;
+};
+
 class GenericStateAdapter {
 public:
-	GenericStateAdapter( const State& s, const GenericNoveltyEvaluator& featureMap );
+	//! If 'valuation' is given, it is taken as the (already computed) valuation of the features on the state
+	GenericStateAdapter( const State& s, const GenericNoveltyEvaluator& featureMap, const std::vector<aptk::ValueIndex>* valuation = nullptr );
 	~GenericStateAdapter();
 
 	void get_valuation( std::vector< aptk::VariableIndex >& varnames, std::vector< aptk::ValueIndex >& values ) const;
@@ -22,6 +96,7 @@ public:
 protected:
 	const State& _adapted;
 	const GenericNoveltyEvaluator& _featureMap;
+	const std::vector<aptk::ValueIndex>* _valuation;
 };
 
 
@@ -30,25 +105,75 @@ public:
 	typedef aptk::FiniteDomainNoveltyEvaluator< GenericStateAdapter > Base;
 
 	GenericNoveltyEvaluator(const Problem& problem, unsigned novelty_bound, const NoveltyFeaturesConfiguration& feature_configuration);
-	virtual ~GenericNoveltyEvaluator();
+	
+	//! Creates an evaluator over the given (shared) set of features. If the novelty is computed through the approximate
+	//! tables and a filter is given, the tuples are recorded in that (shared) filter, told apart by the given partition key.
+	GenericNoveltyEvaluator(const std::shared_ptr<const NoveltyFeatureSet>& features, unsigned novelty_bound, const NoveltyFeaturesConfiguration& feature_configuration,
+	                        const std::shared_ptr<BlockedBloomFilter>& filter = nullptr, uint64_t partition = 0);
+	
+	virtual ~GenericNoveltyEvaluator() = default;
 	
 	using Base::evaluate; // So that we do not hide the base evaluate(const FiniteDomainNoveltyEvaluator&) method
 	
-	unsigned evaluate( const State& s ) {
-		GenericStateAdapter adaptee( s, *this );
-		return evaluate( adaptee );
+	//! Computes the novelty of the given state, evaluating all features
+	unsigned evaluate( const State& s );
+	
+	//! Computes the novelty of the given state, which is a successor of the given parent state, whose novelty must have
+	//! been computed by this same evaluator, so that all its tuples of feature values are already recorded.
+	//! Only the features that depend on some state variable whose value differs in both states are re-evaluated, and,
+	//! with the bitset tables, only the tuples that contain the value of some such feature are tested.
+	unsigned evaluate( const State& s, const State& parent );
+	
+	//! The number of evaluated states which had the given novelty
+	unsigned get_num_states(unsigned novelty) const {
+		if (_use_bitset_tables) return _bitset_tables.get_num_states(novelty);
+		if (_use_approximate_tables) return _approximate_tables.get_num_states(novelty);
+		return Base::get_num_states(novelty);
+	}
+	
+	//! The estimated probability that a tuple not seen before is deemed to have been seen, which is 0 unless
+	//! the novelty is computed through the approximate tables
+	double estimated_false_positive_rate() const {
+		return _use_approximate_tables ? _approximate_tables.estimated_false_positive_rate() : 0;
 	}
 
-	unsigned numFeatures() const { return _features.size(); }
-	NoveltyFeature::ptr feature( unsigned i ) const { return _features[i]; }
+	unsigned numFeatures() const { return _features->size(); }
+	const NoveltyFeature* feature( unsigned i ) const { return _features->feature(i); }
+	
+	//! The (remapped) value of the i-th feature on the given state
+	aptk::ValueIndex evaluateFeature( unsigned i, const State& s ) const { return _features->evaluate(s, i); }
 
 
 protected:
-	//! Select and create the state features that we will use henceforth to compute the novelty
-	void selectFeatures(const Problem& problem, const NoveltyFeaturesConfiguration& feature_configuration);
+	//! Set up the native bitset novelty tables, if they support the selected features and novelty bound
+	void setupBitsetTables(unsigned novelty_bound);
 	
-	//! An array with all the features that we take into account when computing the novelty
-	std::vector<NoveltyFeature::ptr> _features;
+	//! The features that we take into account when computing the novelty
+	std::shared_ptr<const NoveltyFeatureSet> _features;
+	
+	//! Whether the novelty is computed through the native bitset tables rather than through the aptk tables
+	bool _use_bitset_tables;
+	BitsetNoveltyTables _bitset_tables;
+	
+	//! Whether the novelty is computed through the approximate, memory-bounded tables
+	bool _use_approximate_tables;
+	ApproximateNoveltyTables _approximate_tables;
+	
+	//! Buffers for the valuation of the features on the state being evaluated, and for the atoms that hold in it
+	std::vector<aptk::ValueIndex> _valuation;
+	std::vector<uint64_t> _satisfied;
+	
+	//! The last parent state on which the features have been evaluated, its valuation of the features and the atoms that hold in it
+	std::shared_ptr<const State> _parent;
+	std::vector<aptk::ValueIndex> _parent_valuation;
+	std::vector<uint64_t> _parent_satisfied;
+	
+	//! Buffers with the state variables and the features whose value changed with respect to the parent state, and with
+	//! the features re-evaluated in the current evaluation, along with a marker of the latter
+	std::vector<VariableIdx> _changed_variables;
+	std::vector<unsigned> _changed;
+	std::vector<unsigned> _considered;
+	std::vector<bool> _is_considered;
 };
 
 
@@ -7,20 +7,50 @@ namespace fs0 {
 
 class NoveltyFeaturesConfiguration {
 public:
-	NoveltyFeaturesConfiguration(bool use_state_vars, bool use_goal, bool use_actions)
-		: _use_state_vars(use_state_vars), _use_goal(use_goal), _use_actions(use_actions) {}
+	//! The implementation of the novelty tables that record the tuples of feature values seen so far:
+	//! the generic aptk tables, the native bitset tables for widths 1 and 2, or the approximate, memory-bounded tables
+	enum class Tables { APTK, BITSET, APPROXIMATE };
+	
+	NoveltyFeaturesConfiguration(bool use_state_vars, bool use_goal, bool use_actions, Tables tables = Tables::APTK,
+	                             unsigned approximate_memory = 64, unsigned approximate_hashes = 4)
+		: _use_state_vars(use_state_vars), _use_goal(use_goal), _use_actions(use_actions), _tables(tables),
+		  _approximate_memory(approximate_memory), _approximate_hashes(approximate_hashes) {}
 	
 	//! Create a NoveltyFeaturesConfiguration object from a global configuration object
 	NoveltyFeaturesConfiguration(const Config& config)
 		: NoveltyFeaturesConfiguration(
 			config.getOption<bool>("engine.use_state_vars"),
 			config.getOption<bool>("engine.use_goal"),
-			config.getOption<bool>("engine.use_actions"))
+			config.getOption<bool>("engine.use_actions"),
+			parse_tables(config.getOption<std::string>("engine.novelty_tables", "aptk")),
+			positive(config, "engine.novelty_memory", 64),
+			positive(config, "engine.novelty_hashes", 4))
 	{}
 
 	bool useStateVars() const { return _use_state_vars; }
 	bool useGoal() const { return _use_goal; }
 	bool useActions() const { return _use_actions; }
+	Tables tables() const { return _tables; }
+	
+	//! The memory budget, in MB, of the approximate novelty tables of a search, which is shared by all of its novelty partitions
+	unsigned approximateMemory() const { return _approximate_memory; }
+	
+	//! The number of bits set per tuple in the approximate novelty tables
+	unsigned approximateHashes() const { return _approximate_hashes; }
+	
+	//! Returns the value of the given integer option, which must be positive
+	static unsigned positive(const Config& config, const std::string& key, int default_value) {
+		int value = config.getOption<int>(key, default_value);
+		if (value < 1) throw std::runtime_error("Option '" + key + "' must be a positive integer");
+		return static_cast<unsigned>(value);
+	}
+	
+	static Tables parse_tables(const std::string& name) {
+		if (name == "aptk") return Tables::APTK;
+		if (name == "bitset") return Tables::BITSET;
+		if (name == "approximate") return Tables::APPROXIMATE;
+		throw std::runtime_error("Unknown novelty tables implementation: " + name);
+	}
 	
 	//! Prints a representation of the object to the given stream.
 	friend std::ostream& operator<<(std::ostream &os, const NoveltyFeaturesConfiguration&  o) { return o.print(os); }
@@ -29,6 +59,8 @@ public:
 		os << "state variables: " << ( _use_state_vars ? "yes" : "no");
 		os << "goal: " << (_use_goal ? "yes" : "no");
 		os << "actions: " << (_use_actions ? "yes" : "no");
+		os << "tables: " << (_tables == Tables::BITSET ? "bitset" : (_tables == Tables::APPROXIMATE ? "approximate" : "aptk"));
+		if (_tables == Tables::APPROXIMATE) os << " (" << _approximate_memory << " MB, " << _approximate_hashes << " hashes)";
 		os << "]";
 		return os;
 	}
@@ -37,6 +69,9 @@ protected:
 	bool _use_state_vars;
 	bool _use_goal;
 	bool _use_actions;
+	Tables _tables;
+	unsigned _approximate_memory;
+	unsigned _approximate_hashes;
 };
 
 }
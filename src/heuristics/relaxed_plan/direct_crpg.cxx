@@ -11,7 +11,7 @@
 namespace fs0 {
 
 DirectCRPG::DirectCRPG(const Problem& problem, std::vector<std::unique_ptr<DirectActionManager>>&& managers, std::shared_ptr<DirectRPGBuilder> builder) :
-	_problem(problem), _managers(std::move(managers)), all_whitelist(managers.size()), _builder(builder)
+	_problem(problem), _managers(std::move(managers)), all_whitelist(_managers.size()), _builder(builder), _relaxed_plan_atoms(nullptr)
 {
 	LPT_DEBUG("heuristic", "Relaxed Plan heuristic initialized with builder: " << std::endl << *_builder);
     std::iota(all_whitelist.begin(), all_whitelist.end(), 0);
@@ -21,6 +21,14 @@ long DirectCRPG::evaluate(const State& seed) {
 	return evaluate(seed, all_whitelist); // If no whitelist is provided, all actions are considered.
 }
 
+long DirectCRPG::evaluate(const State& seed, std::vector<Atom>& relaxed_plan_atoms) {
+	relaxed_plan_atoms.clear();
+	_relaxed_plan_atoms = &relaxed_plan_atoms;
+	long h = evaluate(seed, all_whitelist);
+	_relaxed_plan_atoms = nullptr;
+	return h;
+}
+
 //! The actual evaluation of the heuristic value for any given non-relaxed state s.
 long DirectCRPG::evaluate(const State& seed, const std::vector<ActionIdx>& whitelist) {
 	
@@ -76,6 +84,7 @@ long DirectCRPG::computeHeuristic(const State& seed, const RelaxedState& state,
 	if (_builder->isGoal(seed, state, causes)) {
 		auto extractor = RelaxedPlanExtractorFactory<RPGData>::create(seed, bookkeeping);
 		long cost = extractor->computeRelaxedPlanCost(causes);
+		if (_relaxed_plan_atoms) _relaxed_plan_atoms->assign(extractor->getRelaxedPlanAtoms().begin(), extractor->getRelaxedPlanAtoms().end());
 		delete extractor;
 		return cost;
 	} else return -1;
@@ -31,6 +31,9 @@ public:
 	//! A version where only certain actions are allowed
 	long evaluate(const State& seed, const std::vector<ActionIdx>& whitelist);
 	
+	//! A version that stores into 'relaxed_plan_atoms' the atoms achieved by the relaxed plan
+	long evaluate(const State& seed, std::vector<Atom>& relaxed_plan_atoms);
+	
 	//! The computation of the heuristic value. Returns -1 if the RPG layer encoded in the relaxed state is not a goal,
 	//! otherwise returns h_{FF}.
 	//! To be subclassed in other RPG-based heuristics such as h_max
@@ -48,6 +51,9 @@ protected:
 	
 	//! The RPG building helper
 	const std::shared_ptr<DirectRPGBuilder> _builder;
+	
+	//! Where to store the atoms of the relaxed plan being computed, if requested
+	std::vector<Atom>* _relaxed_plan_atoms;
 };
 
 //! The h_max version
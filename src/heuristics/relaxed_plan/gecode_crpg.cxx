@@ -30,7 +30,7 @@ long GecodeCRPG::evaluate(const State& seed) {
 	
 	if (_problem.getGoalSatManager().satisfied(seed)) return 0; // The seed state is a goal
 	
-	RPGIndex graph(seed, _tuple_index, _extension_handler);
+	RPGIndex graph(seed, _tuple_index, _extension_handler, _arena);
 	
 	if (Config::instance().useMinHMaxGoalValueSelector()) {
 		_goal_handler->init_value_selector(&graph);
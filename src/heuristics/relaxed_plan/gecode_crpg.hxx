@@ -3,6 +3,7 @@
 
 #include <fs_types.hxx>
 #include <constraints/gecode/extensions.hxx>
+#include <heuristics/relaxed_plan/rpg_arena.hxx>
 
 namespace fs0 { class Problem; class State; class RPGData; }
 
@@ -43,6 +44,9 @@ protected:
 	//!
 	ExtensionHandler _extension_handler;
 	
+	//! The memory of the RPG data, reused by all evaluations
+	RPGArena _arena;
+	
 	std::unique_ptr<FormulaCSP> _goal_handler;
 };
 
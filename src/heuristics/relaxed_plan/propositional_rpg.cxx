@@ -0,0 +1,396 @@
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <tuple>
+
+#include <heuristics/relaxed_plan/propositional_rpg.hxx>
+#include <actions/actions.hxx>
+#include <actions/successor_generator.hxx>
+#include <problem.hxx>
+#include <problem_info.hxx>
+#include <state.hxx>
+#include <utils/tuple_index.hxx>
+#include <languages/fstrips/language.hxx>
+#include <aptk2/tools/logging.hxx>
+
+namespace fs0 {
+
+const PropositionalRPG::Cost PropositionalRPG::INFINITE_COST = std::numeric_limits<Cost>::max();
+const ActionIdx PropositionalRPG::NO_SUPPORTER = std::numeric_limits<ActionIdx>::max();
+
+//! Computes the inverse of a relation between a range of keys and a set of items, given as contiguous arrays as described
+//! in the header, e.g. the actions achieving each atom from the atoms achieved by each action
+static void invert(const std::vector<unsigned>& offsets, const std::vector<unsigned>& items, unsigned num_items,
+                   std::vector<unsigned>& inverse_offsets, std::vector<unsigned>& inverse) {
+	inverse_offsets.assign(num_items + 1, 0);
+	for (unsigned item:items) ++inverse_offsets[item + 1];
+	for (unsigned item = 0; item < num_items; ++item) inverse_offsets[item + 1] += inverse_offsets[item];
+	
+	inverse.resize(items.size());
+	std::vector<unsigned> position(inverse_offsets.begin(), inverse_offsets.end() - 1);
+	for (unsigned key = 0; key + 1 < offsets.size(); ++key) {
+		for (unsigned i = offsets[key]; i < offsets[key + 1]; ++i) inverse[position[items[i]]++] = key;
+	}
+}
+
+PropositionalRPG::PropositionalRPG(const Problem& problem, Type type, bool incremental) :
+	_problem(problem), _type(type), _incremental(incremental), _variable_atoms(), _lower(),
+	_precondition_offsets(1, 0), _preconditions(), _effect_offsets(1, 0), _effects(), _precondition_of_offsets(), _precondition_of(),
+	_achiever_offsets(), _achievers(), _num_preconditions(), _unconditional(), _goal_atoms(), _is_goal(problem.get_tuple_index().size(), false), _unreachable_goal(false),
+	_atom_cost(problem.get_tuple_index().size()), _supporter(problem.get_tuple_index().size()), _unsatisfied(), _action_cost(), _queue(),
+	_atom_in_plan(problem.get_tuple_index().size(), false), _action_in_plan(problem.getGroundActions().size(), false), _plan_atoms(), _plan_actions(),
+	_relaxed_plan_atoms(nullptr), _seed_atoms(), _invalidated(), _is_invalidated(problem.get_tuple_index().size(), false),
+	_num_repairs(0), _num_rebuilds(0)
+{
+	if (!is_supported(problem)) throw std::runtime_error("The propositional RPG cannot process the given problem");
+	
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	const TupleIndex& tuple_index = problem.get_tuple_index();
+	
+	// Note that the tuple index only contains the positive atoms of predicative state variables
+	std::vector<ObjectIdx> upper(info.getNumVariables(), std::numeric_limits<ObjectIdx>::min());
+	_lower.resize(info.getNumVariables(), std::numeric_limits<ObjectIdx>::max());
+	for (TupleIdx tuple = 0; tuple < tuple_index.size(); ++tuple) {
+		const Atom& atom = tuple_index.to_atom(tuple);
+		_lower[atom.getVariable()] = std::min(_lower[atom.getVariable()], atom.getValue());
+		upper[atom.getVariable()] = std::max(upper[atom.getVariable()], atom.getValue());
+	}
+	_variable_atoms.resize(info.getNumVariables());
+	for (VariableIdx variable = 0; variable < info.getNumVariables(); ++variable) {
+		if (upper[variable] >= _lower[variable]) _variable_atoms[variable].resize(upper[variable] - _lower[variable] + 1, INVALID_TUPLE);
+	}
+	for (TupleIdx tuple = 0; tuple < tuple_index.size(); ++tuple) {
+		const Atom& atom = tuple_index.to_atom(tuple);
+		_variable_atoms[atom.getVariable()][atom.getValue() - _lower[atom.getVariable()]] = tuple;
+	}
+	
+	const std::vector<const GroundAction*>& actions = problem.getGroundActions();
+	for (ActionIdx action = 0; action < actions.size(); ++action) {
+		// Actions that can never be applied have no effects and a precondition that is never satisfied
+		std::vector<TupleIdx> precondition;
+		if (actions[action]->getPrecondition()->is_contradiction() || !atoms(actions[action]->getPrecondition(), precondition)) {
+			_precondition_offsets.push_back(_preconditions.size());
+			_effect_offsets.push_back(_effects.size());
+			_num_preconditions.push_back(1);
+			continue;
+		}
+		
+		if (precondition.empty()) _unconditional.push_back(action);
+		_preconditions.insert(_preconditions.end(), precondition.begin(), precondition.end());
+		_precondition_offsets.push_back(_preconditions.size());
+		_num_preconditions.push_back(precondition.size());
+		
+		// Delete effects of predicative variables have no corresponding atom, and are simply ignored
+		for (const fs::ActionEffect* effect:actions[action]->getEffects()) {
+			VariableIdx variable = dynamic_cast<const fs::StateVariable*>(effect->lhs())->getValue();
+			TupleIdx achieved = atom(variable, dynamic_cast<const fs::Constant*>(effect->rhs())->getValue());
+			if (achieved != INVALID_TUPLE) _effects.push_back(achieved);
+		}
+		_effect_offsets.push_back(_effects.size());
+	}
+	
+	// Index the actions by each of their preconditions and, for the repairs of incremental mode, by each of their effects
+	invert(_precondition_offsets, _preconditions, tuple_index.size(), _precondition_of_offsets, _precondition_of);
+	if (_incremental) invert(_effect_offsets, _effects, tuple_index.size(), _achiever_offsets, _achievers);
+	
+	_unreachable_goal = !atoms(problem.getGoalConditions(), _goal_atoms);
+	if (_unreachable_goal) _goal_atoms.clear();
+	for (TupleIdx atom:_goal_atoms) _is_goal[atom] = true;
+	
+	_action_cost.resize(actions.size());
+	
+	LPT_INFO("main", "Propositional RPG: " << actions.size() << " actions compiled over " << tuple_index.size() << " atoms, with "
+	                 << _preconditions.size() << " preconditions and " << _effects.size() << " effects" << (_incremental ? ", incremental mode" : ""));
+}
+
+PropositionalRPG::~PropositionalRPG() {
+	if (_num_repairs + _num_rebuilds > 0) {
+		LPT_INFO("heuristic", "Propositional RPG: " << _num_repairs << " incremental repairs, " << _num_rebuilds << " full rebuilds");
+	}
+}
+
+long PropositionalRPG::evaluate(const State& seed) {
+	if (_unreachable_goal) return -1;
+	
+	if (!_incremental) {
+		if (!explore(seed, false)) return -1;
+		return heuristic_value();
+	}
+	
+	// The first state, and those too different from the previous one, are explored from scratch
+	if (_num_repairs + _num_rebuilds > 0 && repair(seed)) {
+		++_num_repairs;
+	} else {
+		++_num_rebuilds;
+		explore(seed, true);
+	}
+	return heuristic_value();
+}
+
+long PropositionalRPG::heuristic_value() {
+	for (TupleIdx atom:_goal_atoms) {
+		if (_atom_cost[atom] == INFINITE_COST) return -1;
+	}
+	
+	if (_type == Type::HFF || _relaxed_plan_atoms) {
+		unsigned num_actions = extract_relaxed_plan();
+		if (_type == Type::HFF) return num_actions;
+	}
+	
+	long h = 0;
+	for (TupleIdx atom:_goal_atoms) {
+		if (_type == Type::HMAX) h = std::max<long>(h, _atom_cost[atom]);
+		else h += _atom_cost[atom];
+	}
+	return h;
+}
+
+long PropositionalRPG::evaluate(const State& seed, std::vector<Atom>& relaxed_plan_atoms) {
+	relaxed_plan_atoms.clear();
+	_relaxed_plan_atoms = &relaxed_plan_atoms;
+	long h = evaluate(seed);
+	_relaxed_plan_atoms = nullptr;
+	return h;
+}
+
+bool PropositionalRPG::explore(const State& seed, bool complete) {
+	std::fill(_atom_cost.begin(), _atom_cost.end(), INFINITE_COST);
+	std::fill(_supporter.begin(), _supporter.end(), NO_SUPPORTER);
+	std::fill(_action_cost.begin(), _action_cost.end(), 0);
+	_unsatisfied = _num_preconditions;
+	_queue.clear();
+	
+	_seed_atoms.resize(_variable_atoms.size());
+	for (VariableIdx variable = 0; variable < _variable_atoms.size(); ++variable) {
+		TupleIdx reached = atom(variable, seed.getValue(variable));
+		_seed_atoms[variable] = reached;
+		if (reached != INVALID_TUPLE) enqueue(reached, 0);
+	}
+	for (ActionIdx action:_unconditional) apply(action);
+	
+	unsigned pending_goals = _goal_atoms.size();
+	while (!_queue.empty() && (complete || pending_goals > 0)) {
+		Cost cost;
+		TupleIdx atom;
+		std::tie(cost, atom) = dequeue();
+		if (cost > _atom_cost[atom]) continue; // A stale entry, the atom has already been processed with a lower cost
+		
+		if (_is_goal[atom]) --pending_goals;
+		
+		for (unsigned i = _precondition_of_offsets[atom]; i < _precondition_of_offsets[atom + 1]; ++i) {
+			ActionIdx action = _precondition_of[i];
+			if (_type == Type::HMAX) _action_cost[action] = std::max(_action_cost[action], cost);
+			else _action_cost[action] += cost;
+			if (--_unsatisfied[action] == 0) apply(action);
+		}
+	}
+	return pending_goals == 0;
+}
+
+bool PropositionalRPG::repair(const State& seed) {
+	const std::size_t max_invalidated = _atom_cost.size() / MAX_REPAIR_FRACTION;
+	std::vector<TupleIdx> added;
+	_invalidated.clear();
+	_queue.clear();
+	
+	for (VariableIdx variable = 0; variable < _variable_atoms.size(); ++variable) {
+		TupleIdx previous = _seed_atoms[variable], current = atom(variable, seed.getValue(variable));
+		if (previous == current) continue;
+		_seed_atoms[variable] = current;
+		if (current != INVALID_TUPLE) added.push_back(current);
+		if (previous != INVALID_TUPLE) {
+			_is_invalidated[previous] = true;
+			_invalidated.push_back(previous);
+		}
+	}
+	
+	// The costs of the atoms no longer in the seed state, and of all atoms whose best supporter has some invalidated
+	// precondition, are no longer justified
+	for (unsigned k = 0; k < _invalidated.size() && _invalidated.size() <= max_invalidated; ++k) {
+		TupleIdx invalidated = _invalidated[k];
+		for (unsigned i = _precondition_of_offsets[invalidated]; i < _precondition_of_offsets[invalidated + 1]; ++i) {
+			ActionIdx action = _precondition_of[i];
+			for (unsigned j = _effect_offsets[action]; j < _effect_offsets[action + 1]; ++j) {
+				TupleIdx effect = _effects[j];
+				if (_supporter[effect] != action || _is_invalidated[effect]) continue;
+				_is_invalidated[effect] = true;
+				_invalidated.push_back(effect);
+			}
+		}
+	}
+	
+	for (TupleIdx invalidated:_invalidated) _is_invalidated[invalidated] = false;
+	if (_invalidated.size() > max_invalidated) return false;
+	
+	for (TupleIdx invalidated:_invalidated) {
+		_atom_cost[invalidated] = INFINITE_COST;
+		_supporter[invalidated] = NO_SUPPORTER;
+	}
+	for (TupleIdx atom:added) {
+		_supporter[atom] = NO_SUPPORTER;
+		enqueue(atom, 0);
+	}
+	
+	// The invalidated atoms get the best cost that the rest of atoms can justify, and costs are then propagated
+	for (TupleIdx invalidated:_invalidated) {
+		if (_atom_cost[invalidated] == 0) continue; // The atom is back in the seed state
+		Cost best = INFINITE_COST;
+		for (unsigned i = _achiever_offsets[invalidated]; i < _achiever_offsets[invalidated + 1]; ++i) {
+			ActionIdx action = _achievers[i];
+			Cost cost = action_cost(action);
+			if (cost != INFINITE_COST && cost + 1 < best) {
+				best = cost + 1;
+				_supporter[invalidated] = action;
+			}
+		}
+		if (best != INFINITE_COST) enqueue(invalidated, best);
+	}
+	propagate();
+	return true;
+}
+
+void PropositionalRPG::propagate() {
+	while (!_queue.empty()) {
+		Cost cost;
+		TupleIdx atom;
+		std::tie(cost, atom) = dequeue();
+		if (cost > _atom_cost[atom]) continue; // A stale entry
+		
+		for (unsigned i = _precondition_of_offsets[atom]; i < _precondition_of_offsets[atom + 1]; ++i) {
+			ActionIdx action = _precondition_of[i];
+			Cost effect_cost = action_cost(action);
+			if (effect_cost == INFINITE_COST) continue;
+			++effect_cost;
+			for (unsigned j = _effect_offsets[action]; j < _effect_offsets[action + 1]; ++j) {
+				TupleIdx effect = _effects[j];
+				if (effect_cost < _atom_cost[effect]) {
+					_supporter[effect] = action;
+					enqueue(effect, effect_cost);
+				}
+			}
+		}
+	}
+}
+
+PropositionalRPG::Cost PropositionalRPG::action_cost(ActionIdx action) const {
+	Cost cost = 0;
+	for (unsigned i = _precondition_offsets[action]; i < _precondition_offsets[action + 1]; ++i) {
+		Cost precondition = _atom_cost[_preconditions[i]];
+		if (precondition == INFINITE_COST) return INFINITE_COST;
+		if (_type == Type::HMAX) cost = std::max(cost, precondition);
+		else cost += precondition;
+	}
+	return cost;
+}
+
+void PropositionalRPG::apply(ActionIdx action) {
+	Cost cost = _action_cost[action] + 1;
+	for (unsigned i = _effect_offsets[action]; i < _effect_offsets[action + 1]; ++i) {
+		TupleIdx atom = _effects[i];
+		if (cost < _atom_cost[atom]) {
+			_supporter[atom] = action;
+			enqueue(atom, cost);
+		}
+	}
+}
+
+void PropositionalRPG::enqueue(TupleIdx atom, Cost cost) {
+	_atom_cost[atom] = cost;
+	_queue.push_back(std::make_pair(cost, atom));
+	std::push_heap(_queue.begin(), _queue.end(), std::greater<std::pair<Cost, TupleIdx>>());
+}
+
+std::pair<PropositionalRPG::Cost, TupleIdx> PropositionalRPG::dequeue() {
+	std::pop_heap(_queue.begin(), _queue.end(), std::greater<std::pair<Cost, TupleIdx>>());
+	auto entry = _queue.back();
+	_queue.pop_back();
+	return entry;
+}
+
+unsigned PropositionalRPG::extract_relaxed_plan() {
+	_plan_atoms.assign(_goal_atoms.begin(), _goal_atoms.end());
+	_plan_actions.clear();
+	
+	for (unsigned k = 0; k < _plan_atoms.size(); ++k) {
+		TupleIdx atom = _plan_atoms[k];
+		if (_atom_cost[atom] == 0 || _atom_in_plan[atom]) continue; // Atoms in the seed state need no support
+		_atom_in_plan[atom] = true;
+		if (_relaxed_plan_atoms) _relaxed_plan_atoms->push_back(_problem.get_tuple_index().to_atom(atom));
+		
+		ActionIdx action = _supporter[atom];
+		assert(action != NO_SUPPORTER);
+		if (_action_in_plan[action]) continue;
+		_action_in_plan[action] = true;
+		_plan_actions.push_back(action);
+		_plan_atoms.insert(_plan_atoms.end(), _preconditions.begin() + _precondition_offsets[action], _preconditions.begin() + _precondition_offsets[action + 1]);
+	}
+	
+	for (TupleIdx atom:_plan_atoms) _atom_in_plan[atom] = false;
+	for (ActionIdx action:_plan_actions) _action_in_plan[action] = false;
+	return _plan_actions.size();
+}
+
+TupleIdx PropositionalRPG::atom(VariableIdx variable, ObjectIdx value) const {
+	const std::vector<TupleIdx>& atoms = _variable_atoms[variable];
+	ObjectIdx offset = value - _lower[variable];
+	if (offset < 0 || offset >= (ObjectIdx) atoms.size()) return INVALID_TUPLE;
+	return atoms[offset];
+}
+
+bool PropositionalRPG::atoms(const fs::Formula* formula, std::vector<TupleIdx>& atoms) const {
+	std::vector<std::pair<VariableIdx, ObjectIdx>> conditions;
+	extract_conditions(formula, conditions);
+	atoms.clear();
+	for (const auto& condition:conditions) {
+		TupleIdx atom = this->atom(condition.first, condition.second);
+		if (atom == INVALID_TUPLE) return false; // The value is outside the domain of the variable
+		atoms.push_back(atom);
+	}
+	std::sort(atoms.begin(), atoms.end());
+	atoms.erase(std::unique(atoms.begin(), atoms.end()), atoms.end());
+	return true;
+}
+
+bool PropositionalRPG::extract_conditions(const fs::Formula* formula, std::vector<std::pair<VariableIdx, ObjectIdx>>& conditions) {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	std::vector<SuccessorGenerator::Condition> inequalities;
+	conditions.clear();
+	if (!SuccessorGenerator::extract_conditions(formula, conditions, inequalities) || !inequalities.empty()) return false;
+	
+	// Negated atoms of predicative variables are not in the tuple index
+	for (const auto& condition:conditions) {
+		if (info.isPredicativeVariable(condition.first) && condition.second == 0) return false;
+	}
+	return true;
+}
+
+bool PropositionalRPG::is_supported(const fs::ActionEffect* effect) {
+	return dynamic_cast<const fs::StateVariable*>(effect->lhs()) && dynamic_cast<const fs::Constant*>(effect->rhs()) && effect->condition()->is_tautology();
+}
+
+bool PropositionalRPG::is_supported(const Problem& problem) {
+	if (!problem.getStateConstraints()->is_tautology()) return false;
+	
+	std::vector<std::pair<VariableIdx, ObjectIdx>> conditions;
+	if (!extract_conditions(problem.getGoalConditions(), conditions)) return false;
+	
+	for (const GroundAction* action:problem.getGroundActions()) {
+		if (action->getPrecondition()->is_contradiction()) continue;
+		if (!extract_conditions(action->getPrecondition(), conditions)) return false;
+		for (const fs::ActionEffect* effect:action->getEffects()) {
+			if (!is_supported(effect)) return false;
+		}
+	}
+	return true;
+}
+
+PropositionalRPG::Type PropositionalRPG::parse_type(const std::string& name) {
+	if (name == "hmax") return Type::HMAX;
+	if (name == "hadd") return Type::HADD;
+	if (name == "hff") return Type::HFF;
+	throw std::runtime_error("Unknown propositional RPG heuristic: " + name);
+}
+
+} // namespaces
@@ -0,0 +1,172 @@
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <fs_types.hxx>
+#include <atom.hxx>
+
+namespace fs0 { namespace language { namespace fstrips { class Formula; class ActionEffect; } }}
+namespace fs = fs0::language::fstrips;
+
+namespace fs0 {
+
+class Problem;
+class State;
+
+/**
+ * A relaxed-planning engine for problems where all action preconditions and goals are conjunctions of atoms X = c, and
+ * all action effects are unconditional assignments X := c, where X is a state variable and c a constant, which is always
+ * the case e.g. in STRIPS problems. As in the rest of RPGs, the atoms are those of the tuple index, and hence the
+ * preconditions and goals cannot contain negated predicative atoms, whereas delete effects are ignored.
+ * Ground actions are compiled into flat arrays over the atom indexes, and the heuristic values are computed with a
+ * generalized Dijkstra exploration that keeps a counter of unsatisfied preconditions per action, without building any
+ * constraint network. hFF is computed as the number of different actions in the relaxed plan built backwards from the
+ * goal atoms with the best supporter of each atom.
+ *
+ * In incremental mode, the costs and supporters of all atoms are kept after each evaluation, and the next state is
+ * evaluated by repairing them, rather than from scratch: the atoms whose support depends on atoms no longer in the seed
+ * state are invalidated and recomputed, and the cost decreases due to the new atoms of the seed are propagated, as in
+ * dynamic shortest-path algorithms. Since the states evaluated one after the other are usually siblings or parent and
+ * child, the repair touches only a small part of the graph. The resulting h_max and h_add values are exactly those of a
+ * full computation, while hFF might differ due to a different choice of supporters among those of equal cost.
+ */
+class PropositionalRPG {
+public:
+	//! The heuristic value to be computed
+	enum class Type { HMAX, HADD, HFF };
+	
+	PropositionalRPG(const Problem& problem, Type type, bool incremental = false);
+	~PropositionalRPG();
+	
+	PropositionalRPG(const PropositionalRPG&) = delete;
+	PropositionalRPG(PropositionalRPG&&) = default;
+	PropositionalRPG& operator=(const PropositionalRPG& other) = delete;
+	PropositionalRPG& operator=(PropositionalRPG&& other) = default;
+	
+	//! Returns the heuristic value of the given state, or -1 if the goal is unreachable from it
+	long evaluate(const State& seed);
+	
+	//! A version that stores into 'relaxed_plan_atoms' the atoms achieved by the relaxed plan
+	long evaluate(const State& seed, std::vector<Atom>& relaxed_plan_atoms);
+	
+	//! Returns true iff the ground actions, goal and state constraints of the problem can be handled by the engine
+	static bool is_supported(const Problem& problem);
+	
+	//! Returns the type of heuristic corresponding to the given name, i.e. one of "hmax", "hadd" or "hff"
+	static Type parse_type(const std::string& name);
+	
+protected:
+	typedef unsigned Cost;
+	
+	static const Cost INFINITE_COST;
+	static const ActionIdx NO_SUPPORTER;
+	
+	//! In incremental mode, the graph is rebuilt from scratch instead of repaired when the number of atoms that
+	//! would need to be invalidated exceeds this fraction of all atoms
+	static const unsigned MAX_REPAIR_FRACTION = 4;
+	
+	const Problem& _problem;
+	
+	Type _type;
+	
+	bool _incremental;
+	
+	//! '_variable_atoms[x][v - _lower[x]]' is the index of the atom X = v, or INVALID_TUPLE if there is no such atom
+	std::vector<std::vector<TupleIdx>> _variable_atoms;
+	std::vector<ObjectIdx> _lower;
+	
+	//! The atoms in the precondition / effects of each action, and the actions having each atom as a precondition,
+	//! stored in contiguous arrays, e.g. the preconditions of action 'a' are those in the range
+	//! [_preconditions[_precondition_offsets[a]], _preconditions[_precondition_offsets[a + 1]])
+	std::vector<unsigned> _precondition_offsets;
+	std::vector<TupleIdx> _preconditions;
+	std::vector<unsigned> _effect_offsets;
+	std::vector<TupleIdx> _effects;
+	std::vector<unsigned> _precondition_of_offsets;
+	std::vector<ActionIdx> _precondition_of;
+	std::vector<unsigned> _achiever_offsets;
+	std::vector<ActionIdx> _achievers;
+	
+	//! The number of (different) preconditions of each action. Actions that can never be applied have a single
+	//! precondition that is never reached.
+	std::vector<unsigned> _num_preconditions;
+	
+	//! The actions with empty preconditions
+	std::vector<ActionIdx> _unconditional;
+	
+	std::vector<TupleIdx> _goal_atoms;
+	std::vector<bool> _is_goal;
+	
+	//! Whether some goal atom X = c has no corresponding tuple, i.e. c is not in the domain of X, and hence can never be reached
+	bool _unreachable_goal;
+	
+	//! The bookkeeping of the exploration: the cost and best supporter of each atom, the number of unsatisfied
+	//! preconditions and accumulated precondition cost of each action, and a binary heap of <cost, atom> entries
+	std::vector<Cost> _atom_cost;
+	std::vector<ActionIdx> _supporter;
+	std::vector<unsigned> _unsatisfied;
+	std::vector<Cost> _action_cost;
+	std::vector<std::pair<Cost, TupleIdx>> _queue;
+	
+	//! Buffers for the extraction of relaxed plans
+	std::vector<bool> _atom_in_plan;
+	std::vector<bool> _action_in_plan;
+	std::vector<TupleIdx> _plan_atoms;
+	std::vector<ActionIdx> _plan_actions;
+	
+	//! Where to store the atoms of the relaxed plan being computed, if requested
+	std::vector<Atom>* _relaxed_plan_atoms;
+	
+	//! In incremental mode, the seed state atoms of the last graph, if any, and some statistics
+	std::vector<TupleIdx> _seed_atoms;
+	std::vector<TupleIdx> _invalidated;
+	std::vector<bool> _is_invalidated;
+	unsigned long _num_repairs;
+	unsigned long _num_rebuilds;
+	
+	//! Runs the exploration from the given state until all goal atoms are reached, or until a fixpoint if 'complete'
+	//! is true, returning false if some goal atom is unreachable
+	bool explore(const State& seed, bool complete);
+	
+	//! Repairs the costs of the last (complete) exploration for the given state, returning false if the repair would
+	//! be too costly, in which case the costs are left in an inconsistent state
+	bool repair(const State& seed);
+	
+	//! The aggregated cost of the preconditions of the given action, or INFINITE_COST if any of them is not reached
+	Cost action_cost(ActionIdx action) const;
+	
+	//! Propagates through the actions the costs of the atoms in the queue
+	void propagate();
+	
+	//! Returns the heuristic value for the current costs, or -1 if some goal atom is unreachable
+	long heuristic_value();
+	
+	//! Updates the cost of the effects of the given action, all of whose preconditions have been reached
+	void apply(ActionIdx action);
+	
+	void enqueue(TupleIdx atom, Cost cost);
+	
+	//! Pops the entry with lowest cost from the queue
+	std::pair<Cost, TupleIdx> dequeue();
+	
+	//! Extracts a relaxed plan from the costs and supporters of the last exploration, and returns its number of actions
+	unsigned extract_relaxed_plan();
+	
+	//! Returns the index of the atom X = v, or INVALID_TUPLE if X is a predicative variable and v is false
+	TupleIdx atom(VariableIdx variable, ObjectIdx value) const;
+	
+	//! Stores into 'atoms' the (sorted, unique) atoms of the given precondition or goal formula, which must be supported,
+	//! returning false if some of its conditions has no corresponding atom, and hence can never be satisfied
+	bool atoms(const fs::Formula* formula, std::vector<TupleIdx>& atoms) const;
+	
+	//! Stores into 'conditions' the pairs <X, c> of the atoms X = c of the given precondition or goal formula,
+	//! returning false if the formula is not a conjunction of such atoms
+	static bool extract_conditions(const fs::Formula* formula, std::vector<std::pair<VariableIdx, ObjectIdx>>& conditions);
+	
+	//! Returns true iff the effect is an unconditional assignment X := c
+	static bool is_supported(const fs::ActionEffect* effect);
+};
+
+} // namespaces
@@ -3,11 +3,12 @@
 #include <heuristics/relaxed_plan/rpg_index.hxx>
 #include <constraints/gecode/handlers/formula_csp.hxx>
 #include <constraints/gecode/lifted_plan_extractor.hxx>
+#include <utils/tuple_index.hxx>
 #include <aptk2/tools/logging.hxx>
 
 namespace fs0 { namespace gecode { namespace support {
 
-long compute_rpg_cost(const TupleIndex& tuple_index, const RPGIndex& graph, const FormulaCSP& goal_handler) {
+long compute_rpg_cost(const TupleIndex& tuple_index, const RPGIndex& graph, const FormulaCSP& goal_handler, std::vector<Atom>* relaxed_plan_atoms) {
 	long cost = -1;
 	if (GecodeCSP* csp = goal_handler.instantiate(graph)) {
 		if (csp->checkConsistency()) { // ATM we only take into account full goal resolution
@@ -16,6 +17,9 @@ long compute_rpg_cost(const TupleIndex& tuple_index, const RPGIndex& graph, cons
 			if (goal_handler.compute_support(csp, causes)) {
 				LiftedPlanExtractor extractor(graph, tuple_index);
 				cost = extractor.computeRelaxedPlanCost(causes);
+				if (relaxed_plan_atoms) {
+					for (TupleIdx tuple:extractor.getRelaxedPlanTuples()) relaxed_plan_atoms->push_back(tuple_index.to_atom(tuple));
+				}
 			}
 		}
 		delete csp;
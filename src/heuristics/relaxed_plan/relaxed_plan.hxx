@@ -1,13 +1,16 @@
 
 #pragma once
 
-namespace fs0 { class TupleIndex; }
+#include <vector>
+
+namespace fs0 { class TupleIndex; class Atom; }
 namespace fs0 { namespace gecode { class RPGIndex; class FormulaCSP; }}
 
 namespace fs0 { namespace gecode { namespace support {
 
-//! Compute the length of a relaxed plan, if exists, or -1 if not
-long compute_rpg_cost(const TupleIndex& tuple_index, const RPGIndex& graph, const FormulaCSP& goal_handler);
+//! Compute the length of a relaxed plan, if exists, or -1 if not.
+//! If 'relaxed_plan_atoms' is given, the atoms achieved by the relaxed plan are stored in it.
+long compute_rpg_cost(const TupleIndex& tuple_index, const RPGIndex& graph, const FormulaCSP& goal_handler, std::vector<Atom>* relaxed_plan_atoms = nullptr);
 
 long compute_hmax_cost(const TupleIndex& tuple_index, const RPGIndex& graph, const FormulaCSP& goal_handler);
 
@@ -94,6 +94,9 @@ public:
 		
 		return buildRelaxedPlan();
 	}
+	
+	//! The atoms achieved by the relaxed plan (i.e. not in the seed state), once the relaxed plan has been computed
+	const std::set<Atom>& getRelaxedPlanAtoms() const { return processed; }
 
 protected:
 	//! Put all the atoms in a given vector of atoms in the queue to be processed.
@@ -0,0 +1,48 @@
+
+#include <cassert>
+
+#include <heuristics/relaxed_plan/rpg_arena.hxx>
+#include <actions/action_id.hxx>
+
+namespace fs0 { namespace gecode {
+
+const unsigned RPGArena::UNREACHED;
+
+RPGArena::~RPGArena() {
+	release();
+}
+
+void RPGArena::prepare(unsigned num_tuples, unsigned num_variables) {
+	assert(_reached.empty() && _buffer.empty()); // The data of the previous RPG must have been released
+	if (_supports.size() != num_tuples) _supports.assign(num_tuples, TupleSupport{UNREACHED, nullptr, 0, 0});
+	if (_values.size() != num_variables) {
+		_values.resize(num_variables);
+		_changed.assign(num_variables, false);
+	}
+}
+
+void RPGArena::release() {
+	for (TupleIdx tuple:_reached) {
+		TupleSupport& support = _supports[tuple];
+		delete support.action;
+		support = TupleSupport{UNREACHED, nullptr, 0, 0};
+	}
+	_reached.clear();
+	_buffer.clear();
+	for (auto& values:_values) values.clear();
+	clear_changed();
+}
+
+void RPGArena::clear_changed() {
+	for (VariableIdx variable:_changed_variables) _changed[variable] = false;
+	_changed_variables.clear();
+}
+
+void RPGArena::add(TupleIdx tuple, unsigned layer, const ActionID* action, const std::vector<TupleIdx>& support) {
+	assert(!reached(tuple));
+	_supports[tuple] = TupleSupport{layer, action, (unsigned) _buffer.size(), (unsigned) support.size()};
+	_buffer.insert(_buffer.end(), support.begin(), support.end());
+	_reached.push_back(tuple);
+}
+
+} } // namespaces
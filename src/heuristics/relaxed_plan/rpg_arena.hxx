@@ -0,0 +1,112 @@
+
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include <fs_types.hxx>
+
+namespace fs0 { class ActionID; }
+
+namespace fs0 { namespace gecode {
+
+//! A range of tuple indexes stored contiguously in the buffer of an RPGArena. The range is invalidated as soon as
+//! further tuples are added into the arena.
+class TupleRange {
+public:
+	TupleRange(const TupleIdx* first, const TupleIdx* last) : _first(first), _last(last) {}
+
+	const TupleIdx* begin() const { return _first; }
+	const TupleIdx* end() const { return _last; }
+	std::size_t size() const { return _last - _first; }
+	bool empty() const { return _first == _last; }
+
+protected:
+	const TupleIdx* _first;
+	const TupleIdx* _last;
+};
+
+/**
+ * The memory of all the per-evaluation data of an RPGIndex that does not depend on Gecode, i.e. the supports of the reached
+ * tuples and the values reached for each state variable. Heuristics keep one arena for all their evaluations: the data
+ * of an evaluation is released when the RPGIndex is destroyed, but the memory is kept, so that in the steady state
+ * building an RPG does not require any heap allocation for that data. The supporting tuples of all reached tuples are
+ * stored one after the other in a single buffer, and each tuple support refers to them by offset and length.
+ */
+class RPGArena {
+public:
+	//! The support of a reached tuple: the layer at which it was first reached, the action that achieves it, and the position
+	//! of the tuples that support its achievement in the arena buffer.
+	struct TupleSupport {
+		unsigned layer;
+		const ActionID* action;
+		unsigned offset;
+		unsigned length;
+	};
+
+	//! The layer of the tuples not reached yet
+	static const unsigned UNREACHED = std::numeric_limits<unsigned>::max();
+
+	RPGArena() = default;
+	~RPGArena();
+
+	RPGArena(const RPGArena&) = delete;
+	RPGArena(RPGArena&&) = default;
+	RPGArena& operator=(const RPGArena&) = delete;
+	RPGArena& operator=(RPGArena&&) = default;
+
+	//! Prepares the arena to hold the data of an RPG over the given number of tuples and state variables
+	void prepare(unsigned num_tuples, unsigned num_variables);
+
+	//! Releases the data of the current RPG, including the action IDs of the tuple supports, which belong to the arena,
+	//! but keeps the allocated memory.
+	void release();
+
+	bool reached(TupleIdx tuple) const { return _supports[tuple].layer != UNREACHED; }
+
+	const TupleSupport& support(TupleIdx tuple) const { return _supports[tuple]; }
+
+	TupleRange tuples(const TupleSupport& support) const {
+		const TupleIdx* first = _buffer.data() + support.offset;
+		return TupleRange(first, first + support.length);
+	}
+
+	//! Records the support of a newly-reached tuple, taking ownership of the given action ID
+	void add(TupleIdx tuple, unsigned layer, const ActionID* action, const std::vector<TupleIdx>& support);
+
+	//! The tuples reached so far, in the order in which they were reached
+	const std::vector<TupleIdx>& reached_tuples() const { return _reached; }
+
+	//! The values reached so far for the given state variable
+	const std::vector<ObjectIdx>& values(VariableIdx variable) const { return _values[variable]; }
+	
+	//! Records a newly-reached value of the given state variable
+	void add_value(VariableIdx variable, ObjectIdx value) {
+		_values[variable].push_back(value);
+		if (!_changed[variable]) {
+			_changed[variable] = true;
+			_changed_variables.push_back(variable);
+		}
+	}
+	
+	//! The state variables that have reached new values since the last call to 'clear_changed'
+	const std::vector<VariableIdx>& changed_variables() const { return _changed_variables; }
+	
+	void clear_changed();
+
+protected:
+	//! '_supports[t]' is the support of tuple 't', whose layer is UNREACHED if the tuple has not been reached yet
+	std::vector<TupleSupport> _supports;
+
+	//! The supporting tuples of all reached tuples
+	std::vector<TupleIdx> _buffer;
+
+	std::vector<TupleIdx> _reached;
+
+	std::vector<std::vector<ObjectIdx>> _values;
+	
+	std::vector<bool> _changed;
+	std::vector<VariableIdx> _changed_variables;
+};
+
+} } // namespaces
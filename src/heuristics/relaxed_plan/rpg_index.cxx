@@ -11,9 +11,9 @@
 namespace fs0 { namespace gecode {
 
 
-RPGIndex::RPGIndex(const State& seed, const TupleIndex& tuple_index, ExtensionHandler& extension_handler) :
-	_reached(tuple_index.size(), nullptr),
-	_novel_tuples(),
+RPGIndex::RPGIndex(const State& seed, const TupleIndex& tuple_index, ExtensionHandler& extension_handler, RPGArena& arena) :
+	_arena(arena),
+	_layer_start(0),
 	_current_layer(0),
 	_extension_handler(extension_handler),
 	_tuple_index(tuple_index),
@@ -22,7 +22,7 @@ RPGIndex::RPGIndex(const State& seed, const TupleIndex& tuple_index, ExtensionHa
 	_domains.reserve(seed.numAtoms());
 	_extension_handler.reset();
 	
-	_domains_raw.resize(seed.numAtoms());
+	_arena.prepare(tuple_index.size(), seed.numAtoms());
 	
 	// Initially we insert the seed state atoms
 	for (unsigned variable = 0; variable < seed.numAtoms(); ++variable) {
@@ -37,75 +37,67 @@ RPGIndex::RPGIndex(const State& seed, const TupleIndex& tuple_index, ExtensionHa
 			_domains.push_back(Gecode::IntSet()); // We simply push an empty domain for those predicative state variables that are set to false.
 		}
 	}
+	_arena.clear_changed(); // The domains of the seed state have already been built
 	next();
 }
 
 void RPGIndex::advance() {
 	_extension_handler.advance();
 	
-	for (TupleIdx tuple:_novel_tuples) {
+	for (TupleIdx tuple:getNovelTuples()) {
 		_extension_handler.process_tuple(tuple);
 	}
 	
-	// Now update the per-variable domains
-	for (unsigned variable = 0; variable < _domains_raw.size(); ++variable) {
-		const auto& all = _domains_raw[variable];
+	// Now update the domains of those variables that have reached new values
+	for (VariableIdx variable:_arena.changed_variables()) {
+		const auto& all = _arena.values(variable);
 		// An intermediate IntArgs object seems to be necessary, since IntSets do not accept std-like range constructors.
 		_domains[variable] = Gecode::IntSet(Gecode::IntArgs(all.cbegin(), all.cend()));
 	}
+	_arena.clear_changed();
 	
 	next();
 }
 
 void RPGIndex::next() {
 	_extensions = _extension_handler.generate_extensions();
-	_novel_tuples.clear();
+	_layer_start = _arena.reached_tuples().size();
 	++_current_layer;
 }
 
 
 RPGIndex::~RPGIndex() {
-	// delete all the pointers to action IDs, which belong to this container
-	for (auto element:_reached) {
-		if (element != nullptr) {
-			const ActionID* action_id = std::get<1>(*element);
-			delete action_id;
-			delete element;
-		}
-	}
+	// Release all the supports, including the action IDs, which belong to the arena
+	_arena.release();
 }
 
 
-RPGIndex::TupleSupport* RPGIndex::createTupleSupport(const ActionID* action, std::vector<TupleIdx>&& support) const {
-	return new TupleSupport(_current_layer, action, std::move(support));
-}
-
 const RPGIndex::TupleSupport& RPGIndex::getTupleSupport(TupleIdx tuple) const {
-	auto support = _reached.at(tuple);
-	assert(support != nullptr);
-	return *support;
+	assert(tuple < _tuple_index.size() && _arena.reached(tuple));
+	return _arena.support(tuple);
 }
 
 bool RPGIndex::reached(TupleIdx tuple) const {
-	return _reached.at(tuple) != nullptr;
+	assert(tuple < _tuple_index.size());
+	return _arena.reached(tuple);
 }
 
-void RPGIndex::add(TupleIdx tuple, const ActionID* action, std::vector<TupleIdx>&& support) {
-	auto& it = _reached.at(tuple);
-	if (it != nullptr) return; // Don't insert the atom if it was already tracked by the RPG
-	it = createTupleSupport(action, std::move(support)); // This effectively inserts the tuple into '_reached'
-	_novel_tuples.push_back(tuple);
+void RPGIndex::add(TupleIdx tuple, const ActionID* action, const std::vector<TupleIdx>& support) {
+	if (reached(tuple)) { // Don't insert the atom if it was already tracked by the RPG
+		delete action;
+		return;
+	}
+	_arena.add(tuple, _current_layer, action, support); // This effectively inserts the tuple into the set of novel tuples
 	const Atom& atom = _tuple_index.to_atom(tuple);
-	auto& domain = _domains_raw.at(atom.getVariable());
 	// assert(std::find(domain.cbegin(), domain.cend(), atom.getValue()) == domain.end()); // Warning: this is expensive
-	domain.push_back(atom.getValue());
+	_arena.add_value(atom.getVariable(), atom.getValue());
 }
 
 /*
 unsigned RPGIndex::compute_hmax_sum(const std::vector<Atom>& atoms) const {
 	unsigned sum = 0;
 	for (const Atom& atom:atoms) {
-		sum += std::get<0>(getTupleSupport(atom));
+		sum += getTupleSupport(atom).layer;
 	}
 	return sum;
 }
@@ -114,14 +106,13 @@ unsigned RPGIndex::compute_hmax_sum(const std::vector<Atom>& atoms) const {
 std::ostream& RPGIndex::print(std::ostream& os) const {
 	const ProblemInfo& info = ProblemInfo::getInstance();
 	os << "RPG Tuples: " << std::endl;
-	for (unsigned i = 0; i < _reached.size(); ++i) {
-		TupleSupport* support = _reached[i];
-		if (support != nullptr) {
-			const ActionID* action_id = std::get<1>(*support);
+	for (unsigned i = 0; i < _tuple_index.size(); ++i) {
+		if (_arena.reached(i)) {
+			const TupleSupport& support = _arena.support(i);
 			os << "Tuple: " << i  << "\t(Atom: " << _tuple_index.to_atom(i) << ")\t- action: ";
-			(action_id ? os << *action_id : os << "[INVALID-ACTION]");
-			os << "\t- layer #" << std::get<0>(*support) << " - support: ";
-			printAtoms(std::get<2>(*support), os);
+			(support.action ? os << *support.action : os << "[INVALID-ACTION]");
+			os << "\t- layer #" << support.layer << " - support: ";
+			printAtoms(_arena.tuples(support), os);
 			os << std::endl;
 		}
 	}
@@ -135,15 +126,15 @@ std::ostream& RPGIndex::print(std::ostream& os) const {
 	return os;
 }
 
-void RPGIndex::printAtoms(const std::vector<TupleIdx>& vector, std::ostream& os) const {
-	for (const auto& element:vector) {
+void RPGIndex::printAtoms(const TupleRange& tuples, std::ostream& os) const {
+	for (const auto& element:tuples) {
 		os << element << ", ";
 	}
 }
 
 
 bool RPGIndex::is_true(VariableIdx variable) const {
-	const auto& domain = _domains_raw.at(variable);
+	const auto& domain = _arena.values(variable);
 	 
 	assert(domain.size() <= 1); // The variable must be predicative, thus will contain at most the element true
 	assert(domain.empty() || domain[0] == 1); // If there is one element, it must be the True element
@@ -3,6 +3,7 @@
 
 #include <gecode/int.hh>
 #include <fs_types.hxx>
+#include <heuristics/relaxed_plan/rpg_arena.hxx>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -20,27 +21,25 @@ class ExtensionHandler;
  * the atoms that make an action applicable (in a certain RPG layer) and the "extra"
  * atoms that make a particular effect reachable, i.e. those related to the relevant
  * variables of the effect procedure that achieves the effect.
+ * All the supports are stored in the given arena, which is released when the index is destroyed.
  */
 class RPGIndex {
 public:
-	//! <layer ID, Action ID, support>, where 'support' is a vector of indexes of logical symbol tuples
-	typedef std::tuple<unsigned, const ActionID*, std::vector<TupleIdx>> TupleSupport;
-	
-	//! A map from the index of a logical symbol tuple to its support in the RPG
-// 	typedef std::unordered_map<TupleIdx, TupleSupport> SupportMap;
-	typedef std::vector<TupleSupport*> SupportMap;
+	//! <layer ID, Action ID, support>, where 'support' refers to the indexes of logical symbol tuples stored in the arena
+	typedef RPGArena::TupleSupport TupleSupport;
 
 protected:
 	/**
-	 * A map with all tuples that have been reached in the RPG. Each tuple index 'I' is mapped to a pair < L, A, V >, where:
+	 * The arena with all tuples that have been reached in the RPG. Each tuple index 'I' is mapped to a triple < L, A, V >, where:
 	 * - 'L' is the first layer at which the atom has been achieved.
 	 * - 'A' is the index of one of the actions that achieves the atom.
-	 * - 'V' is a vector with the indexes of all tuples that support the achievement of tuple 'I' through the application of action A.
+	 * - 'V' are the indexes of all tuples that support the achievement of tuple 'I' through the application of action A.
 	 */
-	SupportMap _reached;
+	RPGArena& _arena;
 
-	//! This keeps a reference to the novel atoms that have been inserted in the most recent layer of the RPG.
-	std::vector<TupleIdx> _novel_tuples;
+	//! The novel atoms that have been inserted in the most recent layer of the RPG are the reached tuples of the arena
+	//! from this position onwards.
+	std::size_t _layer_start;
 
 	//! The current number of layers.
 	unsigned _current_layer;
@@ -53,15 +52,12 @@ protected:
 	//! The set of reached values for every state variable
 	std::vector<Gecode::IntSet> _domains;
 	
-	//! This is the set of all values reached so far for each state variable
-	std::vector<std::vector<ObjectIdx>> _domains_raw;
-	
 	const TupleIndex& _tuple_index;
 	
 	const State& _seed;
 
 public:
-	explicit RPGIndex(const State& seed, const TupleIndex& tuple_index, ExtensionHandler& extension_handler);
+	RPGIndex(const State& seed, const TupleIndex& tuple_index, ExtensionHandler& extension_handler, RPGArena& arena);
 	~RPGIndex();
 	
 	//! Returns true if the given tuple has already been reached in the current graph.
@@ -81,22 +77,28 @@ public:
 	//! Returns the support for the given atom
 	const TupleSupport& getTupleSupport(TupleIdx tuple) const;
 	
+	//! Returns the tuples of the given support, which are only valid until further tuples are added to the graph
+	TupleRange getSupportTuples(const TupleSupport& support) const { return _arena.tuples(support); }
+	
 	const State& getSeed() const { return _seed; }
 
 	//!
-	bool hasNovelTuples() const { return !_novel_tuples.empty(); }
+	bool hasNovelTuples() const { return num_novel_tuples() > 0; }
 	
-	std::size_t num_novel_tuples() const { return _novel_tuples.size(); }
+	std::size_t num_novel_tuples() const { return _arena.reached_tuples().size() - _layer_start; }
 	
 	
-	const std::vector<TupleIdx>& getNovelTuples() const { return _novel_tuples; }
+	TupleRange getNovelTuples() const {
+		const std::vector<TupleIdx>& reached = _arena.reached_tuples();
+		return TupleRange(reached.data() + _layer_start, reached.data() + reached.size());
+	}
 
 	//!
 	void advance();
 	
 	
-	//! Add an atom to the set of newly-reached atoms, only if it is indeed new.
-	void add(TupleIdx tuple, const ActionID* action, std::vector<TupleIdx>&& support);
+	//! Add an atom to the set of newly-reached atoms, only if it is indeed new. The graph takes ownership of the action ID.
+	void add(TupleIdx tuple, const ActionID* action, const std::vector<TupleIdx>& support);
 	
 	//! Compute the sum of h_max values of all the given atoms, assuming that they have already been reached in the RPG data structure
 // 	unsigned compute_hmax_sum(const std::vector<Atom>& atoms) const;
@@ -112,10 +114,7 @@ public:
 
 
 protected:
-	//! Creates an atom support data structure with the given data and taking into account the current RPG layer
-	TupleSupport* createTupleSupport(const ActionID* action, std::vector<TupleIdx>&& support) const;
-	
-	void printAtoms(const std::vector<TupleIdx>& vector, std::ostream& os) const;
+	void printAtoms(const TupleRange& tuples, std::ostream& os) const;
 	
 	void next();
 };
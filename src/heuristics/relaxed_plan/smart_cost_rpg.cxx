@@ -0,0 +1,147 @@
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <limits>
+
+#include <state.hxx>
+#include <actions/action_id.hxx>
+#include <heuristics/relaxed_plan/smart_cost_rpg.hxx>
+#include <heuristics/relaxed_plan/rpg_index.hxx>
+#include <applicability/formula_interpreter.hxx>
+#include <constraints/gecode/handlers/lifted_effect_csp.hxx>
+#include <aptk2/tools/logging.hxx>
+#include <utils/config.hxx>
+#include <problem.hxx>
+#include <problem_info.hxx>
+
+namespace fs0 { namespace gecode {
+
+const SmartCostRPG::Cost SmartCostRPG::INFINITE_COST = std::numeric_limits<Cost>::max();
+
+SmartCostRPG::SmartCostRPG(const Problem& problem, const fs::Formula* goal_formula, const fs::Formula* state_constraints, std::vector<EffectHandlerPtr>&& managers, ExtensionHandler extension_handler, Type type) :
+	_problem(problem),
+	_tuple_index(problem.get_tuple_index()),
+	_managers(std::move(managers)),
+	_extension_handler(extension_handler),
+	_goal_handler(std::unique_ptr<FormulaCSP>(new FormulaCSP(goal_formula->conjunction(state_constraints), _tuple_index, false))),
+	_type(type),
+	_symbol_managers(ProblemInfo::getInstance().getNumLogicalSymbols()),
+	_costs(_tuple_index.size()),
+	_candidates(_tuple_index.size()),
+	_queue(),
+	_triggered(_managers.size())
+{
+	for (unsigned i = 0; i < _managers.size(); ++i) {
+		for (unsigned symbol:_managers[i]->get_scope_symbols()) _symbol_managers[symbol].push_back(i);
+	}
+	LPT_INFO("heuristic", "SmartCostRPG heuristic initialized");
+}
+
+SmartCostRPG::~SmartCostRPG() = default;
+
+long SmartCostRPG::evaluate(const State& seed) {
+	if (_problem.getGoalSatManager().satisfied(seed)) return 0; // The seed state is a goal
+	
+	RPGIndex graph(seed, _tuple_index, _extension_handler, _arena);
+	
+	if (Config::instance().useMinHMaxGoalValueSelector()) {
+		_goal_handler->init_value_selector(&graph);
+	}
+	
+	for (TupleIdx tuple = 0; tuple < _tuple_index.size(); ++tuple) {
+		_costs[tuple] = graph.reached(tuple) ? 0 : INFINITE_COST;
+	}
+	_queue.clear();
+	std::fill(_triggered.begin(), _triggered.end(), true);
+	
+	long h = -1;
+	while (true) {
+		for (unsigned i = 0; i < _managers.size(); ++i) {
+			if (!_triggered[i]) continue;
+			_triggered[i] = false;
+			
+			// As in the SmartRPG, effects with a fixed achievable tuple that has already been reached can be safely skipped
+			TupleIdx achievable = _managers[i]->get_achievable_tuple();
+			if (achievable != INVALID_TUPLE && graph.reached(achievable)) continue;
+			
+			process(*_managers[i], graph);
+		}
+		
+		if (!advance(graph)) break; // A fixpoint has been reached, and thus there is no solution
+		LPT_EDEBUG("heuristic", "New RPG Layer: " << graph);
+		
+		h = goal_cost(graph);
+		if (h > -1) break;
+	}
+	
+	// Release the support of the candidate tuples that did not make it into the RPG
+	for (const auto& entry:_queue) _candidates[entry.second] = Candidate();
+	return h;
+}
+
+void SmartCostRPG::process(const LiftedEffectCSP& manager, const RPGIndex& graph) {
+	manager.seek_novel_tuples(graph, [this, &manager](TupleIdx tuple, const GecodeCSP* solution) {
+		std::vector<TupleIdx> support = manager.extract_support(solution);
+		Cost cost = aggregate(support) + 1;
+		if (cost >= _costs[tuple]) return;
+		
+		_costs[tuple] = cost;
+		_candidates[tuple].action = std::unique_ptr<const ActionID>(manager.get_action_id(solution));
+		_candidates[tuple].support = std::move(support);
+		_queue.push_back(std::make_pair(cost, tuple));
+		std::push_heap(_queue.begin(), _queue.end(), std::greater<std::pair<Cost, TupleIdx>>());
+	});
+}
+
+bool SmartCostRPG::advance(RPGIndex& graph) {
+	bool advanced = false;
+	Cost level = INFINITE_COST;
+	while (!_queue.empty() && _queue.front().first <= level) {
+		std::pop_heap(_queue.begin(), _queue.end(), std::greater<std::pair<Cost, TupleIdx>>());
+		Cost cost = _queue.back().first;
+		TupleIdx tuple = _queue.back().second;
+		_queue.pop_back();
+		if (cost > _costs[tuple] || graph.reached(tuple)) continue; // A stale entry
+		
+		level = cost;
+		advanced = true;
+		Candidate& candidate = _candidates[tuple];
+		graph.add(tuple, candidate.action.release(), std::move(candidate.support));
+		candidate.support.clear();
+		for (unsigned manager:_symbol_managers[_tuple_index.symbol(tuple)]) _triggered[manager] = true;
+	}
+	
+	if (advanced) graph.advance(); // Integrates the novel tuples into the graph as a new layer.
+	return advanced;
+}
+
+long SmartCostRPG::goal_cost(const RPGIndex& graph) const {
+	long cost = -1;
+	if (GecodeCSP* csp = _goal_handler->instantiate(graph)) {
+		std::vector<TupleIdx> causes;
+		if (csp->checkConsistency() && _goal_handler->compute_support(csp, causes)) { // ATM we only take into account full goal resolution
+			cost = aggregate(causes);
+		}
+		delete csp;
+	}
+	return cost;
+}
+
+SmartCostRPG::Cost SmartCostRPG::aggregate(const std::vector<TupleIdx>& tuples) const {
+	Cost cost = 0;
+	for (TupleIdx tuple:tuples) {
+		assert(_costs[tuple] != INFINITE_COST);
+		if (_type == Type::HMAX) cost = std::max(cost, _costs[tuple]);
+		else cost += _costs[tuple];
+	}
+	return cost;
+}
+
+SmartCostRPG::Type SmartCostRPG::parse_type(const std::string& name) {
+	if (name == "hmax") return Type::HMAX;
+	if (name == "hadd") return Type::HADD;
+	throw std::runtime_error("Unknown cost-based RPG heuristic: " + name);
+}
+
+} } // namespaces
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <fs_types.hxx>
+#include <constraints/gecode/extensions.hxx>
+#include <heuristics/relaxed_plan/rpg_arena.hxx>
+#include <constraints/gecode/handlers/formula_csp.hxx>
+#include <utils/tuple_index.hxx>
+
+namespace fs0 { class Problem; class State; class ActionID; }
+
+namespace fs0 { namespace language { namespace fstrips { class Formula; } }}
+namespace fs = fs0::language::fstrips;
+
+namespace fs0 { namespace gecode {
+
+class LiftedEffectCSP;
+class RPGIndex;
+
+/**
+ * A version of the SmartRPG which computes h_max or h_add costs instead of building the RPG layer by layer.
+ * Every tuple reached by some effect CSP solution gets a tentative cost of 1 plus the max / sum of the costs of the tuples
+ * of its support, and the tuples are integrated into the RPG in increasing order of cost, all tuples of the same cost at once,
+ * as in Dijkstra's algorithm. After each integration, only the effect CSPs whose scope contains a symbol of some newly
+ * reached tuple are solved again, since the solutions of the rest cannot change.
+ */
+class SmartCostRPG {
+protected:
+	typedef std::unique_ptr<LiftedEffectCSP> EffectHandlerPtr;
+	
+public:
+	//! The way in which the costs of the support of a tuple are aggregated
+	enum class Type { HMAX, HADD };
+	
+	SmartCostRPG(const Problem& problem, const fs::Formula* goal_formula, const fs::Formula* state_constraints, std::vector<EffectHandlerPtr>&& managers, ExtensionHandler extension_handler, Type type);
+	~SmartCostRPG();
+	
+	// Disallow copies of the object, as they will be expensive, but allow moves.
+	SmartCostRPG(const SmartCostRPG&) = delete;
+	SmartCostRPG(SmartCostRPG&&) = default;
+	SmartCostRPG& operator=(const SmartCostRPG& other) = delete;
+	SmartCostRPG& operator=(SmartCostRPG&& other) = default;
+	
+	//! The actual evaluation of the heuristic value for any given non-relaxed state s.
+	long evaluate(const State& seed);
+	
+	//! Returns the type of heuristic corresponding to the given name, i.e. one of "hmax" or "hadd"
+	static Type parse_type(const std::string& name);
+	
+protected:
+	typedef unsigned Cost;
+	
+	static const Cost INFINITE_COST;
+	
+	//! The best way found so far to reach a tuple not yet in the RPG
+	struct Candidate {
+		std::unique_ptr<const ActionID> action;
+		std::vector<TupleIdx> support;
+	};
+	
+	//! The actual planning problem
+	const Problem& _problem;
+	
+	const TupleIndex& _tuple_index;
+	
+	//! The set of effect managers
+	std::vector<EffectHandlerPtr> _managers;
+	
+	ExtensionHandler _extension_handler;
+	
+	//! The memory of the RPG data, reused by all evaluations
+	RPGArena _arena;
+	
+	std::unique_ptr<FormulaCSP> _goal_handler;
+	
+	Type _type;
+	
+	//! '_symbol_managers[s]' contains the indexes of the managers with symbol 's' in their scope
+	std::vector<std::vector<unsigned>> _symbol_managers;
+	
+	//! The cost of each tuple, which is final for the tuples already in the RPG and tentative for the rest
+	std::vector<Cost> _costs;
+	
+	std::vector<Candidate> _candidates;
+	
+	//! A binary heap of <cost, tuple> entries of the candidate tuples
+	std::vector<std::pair<Cost, TupleIdx>> _queue;
+	
+	//! Whether each manager has to be solved on the next RPG layer
+	std::vector<bool> _triggered;
+	
+	//! Returns the aggregated cost of the given tuples
+	Cost aggregate(const std::vector<TupleIdx>& tuples) const;
+	
+	//! Solves the given effect CSP on the given RPG, updating the candidate tuples
+	void process(const LiftedEffectCSP& manager, const RPGIndex& graph);
+	
+	//! Integrates into the RPG all the candidate tuples of minimum cost, returning false if there is none
+	bool advance(RPGIndex& graph);
+	
+	//! Returns the cost of the goal in the given RPG, or -1 if the goal is not yet reached
+	long goal_cost(const RPGIndex& graph) const;
+};
+
+} } // namespaces
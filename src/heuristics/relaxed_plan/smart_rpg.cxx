@@ -22,7 +22,8 @@ SmartRPG::SmartRPG(const Problem& problem, const fs::Formula* goal_formula, cons
 	_tuple_index(problem.get_tuple_index()),
 	_managers(std::move(managers)),
 	_extension_handler(extension_handler),
-	_goal_handler(std::unique_ptr<FormulaCSP>(new FormulaCSP(goal_formula->conjunction(state_constraints), _tuple_index, false)))
+	_goal_handler(std::unique_ptr<FormulaCSP>(new FormulaCSP(goal_formula->conjunction(state_constraints), _tuple_index, false))),
+	_relaxed_plan_atoms(nullptr)
 {
 	LPT_INFO("heuristic", "SmartRPG heuristic initialized");
 }
@@ -35,7 +36,7 @@ long SmartRPG::evaluate(const State& seed) {
 	
 	LPT_EDEBUG("heuristic", std::endl << "Computing RPG from seed state: " << std::endl << seed << std::endl << "****************************************");
 	
-	RPGIndex graph(seed, _tuple_index, _extension_handler);
+	RPGIndex graph(seed, _tuple_index, _extension_handler, _arena);
 	
 	if (Config::instance().useMinHMaxGoalValueSelector()) {
 		_goal_handler->init_value_selector(&graph);
@@ -81,8 +82,16 @@ long SmartRPG::evaluate(const State& seed) {
 	}
 }
 
+long SmartRPG::evaluate(const State& seed, std::vector<Atom>& relaxed_plan_atoms) {
+	relaxed_plan_atoms.clear();
+	_relaxed_plan_atoms = &relaxed_plan_atoms;
+	long h = evaluate(seed);
+	_relaxed_plan_atoms = nullptr;
+	return h;
+}
+
 long SmartRPG::computeHeuristic(const RPGIndex& graph) {
-	return support::compute_rpg_cost(_tuple_index, graph, *_goal_handler);
+	return support::compute_rpg_cost(_tuple_index, graph, *_goal_handler, _relaxed_plan_atoms);
 }
 
 } } // namespaces
@@ -3,6 +3,7 @@
 
 #include <fs_types.hxx>
 #include <constraints/gecode/extensions.hxx>
+#include <heuristics/relaxed_plan/rpg_arena.hxx>
 #include <constraints/gecode/handlers/formula_csp.hxx>
 #include <utils/tuple_index.hxx>
 #include <unordered_set>
@@ -34,6 +35,9 @@ public:
 	//! The actual evaluation of the heuristic value for any given non-relaxed state s.
 	long evaluate(const State& seed);
 	
+	//! Same as above, but storing into 'relaxed_plan_atoms' the atoms achieved by the relaxed plan
+	long evaluate(const State& seed, std::vector<Atom>& relaxed_plan_atoms);
+	
 	//! The computation of the heuristic value. Returns -1 if the RPG layer encoded in the relaxed state is not a goal,
 	//! otherwise returns h_{FF}.
 	//! To be subclassed in other RPG-based heuristics such as h_max
@@ -52,7 +56,13 @@ protected:
 	//!
 	ExtensionHandler _extension_handler;
 	
+	//! The memory of the RPG data, reused by all evaluations
+	RPGArena _arena;
+	
 	std::unique_ptr<FormulaCSP> _goal_handler;
+	
+	//! Where to store the atoms of the relaxed plan being computed, if requested
+	std::vector<Atom>* _relaxed_plan_atoms;
 };
 
 } } // namespaces
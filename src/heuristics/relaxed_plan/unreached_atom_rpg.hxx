@@ -3,6 +3,7 @@
 
 #include <fs_types.hxx>
 #include <constraints/gecode/extensions.hxx>
+#include <heuristics/relaxed_plan/rpg_arena.hxx>
 #include <constraints/gecode/handlers/formula_csp.hxx>
 
 
@@ -49,6 +50,9 @@ protected:
 	//!
 	ExtensionHandler _extension_handler;
 	
+	//! The memory of the RPG data, reused by all evaluations
+	RPGArena _arena;
+	
 	
 	//! a map from atom index to the set of action / effect managers that can (potentially) achieve that atom.
 	//! let L = _atom_achievers[i] be the vector of all potential achievers of atom with index 'i'.
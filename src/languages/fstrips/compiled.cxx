@@ -0,0 +1,149 @@
+
+#include <languages/fstrips/compiled.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/builtin.hxx>
+#include <problem_info.hxx>
+
+namespace fs0 { namespace language { namespace fstrips {
+
+std::unique_ptr<CompiledExpression> CompiledExpression::compile(const Formula* formula) {
+	std::unique_ptr<CompiledExpression> compiled(new CompiledExpression);
+
+	if (formula->is_tautology()) return compiled;
+
+	if (formula->is_contradiction()) {
+		compiled->_code.push_back(Instruction{OpCode::FAIL, 0, 0});
+		return compiled;
+	}
+
+	if (auto atom = dynamic_cast<const AtomicFormula*>(formula)) {
+		if (!compiled->compile_atom(atom)) return nullptr;
+		return compiled;
+	}
+
+	if (auto conjunction = dynamic_cast<const Conjunction*>(formula)) {
+		for (const AtomicFormula* conjunct:conjunction->getConjuncts()) {
+			if (!compiled->compile_atom(conjunct)) return nullptr;
+		}
+		return compiled;
+	}
+
+	return nullptr; // Existentially quantified formulae need to be interpreted
+}
+
+std::unique_ptr<CompiledExpression> CompiledExpression::compile(const Term* term) {
+	std::unique_ptr<CompiledExpression> compiled(new CompiledExpression);
+	if (!compiled->compile_term(term, 0)) return nullptr;
+	return compiled;
+}
+
+bool CompiledExpression::compile_atom(const AtomicFormula* atom) {
+	auto relational = dynamic_cast<const RelationalFormula*>(atom);
+	if (!relational) return false; // External constraints such as alldiff or sum need to be interpreted
+
+	RelationalFormula::Symbol symbol = relational->symbol();
+
+	// The frequent atoms of the form X = c and X != c get a specialized instruction
+	if (symbol == RelationalFormula::Symbol::EQ || symbol == RelationalFormula::Symbol::NEQ) {
+		auto variable = dynamic_cast<const StateVariable*>(relational->lhs());
+		auto constant = dynamic_cast<const Constant*>(relational->rhs());
+		if (!variable || !constant) { // Equality and inequality are symmetric
+			variable = dynamic_cast<const StateVariable*>(relational->rhs());
+			constant = dynamic_cast<const Constant*>(relational->lhs());
+		}
+		if (variable && constant) {
+			OpCode op = (symbol == RelationalFormula::Symbol::EQ) ? OpCode::VARIABLE_EQ : OpCode::VARIABLE_NEQ;
+			_code.push_back(Instruction{op, static_cast<int32_t>(variable->getValue()), constant->getValue()});
+			return true;
+		}
+	}
+
+	switch (symbol) {
+		case RelationalFormula::Symbol::EQ:  return emit_binary(OpCode::EQ,  relational->lhs(), relational->rhs(), 0);
+		case RelationalFormula::Symbol::NEQ: return emit_binary(OpCode::NEQ, relational->lhs(), relational->rhs(), 0);
+		case RelationalFormula::Symbol::LT:  return emit_binary(OpCode::LT,  relational->lhs(), relational->rhs(), 0);
+		case RelationalFormula::Symbol::LEQ: return emit_binary(OpCode::LEQ, relational->lhs(), relational->rhs(), 0);
+		case RelationalFormula::Symbol::GT:  return emit_binary(OpCode::GT,  relational->lhs(), relational->rhs(), 0);
+		case RelationalFormula::Symbol::GEQ: return emit_binary(OpCode::GEQ, relational->lhs(), relational->rhs(), 0);
+	}
+	return false;
+}
+
+bool CompiledExpression::compile_term(const Term* term, unsigned depth) {
+	if (depth >= MAX_STACK_DEPTH) return false;
+
+	if (auto constant = dynamic_cast<const Constant*>(term)) {
+		_code.push_back(Instruction{OpCode::CONSTANT, constant->getValue(), 0});
+		return true;
+	}
+
+	if (dynamic_cast<const StateVariable*>(term) || dynamic_cast<const FluentHeadedNestedTerm*>(term)) {
+		VariableIdx variable;
+		if (!resolve_state_variable(term, variable)) return false;
+		_code.push_back(Instruction{OpCode::VARIABLE, static_cast<int32_t>(variable), 0});
+		return true;
+	}
+
+	if (auto addition = dynamic_cast<const AdditionTerm*>(term)) {
+		return emit_binary(OpCode::ADD, addition->getSubterms()[0], addition->getSubterms()[1], depth);
+	}
+
+	if (auto subtraction = dynamic_cast<const SubtractionTerm*>(term)) {
+		return emit_binary(OpCode::SUB, subtraction->getSubterms()[0], subtraction->getSubterms()[1], depth);
+	}
+
+	if (auto multiplication = dynamic_cast<const MultiplicationTerm*>(term)) {
+		return emit_binary(OpCode::MUL, multiplication->getSubterms()[0], multiplication->getSubterms()[1], depth);
+	}
+
+	return false; // Bound variables and user-defined static terms need to be interpreted
+}
+
+bool CompiledExpression::resolve_state_variable(const Term* term, VariableIdx& variable) {
+	if (auto state_variable = dynamic_cast<const StateVariable*>(term)) {
+		variable = state_variable->getValue();
+		return true;
+	}
+
+	auto fluent = dynamic_cast<const FluentHeadedNestedTerm*>(term);
+	if (!fluent) return false;
+
+	// A fluent-headed term with constant subterms denotes a fixed state variable; otherwise it needs to be interpreted
+	std::vector<ObjectIdx> values;
+	for (const Term* subterm:fluent->getSubterms()) {
+		auto constant = dynamic_cast<const Constant*>(subterm);
+		if (!constant) return false;
+		values.push_back(constant->getValue());
+	}
+	try {
+		variable = ProblemInfo::getInstance().resolveStateVariable(fluent->getSymbolId(), values);
+	} catch (const std::out_of_range& ex) { // The term does not denote any actual state variable
+		return false;
+	}
+	return true;
+}
+
+bool CompiledExpression::emit_binary(OpCode op, const Term* lhs, const Term* rhs, unsigned depth) {
+	if (!compile_term(lhs, depth) || !compile_term(rhs, depth + 1)) return false;
+	_code.push_back(Instruction{op, 0, 0});
+	return true;
+}
+
+
+std::unique_ptr<CompiledEffect> CompiledEffect::compile(const ActionEffect* effect) {
+	VariableIdx variable;
+	if (!CompiledExpression::resolve_state_variable(effect->lhs(), variable)) return nullptr;
+
+	auto rhs = CompiledExpression::compile(effect->rhs());
+	if (!rhs) return nullptr;
+
+	std::unique_ptr<CompiledExpression> condition;
+	if (effect->condition() && !effect->condition()->is_tautology()) {
+		condition = CompiledExpression::compile(effect->condition());
+		if (!condition) return nullptr;
+	}
+
+	return std::unique_ptr<CompiledEffect>(new CompiledEffect(variable, std::move(rhs), std::move(condition)));
+}
+
+} } } // namespaces
@@ -0,0 +1,134 @@
+
+#pragma once
+
+#include <memory>
+
+#include <fs_types.hxx>
+#include <state.hxx>
+#include <atom.hxx>
+
+namespace fs0 { namespace language { namespace fstrips {
+
+class Term;
+class Formula;
+class AtomicFormula;
+class ActionEffect;
+
+/**
+ * A compiled expression is a flat representation of a ground term or formula as a sequence of instructions of a
+ * small stack machine that operates over the values of state variables. Evaluating it requires neither heap allocations
+ * nor virtual calls, as opposed to the interpretation of the original term or formula tree.
+ * Only (conjunctions of) relational atoms over constants, state variables and arithmetic terms can be compiled;
+ * anything else (existential quantification, external constraints, nested fluents, ...) needs to be interpreted.
+ */
+class CompiledExpression {
+public:
+	enum class OpCode : uint8_t {
+		CONSTANT, // Push the constant 'a'
+		VARIABLE, // Push the value of state variable 'a'
+		ADD, SUB, MUL, // Pop two values and push the result of the arithmetic operation
+		EQ, NEQ, LT, LEQ, GT, GEQ, // Pop two values and fail if the relation does not hold between them
+		VARIABLE_EQ, VARIABLE_NEQ, // Fail unless the value of state variable 'a' is (resp. is not) 'b'
+		FAIL // Fail unconditionally
+	};
+
+	struct Instruction {
+		OpCode op;
+		int32_t a;
+		int32_t b;
+	};
+
+	//! The maximum depth of the stack of values during the evaluation of an expression
+	static const unsigned MAX_STACK_DEPTH = 16;
+
+	//! Compile the given ground formula / term, returning nullptr if the formula / term cannot be compiled
+	static std::unique_ptr<CompiledExpression> compile(const Formula* formula);
+	static std::unique_ptr<CompiledExpression> compile(const Term* term);
+
+	//! Returns true iff the compiled formula holds in the given state.
+	//! Any object providing the values of state variables through a 'getValue' method can be used as a state.
+	template <typename StateT>
+	bool holds(const StateT& state) const {
+		ObjectIdx result;
+		return run(state, result);
+	}
+
+	//! Returns the value of the compiled term in the given state
+	template <typename StateT>
+	ObjectIdx value(const StateT& state) const {
+		ObjectIdx result = 0;
+		run(state, result);
+		return result;
+	}
+
+	unsigned size() const { return _code.size(); }
+
+	//! If the given term denotes a fixed state variable, i.e. it is a state variable or a fluent-headed term with
+	//! constant subterms, stores it into 'variable' and returns true; otherwise returns false.
+	static bool resolve_state_variable(const Term* term, VariableIdx& variable);
+
+protected:
+	std::vector<Instruction> _code;
+
+	//! Runs the program on the given state, leaving in 'result' the value on top of the stack, if any.
+	//! Returns false iff some of the relations checked by the program does not hold.
+	template <typename StateT>
+	bool run(const StateT& state, ObjectIdx& result) const {
+		ObjectIdx stack[MAX_STACK_DEPTH];
+		unsigned top = 0;
+		for (const Instruction& instruction:_code) {
+			switch (instruction.op) {
+				case OpCode::CONSTANT: stack[top++] = instruction.a; break;
+				case OpCode::VARIABLE: stack[top++] = state.getValue(instruction.a); break;
+				case OpCode::ADD: --top; stack[top - 1] += stack[top]; break;
+				case OpCode::SUB: --top; stack[top - 1] -= stack[top]; break;
+				case OpCode::MUL: --top; stack[top - 1] *= stack[top]; break;
+				case OpCode::EQ:  top -= 2; if (!(stack[top] == stack[top + 1])) return false; break;
+				case OpCode::NEQ: top -= 2; if (!(stack[top] != stack[top + 1])) return false; break;
+				case OpCode::LT:  top -= 2; if (!(stack[top] <  stack[top + 1])) return false; break;
+				case OpCode::LEQ: top -= 2; if (!(stack[top] <= stack[top + 1])) return false; break;
+				case OpCode::GT:  top -= 2; if (!(stack[top] >  stack[top + 1])) return false; break;
+				case OpCode::GEQ: top -= 2; if (!(stack[top] >= stack[top + 1])) return false; break;
+				case OpCode::VARIABLE_EQ:  if (state.getValue(instruction.a) != instruction.b) return false; break;
+				case OpCode::VARIABLE_NEQ: if (state.getValue(instruction.a) == instruction.b) return false; break;
+				case OpCode::FAIL: return false;
+			}
+		}
+		if (top > 0) result = stack[top - 1];
+		return true;
+	}
+
+	//! Helpers to append to '_code' the instructions corresponding to the given element, returning false if it cannot be compiled.
+	//! 'depth' is the depth of the stack before the element is evaluated.
+	bool compile_atom(const AtomicFormula* atom);
+	bool compile_term(const Term* term, unsigned depth);
+	bool emit_binary(OpCode op, const Term* lhs, const Term* rhs, unsigned depth);
+};
+
+
+//! A compiled version of a ground action effect, where the LHS resolves to a fixed state variable
+class CompiledEffect {
+public:
+	//! Compile the given ground effect, returning nullptr if it cannot be compiled
+	static std::unique_ptr<CompiledEffect> compile(const ActionEffect* effect);
+
+	//! Whether the effect is applicable in the given state. Non-conditional effects are always applicable.
+	bool applicable(const State& state) const { return !_condition || _condition->holds(state); }
+
+	//! Applies the effect to the given state and returns the resulting atom
+	Atom apply(const State& state) const { return Atom(_variable, _rhs->value(state)); }
+
+protected:
+	CompiledEffect(VariableIdx variable, std::unique_ptr<CompiledExpression>&& rhs, std::unique_ptr<CompiledExpression>&& condition)
+		: _variable(variable), _rhs(std::move(rhs)), _condition(std::move(condition)) {}
+
+	//! The state variable affected by the effect
+	VariableIdx _variable;
+
+	std::unique_ptr<CompiledExpression> _rhs;
+
+	//! The effect condition, or nullptr if the effect is not conditional
+	std::unique_ptr<CompiledExpression> _condition;
+};
+
+} } } // namespaces
@@ -34,6 +34,10 @@ State LiftedStateModel::next(const State& state, const GroundAction& action) con
 	return State(state, manager.computeEffects(state, action)); // Copy everything into the new state and apply the changeset
 }
 
+State LiftedStateModel::next(const State& state, gecode::LiftedActionIterator::Iterator& it) const {
+	return it.take_successor();
+}
+
 
 void LiftedStateModel::print(std::ostream& os) const {
 	os << task;
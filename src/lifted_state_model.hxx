@@ -3,9 +3,10 @@
 
 #include <aptk2/search/interfaces/det_state_model.hxx>
 #include <actions/action_id.hxx>
+#include <actions/lifted_action_iterator.hxx>
 
 
-namespace fs0 { namespace gecode { class LiftedActionIterator; class LiftedActionCSP; }}
+namespace fs0 { namespace gecode { class LiftedActionCSP; }}
 
 namespace fs0 {
 
@@ -37,6 +38,10 @@ public:
 	//! Returns the state resulting from applying the given action action on the given state
 	State next(const State& state, const LiftedActionID& action) const;
 	State next(const State& state, const GroundAction& a) const;
+	
+	//! Returns the state resulting from applying the current action of the given iterator over the actions applicable
+	//! in the given state, which the iterator has already computed when checking the applicability of the action.
+	State next(const State& state, gecode::LiftedActionIterator::Iterator& it) const;
 
 	void print(std::ostream &os) const;
 	
@@ -6,6 +6,7 @@
 #include <utils/printers/language.hxx>
 #include <utils/printers/actions.hxx>
 #include <applicability/formula_interpreter.hxx>
+#include <applicability/state_constraint_index.hxx>
 
 namespace fs0 {
 
@@ -20,6 +21,7 @@ Problem::Problem(State* init, const std::vector<const ActionData*>& action_data,
 	_state_constraint_formula(state_constraints),
 	_goal_formula(goal),
 	_goal_sat_manager(FormulaInterpreter::create(_goal_formula, get_tuple_index())),
+	_state_constraint_index(new StateConstraintIndex(_state_constraint_formula)),
 	_is_predicative(check_is_predicative())
 {
 }
@@ -12,6 +12,7 @@ namespace fs0 {
 
 class State;
 class FormulaInterpreter;
+class StateConstraintIndex;
 class ActionData;
 class ActionBase;
 class PartiallyGroundedAction;
@@ -50,6 +51,9 @@ public:
 	
 	const FormulaInterpreter& getGoalSatManager() const { return *_goal_sat_manager; }
 	
+	//! An index to check incrementally that the state constraints hold in the successors of a state
+	const StateConstraintIndex& getStateConstraintIndex() const { return *_state_constraint_index; }
+	
 	void setLPHandler(asp::LPHandler* handler) { _lp_handler = handler; }
 	const asp::LPHandler* getLPHandler() const { return _lp_handler; }
 
@@ -95,6 +99,8 @@ protected:
 
 	std::unique_ptr<FormulaInterpreter> _goal_sat_manager;
 	
+	std::unique_ptr<StateConstraintIndex> _state_constraint_index;
+	
 	asp::LPHandler* _lp_handler = nullptr;
 	
 	//! Whether all the symbols of the problem are predicates
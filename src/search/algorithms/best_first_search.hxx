@@ -0,0 +1,95 @@
+#pragma once
+
+#include <search/algorithms/search_space.hxx>
+#include <search/algorithms/open_lists.hxx>
+#include <aptk2/search/interfaces/search_algorithm.hxx>
+#include <aptk2/tools/logging.hxx>
+
+namespace fs0 { namespace drivers {
+
+//! A Best-First Search over a SearchSpace with registered states and index-linked nodes, where nodes are prioritized
+//! by the given open list (by default, according to their operator>), and evaluated with the given heuristic.
+//! With delayed evaluation, nodes inherit the heuristic estimate of their parent when generated, and are only actually
+//! evaluated when they are selected for expansion. Nodes other than the root are evaluated along with the state of their
+//! parent, which some heuristics can use to evaluate them incrementally.
+//! Nodes are goal-checked upon expansion; any state that has already been registered in the search space, whether expanded
+//! or not, is not considered again.
+template <typename NodeT, typename HeuristicT, typename StateModelT, typename OpenListT = HeapOpenList<NodeT>>
+class FS0BestFirstSearch : public aptk::SearchAlgorithm<StateModelT> {
+public:
+	typedef aptk::SearchAlgorithm<StateModelT> Base;
+	typedef typename StateModelT::StateType StateT;
+	typedef typename Base::Plan PlanT;
+	
+	FS0BestFirstSearch(const StateModelT& model, HeuristicT&& heuristic, bool delayed)
+		: Base(model), _heuristic(std::move(heuristic)), _delayed(delayed), _space(), _open(&_space)
+	{}
+	
+	virtual ~FS0BestFirstSearch() {}
+	
+	FS0BestFirstSearch(const FS0BestFirstSearch&) = delete;
+	FS0BestFirstSearch& operator=(const FS0BestFirstSearch&) = delete;
+	
+	virtual bool search(const StateT& s, PlanT& solution) {
+		NodeID root = _space.create_root(s);
+		_space.node(root).evaluate_with(_heuristic, s);
+		if (!_space.node(root).dead_end()) _open.push(root);
+		
+		bool solved = false;
+		while (!_open.empty()) {
+			NodeID current = _open.pop();
+			
+			StateT state = _space.state(current);
+			
+			if (_delayed && _space.node(current).has_parent()) {
+				_space.node(current).evaluate_with(_heuristic, state, _space.state(_space.node(current).parent));
+				if (_space.node(current).dead_end()) continue;
+			}
+			
+			if (this->model.goal(state)) {
+				_space.extract_plan(current, solution);
+				solved = true;
+				break;
+			}
+			
+			++this->expanded;
+			auto applicable = this->model.applicable_actions(state);
+			for (auto it = applicable.begin(), end = applicable.end(); it != end; ++it) {
+				const auto& action = *it;
+				StateT successor = this->model.next(state, it); // The successor has already been computed by the iterator
+				auto registered = _space.register_state(successor);
+				if (!registered.second) continue; // The state has already been seen
+				
+				NodeID child = _space.create(registered.first, action, current);
+				++this->generated;
+				
+				NodeT& node = _space.node(child);
+				if (_delayed) node.inherit_heuristic_estimate(_space.node(current));
+				else node.evaluate_with(_heuristic, successor, state);
+				
+				if (!node.dead_end()) _open.push(child);
+			}
+		}
+		
+		_space.report_statistics();
+		
+		// The search is over: release all nodes at once, after making sure no node ID is left in the open list
+		_open.clear();
+		_space.release_nodes();
+		return solved;
+	}
+	
+protected:
+	HeuristicT _heuristic;
+	
+	//! Whether to use delayed evaluation or not
+	bool _delayed;
+	
+	//! All the nodes generated during the search, plus their states
+	SearchSpace<NodeT> _space;
+	
+	//! The open list of node IDs
+	OpenListT _open;
+};
+
+} } // namespaces
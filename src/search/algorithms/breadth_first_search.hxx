@@ -0,0 +1,131 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+
+#include <search/algorithms/search_space.hxx>
+#include <search/algorithms/successor_cache.hxx>
+#include <aptk2/search/interfaces/search_algorithm.hxx>
+#include <aptk2/tools/logging.hxx>
+
+namespace fs0 { namespace drivers {
+
+//! An open list acceptor that accepts all nodes
+template <typename NodeT>
+class NullAcceptor {
+public:
+	bool accept(const NodeT& node, const State& state) { return true; }
+	bool accept(const NodeT& node, const State& state, const State& parent) { return true; }
+};
+
+//! A Breadth-First Search over a SearchSpace with registered states and index-linked nodes.
+//! Nodes are goal-checked (and possibly pruned) upon expansion; the (optional) acceptor can prune any node before it gets into the open list,
+//! and receives the state of the parent of every node but the root, which it might use to evaluate it incrementally.
+//! Any state that has already been registered in the search space, whether expanded or not, is not considered again.
+//! If a successor cache is given, the expansions of states are recorded in it, or replayed from it if already recorded.
+template <typename NodeT, typename StateModelT, typename AcceptorT = NullAcceptor<NodeT>>
+class FS0BreadthFirstSearch : public aptk::SearchAlgorithm<StateModelT> {
+public:
+	typedef aptk::SearchAlgorithm<StateModelT> Base;
+	typedef typename StateModelT::StateType StateT;
+	typedef typename Base::Plan PlanT;
+	typedef typename StateModelT::ActionType::IdType ActionIdT;
+	typedef SuccessorCache<ActionIdT> CacheT;
+	
+	FS0BreadthFirstSearch(const StateModelT& model)
+		: Base(model), _acceptor(std::make_shared<AcceptorT>()), _cache(nullptr)
+	{}
+	
+	FS0BreadthFirstSearch(const StateModelT& model, const std::shared_ptr<AcceptorT>& acceptor, const std::shared_ptr<CacheT>& cache = nullptr)
+		: Base(model), _acceptor(acceptor), _cache(cache)
+	{}
+	
+	virtual ~FS0BreadthFirstSearch() {}
+	
+	FS0BreadthFirstSearch(const FS0BreadthFirstSearch&) = delete;
+	FS0BreadthFirstSearch& operator=(const FS0BreadthFirstSearch&) = delete;
+	
+	virtual bool search(const StateT& s, PlanT& solution) {
+		NodeID root = _space.create_root(s);
+		if (_acceptor->accept(_space.node(root), s)) _open.push_back(root);
+		
+		bool solved = false;
+		while (!_open.empty()) {
+			NodeID current = _open.front();
+			_open.pop_front();
+			
+			StateT state = _space.state(current);
+			if (is_goal(state)) {
+				_space.extract_plan(current, solution);
+				solved = true;
+				break;
+			}
+			if (prune(state)) continue;
+			
+			++this->expanded;
+			expand(current, state);
+		}
+		
+		_space.report_statistics();
+		if (_cache) _cache->report_statistics();
+		
+		// The search is over: release all nodes at once, after making sure no node ID is left in the open list
+		_open.clear();
+		_space.release_nodes();
+		return solved;
+	}
+	
+protected:
+	//! Generates all the successors of the given node, replaying its expansion from the cache if possible
+	void expand(NodeID current, const StateT& state) {
+		if (_cache) {
+			if (const typename CacheT::Successors* cached = _cache->find(state)) {
+				for (const auto& successor:*cached) generate(current, state, successor.first, _cache->state(successor.second));
+				return;
+			}
+		}
+		
+		bool record = _cache && !_cache->full();
+		typename CacheT::Successors successors;
+		
+		auto applicable = this->model.applicable_actions(state);
+		for (auto it = applicable.begin(), end = applicable.end(); it != end; ++it) {
+			const auto& action = *it;
+			StateT successor = this->model.next(state, it); // The successor has already been computed by the iterator
+			if (record) successors.push_back(std::make_pair(action, _cache->add(successor)));
+			generate(current, state, action, successor);
+		}
+		
+		if (record) _cache->record(state, std::move(successors));
+	}
+	
+	//! Generates the child of the given node that corresponds to the given successor state
+	void generate(NodeID current, const StateT& state, const ActionIdT& action, const StateT& successor) {
+		auto registered = _space.register_state(successor);
+		if (!registered.second) return; // The state has already been seen
+		
+		NodeID child = _space.create(registered.first, action, current);
+		++this->generated;
+		if (_acceptor->accept(_space.node(child), successor, state)) _open.push_back(child);
+	}
+	
+	//! Whether the given state is a goal of the search. Subclasses can redefine it e.g. to search for subgoals.
+	virtual bool is_goal(const StateT& state) { return this->model.goal(state); }
+	
+	//! Whether the given (non-goal) state can be discarded without being expanded
+	virtual bool prune(const StateT& state) { return false; }
+	
+	//! All the nodes generated during the search, plus their states
+	SearchSpace<NodeT> _space;
+	
+	//! The open list is a FIFO queue of node IDs
+	std::deque<NodeID> _open;
+	
+	//! The object deciding which nodes get into the open list
+	std::shared_ptr<AcceptorT> _acceptor;
+	
+	//! The cache of state expansions, if any, possibly shared with other searches
+	std::shared_ptr<CacheT> _cache;
+};
+
+} } // namespaces
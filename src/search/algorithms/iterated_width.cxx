@@ -5,8 +5,11 @@
 
 namespace fs0 { namespace drivers {
 
-FS0IWAlgorithm::FS0IWAlgorithm(const GroundStateModel& model, unsigned initial_max_width, unsigned final_max_width, const NoveltyFeaturesConfiguration& feature_configuration)
-	: FS0SearchAlgorithm(model), _current_max_width(initial_max_width), _final_max_width(final_max_width), _feature_configuration(feature_configuration)
+FS0IWAlgorithm::FS0IWAlgorithm(const GroundStateModel& model, unsigned initial_max_width, unsigned final_max_width, const NoveltyFeaturesConfiguration& feature_configuration,
+                               std::size_t cache_memory)
+	: FS0SearchAlgorithm(model), _algorithm(nullptr), _current_max_width(initial_max_width), _final_max_width(final_max_width), _feature_configuration(feature_configuration),
+	  _features(std::make_shared<const NoveltyFeatureSet>(model.getTask(), feature_configuration)),
+	  _cache(cache_memory > 0 && initial_max_width < final_max_width ? std::make_shared<BaseAlgorithm::CacheT>(cache_memory) : nullptr)
 {
 	setup_base_algorithm(_current_max_width);
 }
@@ -28,8 +31,8 @@ bool FS0IWAlgorithm::search(const State& state, typename FS0SearchAlgorithm::Pla
 
 void FS0IWAlgorithm::setup_base_algorithm(unsigned max_width) {
 	if (_algorithm) delete _algorithm;
-	std::shared_ptr<SearchNoveltyEvaluator> evaluator = std::make_shared<SearchNoveltyEvaluator>(this->model, _current_max_width, _feature_configuration);
-	_algorithm = new BaseAlgorithm(model, OpenList(evaluator));
+	std::shared_ptr<SearchNoveltyEvaluator> evaluator = std::make_shared<SearchNoveltyEvaluator>(_features, _current_max_width, _feature_configuration);
+	_algorithm = new BaseAlgorithm(model, evaluator, _cache);
 }
 
 } } // namespaces
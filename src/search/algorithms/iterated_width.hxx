@@ -9,11 +9,7 @@
 #include <ground_state_model.hxx>
 #include <heuristics/novelty/novelty_features_configuration.hxx>
 
-#include <aptk2/search/algorithms/generic_search.hxx>
-#include <aptk2/search/algorithms/breadth_first_search.hxx>
-#include <aptk2/search/components/unsorted_open_list_impl.hxx>
-#include <aptk2/search/components/closed_list_impl.hxx>
-#include <aptk2/search/components/stl_unsorted_fifo_open_list.hxx>
+#include <search/algorithms/breadth_first_search.hxx>
 
 namespace fs0 { namespace drivers {
 
@@ -21,18 +17,17 @@ namespace fs0 { namespace drivers {
 class FS0IWAlgorithm : public FS0SearchAlgorithm {
 public:
 	//! IW uses a simple blind-search node
-	typedef BlindSearchNode<State> SearchNode;
+	typedef BlindSearchNode<GroundAction> SearchNode;
 	
 	//! IW uses a single novelty component as the open list evaluator
 	typedef SingleNoveltyComponent<SearchNode> SearchNoveltyEvaluator;
 	
-	//! IW uses an unsorted queue with a NoveltyEvaluator acceptor
-	typedef aptk::StlUnsortedFIFO<SearchNode, SearchNoveltyEvaluator> OpenList;
+	//! The base algorithm for IW is a simple Breadth-First Search with a NoveltyEvaluator acceptor
+	typedef FS0BreadthFirstSearch<SearchNode, GroundStateModel, SearchNoveltyEvaluator> BaseAlgorithm;
 	
-	//! The base algorithm for IW is a simple Breadth-First Search
-	typedef aptk::StlBreadthFirstSearch<SearchNode, GroundStateModel, OpenList> BaseAlgorithm;
-	
-	FS0IWAlgorithm(const GroundStateModel& model, unsigned initial_max_width, unsigned final_max_width, const NoveltyFeaturesConfiguration& feature_configuration);
+	//! The expansions of each IW(k) search are cached within the given memory budget (in bytes), and replayed by IW(k+1)
+	FS0IWAlgorithm(const GroundStateModel& model, unsigned initial_max_width, unsigned final_max_width, const NoveltyFeaturesConfiguration& feature_configuration,
+	               std::size_t cache_memory = 0);
 	
 	virtual ~FS0IWAlgorithm();
 	
@@ -53,6 +48,12 @@ protected:
 
 	//! Novelty evaluator configuration
 	const NoveltyFeaturesConfiguration _feature_configuration;
+	
+	//! The novelty features, shared among the evaluators of all IW(k) searches
+	std::shared_ptr<const NoveltyFeatureSet> _features;
+	
+	//! The cache of state expansions shared among all IW(k) searches, if any
+	std::shared_ptr<BaseAlgorithm::CacheT> _cache;
 };
 
 } } // namespaces
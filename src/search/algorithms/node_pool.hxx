@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace fs0 { namespace drivers {
+
+//! The compact identifier of a search node within a NodePool
+typedef uint32_t NodeID;
+const NodeID INVALID_NODE_ID = std::numeric_limits<uint32_t>::max();
+
+//! A NodePool is an arena where all the search nodes of a search are allocated, in fixed-size chunks of raw memory.
+//! Nodes are constructed in place, are never moved nor individually freed, and are identified by their (32-bit)
+//! position in the pool, which makes NodeIDs suitable for parent links and node references remain valid as the pool grows.
+//! All nodes are destroyed at once when the pool is cleared or destroyed, i.e. at the end of the search.
+template <typename NodeT>
+class NodePool {
+protected:
+	//! Chunks hold 2^CHUNK_BITS nodes each
+	static const unsigned CHUNK_BITS = 14;
+	static const NodeID CHUNK_SIZE = static_cast<NodeID>(1) << CHUNK_BITS;
+	static const NodeID OFFSET_MASK = CHUNK_SIZE - 1;
+
+	typedef typename std::aligned_storage<sizeof(NodeT), alignof(NodeT)>::type Slot;
+
+	//! The chunks of memory, of which all but the last one are full
+	std::vector<std::unique_ptr<Slot[]>> _chunks;
+
+	//! The number of nodes in the pool
+	NodeID _size;
+
+public:
+	NodePool() : _chunks(), _size(0) {}
+	~NodePool() { clear(); }
+
+	NodePool(const NodePool&) = delete;
+	NodePool& operator=(const NodePool&) = delete;
+
+	//! Constructs in place a new node with the given arguments, and returns its ID
+	template <typename... Args>
+	NodeID emplace(Args&&... args) {
+		if (_size == INVALID_NODE_ID) throw std::runtime_error("NodePool: Maximum number of nodes exceeded");
+		NodeID id = _size;
+		if ((id & OFFSET_MASK) == 0 && (id >> CHUNK_BITS) == _chunks.size()) {
+			_chunks.emplace_back(new Slot[CHUNK_SIZE]);
+		}
+		new (address(id)) NodeT(std::forward<Args>(args)...);
+		++_size; // Only account for the node once it has been successfully constructed
+		return id;
+	}
+
+	NodeT& operator[](NodeID id) { return *reinterpret_cast<NodeT*>(address(id)); }
+	const NodeT& operator[](NodeID id) const { return *reinterpret_cast<const NodeT*>(address(id)); }
+
+	NodeID size() const { return _size; }
+
+	//! The (approximate) number of bytes allocated by the pool
+	std::size_t memory() const { return _chunks.size() * CHUNK_SIZE * sizeof(Slot); }
+
+	//! Destroys all nodes and releases all memory held by the pool
+	void clear() {
+		for (NodeID id = 0; id < _size; ++id) (*this)[id].~NodeT();
+		_size = 0;
+		_chunks.clear();
+	}
+
+protected:
+	Slot* address(NodeID id) const { return &_chunks[id >> CHUNK_BITS][id & OFFSET_MASK]; }
+};
+
+} } // namespaces
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cassert>
+#include <queue>
+#include <vector>
+#include <limits>
+
+#include <search/algorithms/search_space.hxx>
+
+namespace fs0 { namespace drivers {
+
+//! An open list of node IDs implemented as a binary heap where the node with the lowest value, according to the
+//! operator> of the nodes, is on top. Ties are broken in favor of the node that was created first, i.e. the one with the
+//! lowest ID, so that the expansion order is fully determined.
+template <typename NodeT>
+class HeapOpenList {
+public:
+	HeapOpenList(const SearchSpace<NodeT>* space) : _space(space), _heap(NodeComparator{space}) {}
+	
+	void push(NodeID id) { _heap.push(id); }
+	
+	NodeID pop() {
+		NodeID id = _heap.top();
+		_heap.pop();
+		return id;
+	}
+	
+	bool empty() const { return _heap.empty(); }
+	
+	void clear() { decltype(_heap)(NodeComparator{_space}).swap(_heap); }
+	
+protected:
+	//! Compares node IDs according to the operator> of the corresponding nodes, and then to the IDs themselves
+	struct NodeComparator {
+		const SearchSpace<NodeT>* space;
+		bool operator()(NodeID lhs, NodeID rhs) const {
+			const NodeT& l = space->node(lhs);
+			const NodeT& r = space->node(rhs);
+			if (l > r) return true;
+			if (r > l) return false;
+			return lhs > rhs;
+		}
+	};
+	
+	const SearchSpace<NodeT>* _space;
+	
+	std::priority_queue<NodeID, std::vector<NodeID>, NodeComparator> _heap;
+};
+
+
+//! An open list of node IDs for nodes prioritized lexicographically by (novelty, #unsatisfied goals, g), all of which
+//! are small integers, implemented as a three-level bucket queue with FIFO buckets. Pushing a node takes constant time,
+//! and popping it amortized constant time, as the position of the lowest non-empty bucket is tracked at every level.
+//! Among nodes with the same key, the first to be pushed is the first to be popped.
+template <typename NodeT>
+class NoveltyBucketOpenList {
+public:
+	NoveltyBucketOpenList(const SearchSpace<NodeT>* space) : _space(space), _levels(), _size(0), _min_novelty(std::numeric_limits<unsigned>::max()) {}
+	
+	void push(NodeID id) {
+		const NodeT& node = _space->node(id);
+		if (node.novelty >= _levels.size()) _levels.resize(node.novelty + 1);
+		NoveltyLevel& level = _levels[node.novelty];
+		if (node.num_unsat >= level.goal_levels.size()) level.goal_levels.resize(node.num_unsat + 1);
+		GoalLevel& goal_level = level.goal_levels[node.num_unsat];
+		if (node.g >= goal_level.buckets.size()) goal_level.buckets.resize(node.g + 1);
+		
+		goal_level.buckets[node.g].push(id);
+		++goal_level.size;
+		++level.size;
+		++_size;
+		
+		if (node.g < goal_level.min_g) goal_level.min_g = node.g;
+		if (node.num_unsat < level.min_unsat) level.min_unsat = node.num_unsat;
+		if (node.novelty < _min_novelty) _min_novelty = node.novelty;
+	}
+	
+	NodeID pop() {
+		assert(!empty());
+		while (_levels[_min_novelty].size == 0) ++_min_novelty;
+		NoveltyLevel& level = _levels[_min_novelty];
+		while (level.goal_levels[level.min_unsat].size == 0) ++level.min_unsat;
+		GoalLevel& goal_level = level.goal_levels[level.min_unsat];
+		while (goal_level.buckets[goal_level.min_g].empty()) ++goal_level.min_g;
+		
+		NodeID id = goal_level.buckets[goal_level.min_g].pop();
+		--goal_level.size;
+		--level.size;
+		--_size;
+		
+		// Reset the cursors of the levels that become empty, so that they are correctly set on the next push
+		if (goal_level.size == 0) goal_level.min_g = std::numeric_limits<unsigned>::max();
+		if (level.size == 0) level.min_unsat = std::numeric_limits<unsigned>::max();
+		if (_size == 0) _min_novelty = std::numeric_limits<unsigned>::max();
+		return id;
+	}
+	
+	bool empty() const { return _size == 0; }
+	
+	void clear() {
+		_levels.clear();
+		_size = 0;
+		_min_novelty = std::numeric_limits<unsigned>::max();
+	}
+	
+protected:
+	//! A FIFO queue of node IDs, where the IDs already popped are only released once the queue becomes empty
+	struct Bucket {
+		std::vector<NodeID> ids;
+		std::size_t head = 0;
+		
+		bool empty() const { return head == ids.size(); }
+		void push(NodeID id) { ids.push_back(id); }
+		NodeID pop() {
+			NodeID id = ids[head++];
+			if (head == ids.size()) { ids.clear(); head = 0; }
+			return id;
+		}
+	};
+	
+	//! The nodes with some novelty and number of unsatisfied goals, bucketed by g
+	struct GoalLevel {
+		std::vector<Bucket> buckets;
+		std::size_t size = 0;
+		unsigned min_g = std::numeric_limits<unsigned>::max();
+	};
+	
+	//! The nodes with some novelty, bucketed by number of unsatisfied goals
+	struct NoveltyLevel {
+		std::vector<GoalLevel> goal_levels;
+		std::size_t size = 0;
+		unsigned min_unsat = std::numeric_limits<unsigned>::max();
+	};
+	
+	const SearchSpace<NodeT>* _space;
+	
+	std::vector<NoveltyLevel> _levels;
+	
+	std::size_t _size;
+	
+	//! The lowest novelty of any node in the list, if not empty
+	unsigned _min_novelty;
+};
+
+} } // namespaces
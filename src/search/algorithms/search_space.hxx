@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+
+#include <fs_types.hxx>
+#include <search/state_registry.hxx>
+#include <search/algorithms/node_pool.hxx>
+#include <aptk2/tools/logging.hxx>
+
+namespace fs0 { namespace drivers {
+
+//! A SearchSpace holds all the nodes generated during a search, plus a StateRegistry where their states are stored.
+//! Nodes refer to their state through a StateID and to their parent through a NodeID, i.e. their index in the search space.
+//! Nodes are allocated in a NodePool, hence never move and are only released when the search space is cleared or destroyed.
+template <typename NodeT>
+class SearchSpace {
+protected:
+	//! The registry of all states seen during the search
+	StateRegistry _registry;
+
+	//! '_nodes[i]' is the node with ID 'i'
+	NodePool<NodeT> _nodes;
+
+public:
+	SearchSpace() = default;
+	~SearchSpace() = default;
+
+	SearchSpace(const SearchSpace&) = delete;
+	SearchSpace& operator=(const SearchSpace&) = delete;
+
+	//! Creates the root node of the search, corresponding to the given state
+	NodeID create_root(const State& state) {
+		auto registered = _registry.insert(state);
+		assert(registered.second);
+		return _nodes.emplace(registered.first);
+	}
+
+	//! Registers the given state, returning its ID plus whether the state had never been seen before during the search
+	std::pair<StateID, bool> register_state(const State& state) { return _registry.insert(state); }
+
+	//! Creates a new child node of the given parent node, corresponding to the state with the given ID, which has been
+	//! reached from the parent through the given action.
+	template <typename ActionIdT>
+	NodeID create(StateID state, const ActionIdT& action, NodeID parent) {
+		return _nodes.emplace(state, action, parent, _nodes[parent]);
+	}
+
+	NodeT& node(NodeID id) { return _nodes[id]; }
+	const NodeT& node(NodeID id) const { return _nodes[id]; }
+
+	//! Returns a copy of the state of the node with the given ID
+	State state(NodeID id) const { return _registry.lookup(_nodes[id].state); }
+
+	//! Reconstructs the sequence of actions that leads from the root node to the node with given ID
+	template <typename PlanT>
+	void extract_plan(NodeID id, PlanT& plan) const {
+		plan.clear();
+		for (NodeID current = id; _nodes[current].has_parent(); current = _nodes[current].parent) {
+			plan.push_back(_nodes[current].action);
+		}
+		std::reverse(plan.begin(), plan.end());
+	}
+
+	unsigned num_nodes() const { return _nodes.size(); }
+
+	const StateRegistry& registry() const { return _registry; }
+
+	//! Releases all the search nodes. The registered states are kept.
+	void release_nodes() { _nodes.clear(); }
+
+	void report_statistics() const {
+		LPT_INFO("main", "Search space: " << _nodes.size() << " nodes (" << sizeof(NodeT) << " bytes each, approx. " << _nodes.memory() / 1024 << " KB allocated), "
+		                 << _registry.size() << " registered states (approx. " << _registry.memory() / 1024 << " KB)");
+	}
+};
+
+} } // namespaces
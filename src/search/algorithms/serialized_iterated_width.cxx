@@ -0,0 +1,102 @@
+
+#include <search/algorithms/serialized_iterated_width.hxx>
+#include <heuristics/relaxed_plan/direct_crpg.hxx>
+#include <heuristics/heuristic_cache.hxx>
+#include <languages/fstrips/formulae.hxx>
+#include <actions/ground_action_iterator.hxx>
+#include <problem.hxx>
+
+
+namespace fs0 { namespace drivers {
+
+SubgoalSearch::SubgoalSearch(const GroundStateModel& model, const std::shared_ptr<SingleNoveltyComponent<BlindSearchNode<GroundAction>>>& evaluator,
+                             const std::vector<const fs::AtomicFormula*>& goal_atoms, const State& seed, DirectCRPG* reachability,
+                             HeuristicCache* reachability_cache, const std::shared_ptr<CacheT>& cache)
+	: BaseSearch(model, evaluator, cache), _goal_atoms(goal_atoms), _achieved(), _reachability(reachability), _reachability_cache(reachability_cache), _pruned(0)
+{
+	for (const fs::AtomicFormula* atom:_goal_atoms) _achieved.push_back(atom->interpret(seed));
+}
+
+bool SubgoalSearch::achieves_subgoal(const State& state) const {
+	bool novel = false;
+	for (unsigned i = 0; i < _goal_atoms.size(); ++i) {
+		bool satisfied = _goal_atoms[i]->interpret(state);
+		if (_achieved[i] && !satisfied) return false; // Goal atoms achieved before are protected
+		if (satisfied && !_achieved[i]) novel = true;
+	}
+	return novel;
+}
+
+bool SubgoalSearch::is_goal(const State& state) {
+	return achieves_subgoal(state) && (!_reachability || reachable(state));
+}
+
+bool SubgoalSearch::reachable(const State& state) {
+	long h = _reachability_cache ? _reachability_cache->evaluate(*_reachability, state) : _reachability->evaluate(state);
+	return h != -1;
+}
+
+bool SubgoalSearch::prune(const State& state) {
+	// Called only on non-goal states, hence a state achieving a subgoal here has failed the reachability test.
+	// Relaxed reachability is monotonic, so that no successor of the state can reach the goal either.
+	if (!_reachability || !achieves_subgoal(state)) return false;
+	++_pruned;
+	return true;
+}
+
+
+FS0SIWAlgorithm::FS0SIWAlgorithm(const GroundStateModel& model, unsigned max_width, const NoveltyFeaturesConfiguration& feature_configuration, std::unique_ptr<DirectCRPG>&& reachability,
+                                 std::size_t cache_memory, std::unique_ptr<HeuristicCache>&& reachability_cache)
+	: FS0SearchAlgorithm(model), _max_width(max_width), _feature_configuration(feature_configuration),
+	  _features(std::make_shared<const NoveltyFeatureSet>(model.getTask(), feature_configuration)), _goal_atoms(), _reachability(std::move(reachability)),
+	  _reachability_cache(std::move(reachability_cache)),
+	  _cache(cache_memory > 0 ? std::make_shared<SubgoalSearch::CacheT>(cache_memory) : nullptr)
+{
+	auto goal_conjunction = dynamic_cast<const fs::Conjunction*>(model.getTask().getGoalConditions());
+	if (!goal_conjunction) throw std::runtime_error("SIW available only for goal conjunctions");
+	_goal_atoms = goal_conjunction->getConjuncts();
+}
+
+FS0SIWAlgorithm::~FS0SIWAlgorithm() = default;
+
+bool FS0SIWAlgorithm::search(const State& state, typename FS0SearchAlgorithm::Plan& solution) {
+	if (_reachability && _reachability->evaluate(state) == -1) {
+		LPT_INFO("main", "SIW: The goal is unreachable from the initial state");
+		return false;
+	}
+	
+	State current(state);
+	unsigned num_subproblems = 0;
+	while (!model.goal(current)) {
+		if (!solve_subproblem(current, solution)) {
+			LPT_INFO("main", "SIW: Subproblem #" << num_subproblems << " could not be solved with width up to " << _max_width);
+			solution.clear();
+			return false;
+		}
+		++num_subproblems;
+	}
+	LPT_INFO("main", "SIW: Goal achieved after solving " << num_subproblems << " subproblems");
+	return true;
+}
+
+bool FS0SIWAlgorithm::solve_subproblem(State& state, typename FS0SearchAlgorithm::Plan& solution) {
+	for (unsigned width = 1; width <= _max_width; ++width) {
+		auto evaluator = std::make_shared<SearchNoveltyEvaluator>(_features, width, _feature_configuration);
+		SubgoalSearch search(model, evaluator, _goal_atoms, state, _reachability.get(), _reachability_cache.get(), _cache);
+		
+		typename FS0SearchAlgorithm::Plan subplan;
+		bool solved = search.search(state, subplan);
+		generated += search.generated;
+		expanded += search.expanded;
+		LPT_INFO("main", "SIW: IW(" << width << ") " << (solved ? "solved" : "failed on") << " the subproblem after expanding " << search.expanded
+		                 << " nodes (" << search.pruned() << " subgoal states pruned as relaxed dead ends)");
+		if (!solved) continue;
+		
+		for (const auto& action:subplan) state = model.next(state, action);
+		solution.insert(solution.end(), subplan.begin(), subplan.end());
+		return true;
+	}
+	return false;
+}
+
+} } // namespaces
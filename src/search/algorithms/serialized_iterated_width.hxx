@@ -0,0 +1,100 @@
+#pragma once
+
+#include <search/nodes/blind_search_node.hxx>
+#include <search/components/single_novelty.hxx>
+#include <search/drivers/registry.hxx>
+#include <ground_state_model.hxx>
+#include <heuristics/novelty/novelty_features_configuration.hxx>
+
+#include <search/algorithms/breadth_first_search.hxx>
+
+namespace fs0 { class DirectCRPG; class HeuristicCache; }
+
+namespace fs0 { namespace drivers {
+
+//! A Breadth-First Search with novelty pruning whose goal is to reach a state that satisfies some goal atom not satisfied
+//! in the state where the search starts, while keeping satisfied all goal atoms that were satisfied there.
+//! If a reachability test is given, subgoal states from which the problem goal is unreachable in the relaxed planning graph
+//! are pruned, along with all their successors. The outcome of the test is memoized in the given heuristic cache, if any.
+class SubgoalSearch : public FS0BreadthFirstSearch<BlindSearchNode<GroundAction>, GroundStateModel, SingleNoveltyComponent<BlindSearchNode<GroundAction>>> {
+public:
+	typedef FS0BreadthFirstSearch<BlindSearchNode<GroundAction>, GroundStateModel, SingleNoveltyComponent<BlindSearchNode<GroundAction>>> BaseSearch;
+	
+	SubgoalSearch(const GroundStateModel& model, const std::shared_ptr<SingleNoveltyComponent<BlindSearchNode<GroundAction>>>& evaluator,
+	              const std::vector<const fs::AtomicFormula*>& goal_atoms, const State& seed, DirectCRPG* reachability,
+	              HeuristicCache* reachability_cache, const std::shared_ptr<CacheT>& cache);
+	
+	//! The number of subgoal states pruned because of the reachability test
+	unsigned long pruned() const { return _pruned; }
+	
+protected:
+	bool is_goal(const State& state) override;
+	bool prune(const State& state) override;
+	
+	//! Whether the given state satisfies more goal atoms than the seed state, including all those satisfied there
+	bool achieves_subgoal(const State& state) const;
+	
+	//! Whether the problem goal is reachable from the given state in the relaxed planning graph
+	bool reachable(const State& state);
+	
+	const std::vector<const fs::AtomicFormula*>& _goal_atoms;
+	
+	//! '_achieved[i]' is true iff the i-th goal atom is satisfied in the seed state
+	std::vector<bool> _achieved;
+	
+	//! The relaxed-plan-graph heuristic used to test the reachability of the problem goal, if any
+	DirectCRPG* _reachability;
+	
+	HeuristicCache* _reachability_cache;
+	
+	unsigned long _pruned;
+};
+
+//! The SIW(k) algorithm, adapted to FStrips: the problem goal is serialized into a sequence of subproblems, each of which
+//! consists in achieving one more goal atom while keeping those already achieved, and is solved by IW(1), ..., IW(k).
+//! The state reached in each subproblem is committed as the initial state of the next one.
+class FS0SIWAlgorithm : public FS0SearchAlgorithm {
+public:
+	//! SIW uses a simple blind-search node
+	typedef BlindSearchNode<GroundAction> SearchNode;
+	
+	//! SIW uses a single novelty component as the open list evaluator of each subproblem
+	typedef SingleNoveltyComponent<SearchNode> SearchNoveltyEvaluator;
+	
+	//! If a relaxed-plan-graph heuristic is given, it is used to prune subgoal states from which the problem goal is unreachable
+	//! The expansions of states are cached within the given memory budget (in bytes) and replayed by all later IW searches.
+	//! Since the same subgoal states are tested again by the later IW searches, the outcome of the reachability test can be
+	//! memoized as well in the given heuristic cache.
+	FS0SIWAlgorithm(const GroundStateModel& model, unsigned max_width, const NoveltyFeaturesConfiguration& feature_configuration, std::unique_ptr<DirectCRPG>&& reachability,
+	                std::size_t cache_memory = 0, std::unique_ptr<HeuristicCache>&& reachability_cache = nullptr);
+	
+	virtual ~FS0SIWAlgorithm();
+	
+	virtual bool search(const State& state, typename FS0SearchAlgorithm::Plan& solution);
+	
+protected:
+	//! Solves the subproblem starting at the given state with increasing widths, appending the plan to the given solution
+	//! and updating the state to the state reached by it. Returns false if the subproblem cannot be solved with any width.
+	bool solve_subproblem(State& state, typename FS0SearchAlgorithm::Plan& solution);
+	
+	//! The maximum width of the IW searches
+	unsigned _max_width;
+	
+	//! Novelty evaluator configuration
+	const NoveltyFeaturesConfiguration _feature_configuration;
+	
+	//! The novelty features, shared among the evaluators of all IW searches
+	std::shared_ptr<const NoveltyFeatureSet> _features;
+	
+	//! The atoms of the goal conjunction
+	std::vector<const fs::AtomicFormula*> _goal_atoms;
+	
+	std::unique_ptr<DirectCRPG> _reachability;
+	
+	std::unique_ptr<HeuristicCache> _reachability_cache;
+	
+	//! The cache of state expansions shared among all IW searches, if any
+	std::shared_ptr<SubgoalSearch::CacheT> _cache;
+};
+
+} } // namespaces
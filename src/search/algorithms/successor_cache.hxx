@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+
+#include <search/state_registry.hxx>
+#include <aptk2/tools/logging.hxx>
+
+namespace fs0 { namespace drivers {
+
+//! A cache of the successors of expanded states, which outlives any single search, so that e.g. the successive
+//! iterations of IW with increasing width can replay the expansion of the states already expanded by previous iterations
+//! without recomputing the applicable actions nor their effects. States are stored (once) in a StateRegistry, and
+//! the cache stops recording new expansions once its (approximate) memory budget has been exhausted.
+template <typename ActionIdT>
+class SuccessorCache {
+public:
+	//! The successors of a state: the action leading to it, and the ID of the successor state in the cache registry
+	typedef std::vector<std::pair<ActionIdT, StateID>> Successors;
+	
+	SuccessorCache(std::size_t max_memory)
+		: _registry(), _successors(), _cached(), _max_memory(max_memory), _successors_memory(0), _hits(0)
+	{}
+	
+	SuccessorCache(const SuccessorCache&) = delete;
+	SuccessorCache& operator=(const SuccessorCache&) = delete;
+	
+	//! Returns the cached successors of the given state, or null if the expansion of the state has not been cached
+	const Successors* find(const State& state) {
+		StateID id = _registry.find(state);
+		if (id == INVALID_STATE_ID || id >= _cached.size() || !_cached[id]) return nullptr;
+		++_hits;
+		return &_successors[id];
+	}
+	
+	//! Whether the memory budget has been exhausted, in which case no more expansions should be recorded
+	bool full() const { return memory() >= _max_memory; }
+	
+	//! Registers a (successor) state in the cache, returning its ID
+	StateID add(const State& state) { return _registry.insert(state).first; }
+	
+	//! Records the given successors of the given state
+	void record(const State& state, Successors&& successors) {
+		StateID id = add(state);
+		if (id >= _cached.size()) {
+			_cached.resize(id + 1, false);
+			_successors.resize(id + 1);
+		}
+		_successors_memory += successors.capacity() * sizeof(typename Successors::value_type);
+		_successors[id] = std::move(successors);
+		_cached[id] = true;
+	}
+	
+	//! Returns the state with the given ID
+	State state(StateID id) const { return _registry.lookup(id); }
+	
+	//! An estimate of the memory taken by the cache, in bytes
+	std::size_t memory() const { return _registry.memory() + _successors.capacity() * sizeof(Successors) + _successors_memory; }
+	
+	//! The number of expansions that have been replayed from the cache
+	unsigned long hits() const { return _hits; }
+	
+	void report_statistics() const {
+		LPT_INFO("main", "Successor cache: " << _hits << " expansions replayed, " << _registry.size() << " states stored (approx. " << memory() / 1024 << " KB)");
+	}
+	
+protected:
+	StateRegistry _registry;
+	
+	//! '_successors[i]' contains the successors of the state with ID 'i', if '_cached[i]' is true
+	std::vector<Successors> _successors;
+	std::vector<bool> _cached;
+	
+	std::size_t _max_memory;
+	std::size_t _successors_memory;
+	
+	unsigned long _hits;
+};
+
+} } // namespaces
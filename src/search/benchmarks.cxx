@@ -0,0 +1,262 @@
+
+#include <chrono>
+#include <numeric>
+#include <fstream>
+#include <random>
+
+#include <search/benchmarks.hxx>
+#include <problem.hxx>
+#include <problem_info.hxx>
+#include <state.hxx>
+#include <ground_state_model.hxx>
+#include <actions/ground_action_iterator.hxx>
+#include <actions/grounding.hxx>
+#include <actions/batch_applicability.hxx>
+#include <heuristics/novelty/fs0_novelty_evaluator.hxx>
+#include <heuristics/novelty/novelty_features_configuration.hxx>
+#include <applicability/applicability_manager.hxx>
+#include <utils/config.hxx>
+#include <aptk2/tools/logging.hxx>
+
+
+namespace fs0 { namespace drivers {
+
+//! Returns the number of seconds elapsed since the given time point
+static double elapsed(const std::chrono::steady_clock::time_point& start) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Benchmarks::run(Problem& problem, const Config& config, const std::string& out_dir) {
+	problem.setGroundActions(ActionGrounder::fully_ground(problem.getActionData(), ProblemInfo::getInstance()));
+	GroundStateModel model(problem);
+
+	unsigned sample_size = config.getOption<int>("benchmark.sample_size", 1000);
+	std::vector<State> sample = sample_states(model, sample_size, 1);
+	LPT_INFO("main", "Benchmarking on a sample of " << sample.size() << " states");
+
+	std::ofstream json_out(out_dir + "/benchmarks.json");
+	json_out << "{" << std::endl;
+	json_out << "\t\"sample_size\": " << sample.size() << "," << std::endl;
+	json_out << "\t\"successor_generation\": ";
+	successor_generation(model, sample, json_out);
+	json_out << "," << std::endl << "\t\"applicable_actions\": ";
+	applicable_actions(model, sample, json_out);
+	json_out << "," << std::endl << "\t\"batch_applicability\": ";
+	batch_applicability(model, sample, json_out);
+	json_out << "," << std::endl << "\t\"novelty_evaluation\": ";
+	novelty_evaluation(model, sample, json_out);
+	json_out << std::endl << "}" << std::endl;
+}
+
+std::vector<State> Benchmarks::sample_states(const GroundStateModel& model, unsigned size, unsigned seed) {
+	const unsigned max_walk_length = 100;
+	std::mt19937 generator(seed);
+	std::vector<State> sample;
+	sample.reserve(size);
+
+	State current = model.init();
+	unsigned walk_length = 0;
+	while (sample.size() < size) {
+		sample.push_back(current);
+
+		std::vector<ActionIdx> applicable;
+		for (ActionIdx action:model.applicable_actions(current)) applicable.push_back(action);
+
+		if (applicable.empty() || ++walk_length == max_walk_length) { // Restart the walk
+			if (applicable.empty() && walk_length == 0) break; // Not even the initial state has any applicable action
+			current = model.init();
+			walk_length = 0;
+			continue;
+		}
+
+		ActionIdx chosen = applicable[std::uniform_int_distribution<unsigned>(0, applicable.size() - 1)(generator)];
+		current = model.next(current, chosen);
+	}
+	return sample;
+}
+
+void Benchmarks::successor_generation(const GroundStateModel& model, const std::vector<State>& sample, std::ostream& out) {
+	const unsigned rounds = 10;
+
+	// Precompute the applicable actions so that only successor generation is measured
+	std::vector<std::vector<ActionIdx>> applicable(sample.size());
+	for (unsigned i = 0; i < sample.size(); ++i) {
+		for (ActionIdx action:model.applicable_actions(sample[i])) applicable[i].push_back(action);
+	}
+
+	// The checksum prevents the compiler from optimizing the computations away
+	std::size_t checksum = 0;
+	unsigned long generated = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned round = 0; round < rounds; ++round) {
+		for (unsigned i = 0; i < sample.size(); ++i) {
+			for (ActionIdx action:applicable[i]) {
+				State successor = model.next(sample[i], action);
+				checksum ^= successor.hash();
+				++generated;
+			}
+		}
+	}
+	double incremental_time = elapsed(start);
+
+	// Computing the hash from scratch is timed alone, on successors that have already been generated
+	double full_time = 0;
+	std::vector<State> successors;
+	for (unsigned i = 0; i < sample.size(); ++i) {
+		successors.clear();
+		for (ActionIdx action:applicable[i]) successors.push_back(model.next(sample[i], action));
+		
+		start = std::chrono::steady_clock::now();
+		for (unsigned round = 0; round < rounds; ++round) {
+			for (const State& successor:successors) checksum += successor.computeHash();
+		}
+		full_time += elapsed(start);
+	}
+
+	double incremental_rate = (incremental_time > 0) ? generated / incremental_time : 0;
+	double full_rate = (full_time > 0) ? generated / full_time : 0;
+
+	std::cout << "Successor generation benchmark (checksum " << checksum << "):" << std::endl;
+	std::cout << "\tGenerated successors: " << generated << std::endl;
+	std::cout << "\tGeneration with incremental hashing: " << incremental_time << " s. (" << incremental_rate << " successors / s.)" << std::endl;
+	std::cout << "\tFull rehashing alone: " << full_time << " s. (" << full_rate << " successors / s.)" << std::endl;
+
+	out << "{" << std::endl;
+	out << "\t\t\"generated\": " << generated << "," << std::endl;
+	out << "\t\t\"generation_time\": " << incremental_time << "," << std::endl;
+	out << "\t\t\"full_hash_time\": " << full_time << "," << std::endl;
+	out << "\t\t\"generation_rate\": " << incremental_rate << "," << std::endl;
+	out << "\t\t\"full_hash_rate\": " << full_rate << std::endl;
+	out << "\t}";
+}
+
+void Benchmarks::applicable_actions(const GroundStateModel& model, const std::vector<State>& sample, std::ostream& out) {
+	const unsigned rounds = 10;
+	const auto& actions = model.getTask().getGroundActions();
+	ApplicabilityManager manager(model.getTask().getStateConstraints(), &model.getTask().getStateConstraintIndex());
+	
+	// The checksum prevents the compiler from optimizing the computations away
+	std::size_t checksum = 0;
+	unsigned long applicable = 0;
+	
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned round = 0; round < rounds; ++round) {
+		for (const State& state:sample) {
+			for (ActionIdx action:model.applicable_actions(state)) {
+				checksum += action;
+				++applicable;
+			}
+		}
+	}
+	double generator_time = elapsed(start);
+	
+	start = std::chrono::steady_clock::now();
+	for (unsigned round = 0; round < rounds; ++round) {
+		for (const State& state:sample) {
+			for (ActionIdx action = 0; action < actions.size(); ++action) {
+				if (manager.isApplicable(state, *actions[action])) checksum -= action;
+			}
+		}
+	}
+	double scan_time = elapsed(start);
+	
+	unsigned long evaluated = static_cast<unsigned long>(rounds) * sample.size();
+	double generator_rate = (generator_time > 0) ? evaluated / generator_time : 0;
+	double scan_rate = (scan_time > 0) ? evaluated / scan_time : 0;
+	
+	std::cout << "Applicable actions benchmark (checksum " << checksum << "):" << std::endl;
+	std::cout << "\tGround actions: " << actions.size() << ", applicable actions found: " << applicable << std::endl;
+	std::cout << "\tSuccessor generator: " << generator_time << " s. (" << generator_rate << " states / s.)" << std::endl;
+	std::cout << "\tLinear scan: " << scan_time << " s. (" << scan_rate << " states / s.)" << std::endl;
+	
+	out << "{" << std::endl;
+	out << "\t\t\"applicable\": " << applicable << "," << std::endl;
+	out << "\t\t\"generator_time\": " << generator_time << "," << std::endl;
+	out << "\t\t\"scan_time\": " << scan_time << "," << std::endl;
+	out << "\t\t\"generator_rate\": " << generator_rate << "," << std::endl;
+	out << "\t\t\"scan_rate\": " << scan_rate << std::endl;
+	out << "\t}";
+}
+
+void Benchmarks::batch_applicability(const GroundStateModel& model, const std::vector<State>& sample, std::ostream& out) {
+	typedef BatchApplicabilityChecker::Kernel Kernel;
+	const unsigned rounds = 10;
+	const auto& actions = model.getTask().getGroundActions();
+	BatchApplicabilityChecker checker(actions);
+
+	// The linear scan provides both the baseline and the expected results
+	std::size_t expected = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned round = 0; round < rounds; ++round) {
+		for (const State& state:sample) {
+			for (ActionIdx action = 0; action < actions.size(); ++action) {
+				if (actions[action]->checkPrecondition(state)) expected += action + 1;
+			}
+		}
+	}
+	double scan_time = elapsed(start);
+	unsigned long evaluated = static_cast<unsigned long>(rounds) * sample.size();
+
+	std::cout << "Batch applicability benchmark:" << std::endl;
+	std::cout << "\tLinear scan: " << scan_time << " s. (" << ((scan_time > 0) ? evaluated / scan_time : 0) << " states / s.)" << std::endl;
+
+	out << "{" << std::endl;
+	out << "\t\t\"scan_time\": " << scan_time;
+	for (Kernel kernel:{Kernel::SCALAR, Kernel::SSE2, Kernel::AVX2}) {
+		if (!BatchApplicabilityChecker::supported(kernel)) continue;
+
+		std::size_t checksum = 0;
+		start = std::chrono::steady_clock::now();
+		for (unsigned round = 0; round < rounds; ++round) {
+			for (const State& state:sample) {
+				for (ActionIdx action:checker.getCandidates(state, kernel)) checksum += action + 1;
+			}
+		}
+		double time = elapsed(start);
+		if (checksum != expected) throw std::runtime_error("The batch applicability checker does not agree with the linear scan");
+
+		const char* name = BatchApplicabilityChecker::kernel_name(kernel);
+		std::cout << "\t" << name << " kernel: " << time << " s. (" << ((time > 0) ? evaluated / time : 0) << " states / s.)" << std::endl;
+		out << "," << std::endl << "\t\t\"" << name << "_time\": " << time;
+	}
+	out << std::endl << "\t}";
+}
+
+void Benchmarks::novelty_evaluation(const GroundStateModel& model, const std::vector<State>& sample, std::ostream& out) {
+	typedef NoveltyFeaturesConfiguration::Tables Tables;
+	const unsigned rounds = 10;
+
+	std::cout << "Novelty evaluation benchmark:" << std::endl;
+	out << "{";
+	bool first = true;
+	for (unsigned width = 1; width <= 2; ++width) {
+		std::vector<unsigned> expected; // The novelty of each state computed by the aptk tables
+		for (Tables tables:{Tables::APTK, Tables::BITSET, Tables::APPROXIMATE}) {
+			NoveltyFeaturesConfiguration configuration(true, true, false, tables);
+			const char* name = (tables == Tables::APTK) ? "aptk" : ((tables == Tables::BITSET) ? "bitset" : "approximate");
+
+			// Each round starts from empty tables, whose construction is not measured
+			double time = 0;
+			unsigned mismatches = 0;
+			for (unsigned round = 0; round < rounds; ++round) {
+				GenericNoveltyEvaluator evaluator(model.getTask(), width, configuration);
+				std::vector<unsigned> novelty(sample.size());
+				auto start = std::chrono::steady_clock::now();
+				for (unsigned i = 0; i < sample.size(); ++i) novelty[i] = evaluator.evaluate(sample[i]);
+				time += elapsed(start);
+
+				if (expected.empty()) expected = novelty;
+				else if (round == 0) mismatches = sample.size() - std::inner_product(novelty.begin(), novelty.end(), expected.begin(), 0u, std::plus<unsigned>(), std::equal_to<unsigned>());
+			}
+
+			double rate = (time > 0) ? (static_cast<double>(rounds) * sample.size()) / time : 0;
+			std::cout << "\tWidth " << width << ", " << name << " tables: " << time << " s. (" << rate << " evaluations / s., " << mismatches << " mismatches)" << std::endl;
+			out << (first ? "" : ",") << std::endl << "\t\t\"" << name << "_w" << width << "_rate\": " << rate;
+			first = false;
+		}
+	}
+	out << std::endl << "\t}";
+}
+
+} } // namespaces
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <fs_types.hxx>
+
+namespace fs0 { class Problem; class Config; class State; class GroundStateModel; }
+
+namespace fs0 { namespace drivers {
+
+//! A number of micro-benchmarks of the main building blocks of the search, meant to quantify the impact of low-level
+//! optimizations on a particular problem instance. Benchmarks are run instead of the search by selecting the "benchmark" driver.
+class Benchmarks {
+public:
+	//! Run all benchmarks on the given problem, outputting the results to the given directory
+	static void run(Problem& problem, const Config& config, const std::string& out_dir);
+
+	//! Measures the time spent by GroundStateModel::next to generate the successors of a sample of states, whose hash
+	//! is maintained incrementally, and the time spent computing the hash of the same successors from scratch, as it used to be.
+	//! Results are printed to the given stream in JSON format
+	static void successor_generation(const GroundStateModel& model, const std::vector<State>& sample, std::ostream& out);
+
+	//! Measures the time spent computing the actions applicable in a sample of states, both through the model's
+	//! successor generator and through a linear scan over all ground actions. Results are printed to the given stream in JSON format
+	static void applicable_actions(const GroundStateModel& model, const std::vector<State>& sample, std::ostream& out);
+
+	//! Measures the time spent evaluating the preconditions of all ground actions on a sample of states through the
+	//! batch applicability checker, with each of the kernels supported by the CPU, compared to a linear scan over all
+	//! ground actions. Results are printed to the given stream in JSON format
+	static void batch_applicability(const GroundStateModel& model, const std::vector<State>& sample, std::ostream& out);
+
+	//! Measures the number of novelty evaluations per second, for widths 1 and 2, of the aptk novelty tables, of
+	//! the native bitset tables and of the approximate tables, counting the states of the sample (evaluated in order) on
+	//! which the latter two disagree with the aptk tables. Results are printed to the given stream in JSON format
+	static void novelty_evaluation(const GroundStateModel& model, const std::vector<State>& sample, std::ostream& out);
+
+	//! Returns a sample of (at most) 'size' states obtained through random walks from the initial state of the problem
+	static std::vector<State> sample_states(const GroundStateModel& model, unsigned size, unsigned seed);
+};
+
+} } // namespaces
@@ -32,10 +32,19 @@ public:
 	virtual GenericNoveltyEvaluator& evaluator(const State& state) = 0;
 
 	inline unsigned novelty(const State& state) { return evaluator(state).evaluate(state); }
+	
+	//! Computes the novelty of the given state incrementally with respect to that of its parent state, which must
+	//! have been evaluated by this same component. Subclasses must make sure that the evaluator in charge of the
+	//! state has also evaluated the parent.
+	virtual unsigned novelty(const State& state, const State& parent) { return evaluator(state).evaluate(state, parent); }
 
 	//! Returns false iff we want to prune this node during the search
-	bool accept(const SearchNode& n) {
-		return novelty(n.state) <= novelty_bound();
+	bool accept(const SearchNode& n, const State& state) {
+		return novelty(state) <= novelty_bound();
+	}
+	
+	bool accept(const SearchNode& n, const State& state, const State& parent) {
+		return novelty(state, parent) <= novelty_bound();
 	}
 };
 
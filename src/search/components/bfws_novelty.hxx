@@ -0,0 +1,53 @@
+
+#pragma once
+
+#include <functional>
+
+#include <search/components/unsat_goals_novelty.hxx>
+#include <search/components/relaxed_plan_atoms.hxx>
+
+namespace fs0 { namespace drivers {
+
+//! The novelty component of BFWS(f), which partitions states by their number #g of unsatisfied goals and their number #r
+//! of achieved atoms of a relaxed plan. The relaxed plan of a search node is the one computed on the closest node of its
+//! path from the root (the node itself included) where #g decreased, or on the root. It is stored in the node and
+//! propagated to its descendants, so that #r measures the progress made towards the goals since #g last decreased.
+//! The search nodes must provide the fields of a BFWSNode.
+template <typename SearchNode>
+class BFWSNoveltyComponent : public UnsatGoalsNoveltyComponent<SearchNode> {
+public:
+	typedef UnsatGoalsNoveltyComponent<SearchNode> Base;
+	typedef typename Base::PartitionKey PartitionKey;
+	
+	//! A function computing the atoms of a relaxed plan from a given state
+	typedef std::function<RelaxedPlanAtoms(const State&)> RelaxedPlanner;
+	
+	//! The values of #r are grouped in buckets of the given size
+	BFWSNoveltyComponent(const GroundStateModel& model, unsigned max_novelty, const NoveltyFeaturesConfiguration& feature_configuration,
+	                     RelaxedPlanner&& planner, unsigned bucket_size)
+		: Base(model, max_novelty, feature_configuration), _planner(std::move(planner)), _bucket_size(bucket_size)
+	{
+		assert(bucket_size > 0);
+	}
+	
+	BFWSNoveltyComponent(BFWSNoveltyComponent&&) = default;
+	
+	//! Evaluates the given search node, whose state is given, incrementally with respect to the state of its parent node, if given
+	void evaluate(SearchNode& node, const State& state, const State* parent) {
+		node.num_unsat = this->evaluate_num_unsat_goals(state);
+		if (!node.relaxed_plan || node.num_unsat < node.parent_num_unsat) node.relaxed_plan = _planner(state);
+		node.num_achieved = count_achieved_atoms(*node.relaxed_plan, state);
+		
+		PartitionKey key(node.num_unsat, node.num_achieved / _bucket_size);
+		node.novelty = parent ? this->novelty(state, *parent, key, PartitionKey(node.parent_num_unsat, node.parent_num_achieved / _bucket_size))
+		                      : this->novelty(state, key);
+		if (node.novelty > this->novelty_bound()) node.novelty = SearchNode::DEAD_END;
+	}
+
+protected:
+	RelaxedPlanner _planner;
+	
+	unsigned _bucket_size;
+};
+
+} } // namespaces
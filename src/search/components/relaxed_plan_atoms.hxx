@@ -0,0 +1,63 @@
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <fs_types.hxx>
+#include <atom.hxx>
+#include <state.hxx>
+#include <heuristics/heuristic_cache.hxx>
+#include <aptk2/tools/logging.hxx>
+
+namespace fs0 { namespace drivers {
+
+//! The atoms of a relaxed plan, which BFWS shares among all the search nodes below the node on which the plan was computed
+typedef std::shared_ptr<const std::vector<Atom>> RelaxedPlanAtoms;
+
+//! Returns the number of the given relaxed plan atoms that hold in the given state
+inline unsigned count_achieved_atoms(const std::vector<Atom>& atoms, const State& state) {
+	unsigned achieved = 0;
+	for (const Atom& atom:atoms) {
+		if (state.contains(atom)) ++achieved;
+	}
+	return achieved;
+}
+
+//! Computes the relaxed plans whose atoms BFWS counts to refine its novelty partitions. The RPG heuristic must provide a
+//! 'long evaluate(const State&, std::vector<Atom>&)' method returning -1 if the goal is unreachable, and storing otherwise
+//! the atoms achieved by the relaxed plan. If a heuristic cache is given, relaxed plans are memoized in it.
+template <typename RPGT>
+class RelaxedPlanAtomsCounter {
+public:
+	RelaxedPlanAtomsCounter(RPGT&& rpg, std::unique_ptr<HeuristicCache>&& cache = nullptr)
+		: _rpg(std::move(rpg)), _cache(std::move(cache)), _num_plans(0)
+	{}
+	
+	~RelaxedPlanAtomsCounter() {
+		LPT_INFO("heuristic", "Relaxed plans computed for the partitioning of novelty: " << _num_plans);
+	}
+	
+	RelaxedPlanAtomsCounter(const RelaxedPlanAtomsCounter&) = delete;
+	RelaxedPlanAtomsCounter& operator=(const RelaxedPlanAtomsCounter&) = delete;
+	
+	//! Returns the atoms of a relaxed plan computed from the given state, or no atoms at all if the state is a relaxed
+	//! dead end, whose novelty is then simply not refined
+	RelaxedPlanAtoms compute(const State& state) {
+		++_num_plans;
+		std::vector<Atom> atoms;
+		long h = _cache ? _cache->evaluate(_rpg, state, atoms) : _rpg.evaluate(state, atoms);
+		if (h == -1) atoms.clear();
+		return std::make_shared<const std::vector<Atom>>(std::move(atoms));
+	}
+	
+protected:
+	RPGT _rpg;
+	
+	std::unique_ptr<HeuristicCache> _cache;
+	
+	//! The number of relaxed plans requested so far, including those retrieved from the cache
+	unsigned long _num_plans;
+};
+
+} } // namespaces
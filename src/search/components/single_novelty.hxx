@@ -21,18 +21,28 @@ class SingleNoveltyComponent : public BaseNoveltyComponent<SearchNode> {
 protected:
 	//! A single novelty evaluator will be in charge of evaluating all nodes
 	GenericNoveltyEvaluator _novelty_evaluator;
+	
+	NoveltyFeaturesConfiguration _feature_configuration;
 
 public:
 	typedef BaseNoveltyComponent<SearchNode> Base;
 	
 	SingleNoveltyComponent(const GroundStateModel& model, unsigned max_novelty, const NoveltyFeaturesConfiguration& feature_configuration)
-		: Base(max_novelty), _novelty_evaluator(model.getTask(), max_novelty, feature_configuration)
+		: Base(max_novelty), _novelty_evaluator(model.getTask(), max_novelty, feature_configuration), _feature_configuration(feature_configuration)
+	{}
+	
+	//! A component over a (shared) set of features that has already been built
+	SingleNoveltyComponent(const std::shared_ptr<const NoveltyFeatureSet>& features, unsigned max_novelty, const NoveltyFeaturesConfiguration& feature_configuration)
+		: Base(max_novelty), _novelty_evaluator(features, max_novelty, feature_configuration), _feature_configuration(feature_configuration)
 	{}
 	
 	~SingleNoveltyComponent() {
 		for ( unsigned k = 1; k <= Base::novelty_bound(); k++ ) {
 			LPT_INFO("heuristic", "# novelty(s)=" << k << " : " << _novelty_evaluator.get_num_states(k));
 		}
+		if (_feature_configuration.tables() == NoveltyFeaturesConfiguration::Tables::APPROXIMATE) {
+			LPT_INFO("heuristic", "Estimated false positive rate: " << _novelty_evaluator.estimated_false_positive_rate());
+		}
 	}
 
 	GenericNoveltyEvaluator& evaluator(const State& state) { return _novelty_evaluator; }
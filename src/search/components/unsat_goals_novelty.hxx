@@ -1,6 +1,10 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <functional>
+
 #include <fs_types.hxx>
 #include <ground_state_model.hxx>
 #include <aptk2/tools/logging.hxx>
@@ -17,39 +21,127 @@ namespace fs0 { namespace drivers {
 //! It accepts a new search node iff its novelty less than or equal to the max novelty bound
 template <typename SearchNode>
 class UnsatGoalsNoveltyComponent : public BaseNoveltyComponent<SearchNode> {
+public:
+	//! States are partitioned by their number of unsatisfied goals plus an optional, refining bucket
+	typedef std::pair<unsigned, unsigned> PartitionKey;
+	
+	//! A function computing the refining bucket of a state, e.g. from the value of some heuristic
+	typedef std::function<unsigned(const State&)> PartitionRefinement;
+	
 protected:
-	//! We have k+1 novelty evaluators, where k is the number of goal conditions, so that we can evaluate the novelty
-	//! of a state with respect to all previous states __with the same number of unsatisfied goals__
-	//! Thus, '_novelty_evaluators[i]' gives us the novelty evaluator that contains the data of all
-	//! previous states which had 'i' unsatisfied goal conditions
-	std::vector<GenericNoveltyEvaluator> _novelty_evaluators;
+	//! The novelty of a state is evaluated with respect to all previous states __in the same partition__, i.e. with the
+	//! same number of unsatisfied goals (and refining bucket). Thus, '_novelty_evaluators[key]' gives us the novelty evaluator
+	//! that contains the data of all previous states in partition 'key'. Evaluators are created only the first time that
+	//! a state falls in their partition, since most of the possible partitions are usually never reached.
+	std::map<PartitionKey, std::unique_ptr<GenericNoveltyEvaluator>> _novelty_evaluators;
+	
+	//! The features are shared by the evaluators of all partitions
+	std::shared_ptr<const NoveltyFeatureSet> _features;
+	
+	NoveltyFeaturesConfiguration _feature_configuration;
+	
+	//! With the approximate novelty tables, the filter in which the evaluators of all partitions record their tuples,
+	//! so that the memory budget of the tables bounds the memory of all partitions together
+	std::shared_ptr<BlockedBloomFilter> _filter;
 	
 	//! An UnsatisfiedGoalAtomsHeuristic to count the number of unsatisfied goals
 	UnsatisfiedGoalAtomsHeuristic _unsat_goal_atoms_heuristic;
+	
+	//! The refinement of the partitions, if any, and the size of the buckets in which its values are grouped
+	PartitionRefinement _refinement;
+	unsigned _bucket_size;
 
 public:
 	typedef BaseNoveltyComponent<SearchNode> Base;
+	using Base::novelty;
 
 	UnsatGoalsNoveltyComponent(const GroundStateModel& model, unsigned max_novelty, const NoveltyFeaturesConfiguration& feature_configuration)
 		: Base(max_novelty), 
-		  _novelty_evaluators(model.getTask().getGoalConditions()->all_atoms().size()+1, GenericNoveltyEvaluator(model.getTask(), max_novelty, feature_configuration)), // We set up k+1 identical evaluators
-		  _unsat_goal_atoms_heuristic(model)
+		  _novelty_evaluators(),
+		  _features(std::make_shared<const NoveltyFeatureSet>(model.getTask(), feature_configuration)),
+		  _feature_configuration(feature_configuration),
+		  _filter(nullptr),
+		  _unsat_goal_atoms_heuristic(model),
+		  _refinement(),
+		  _bucket_size(1)
 	{
 		if (!dynamic_cast<const fs::Conjunction*>(model.getTask().getGoalConditions())) {
 			throw std::runtime_error("NoveltyComponent available only for goal conjunctions");
 		}
+		if (feature_configuration.tables() == NoveltyFeaturesConfiguration::Tables::APPROXIMATE) {
+			_filter = std::make_shared<BlockedBloomFilter>(std::size_t(feature_configuration.approximateMemory()) << 20, feature_configuration.approximateHashes());
+		}
 	}
 	
+	UnsatGoalsNoveltyComponent(UnsatGoalsNoveltyComponent&&) = default;
+	
 	~UnsatGoalsNoveltyComponent() {
-		for (unsigned j = 0; j < _novelty_evaluators.size(); j++)
+		if (!_features) return; // A moved-from component has nothing to report
+		LPT_INFO("heuristic", "# novelty partitions: " << _novelty_evaluators.size());
+		for (const auto& partition:_novelty_evaluators) {
 			for ( unsigned k = 1; k <= Base::novelty_bound(); k++ ) {
-				LPT_INFO("heuristic", "# novelty(s)[#goals=" << j << "]=" << k << " : " << _novelty_evaluators[j].get_num_states(k));
+				LPT_INFO("heuristic", "# novelty(s)[#goals=" << partition.first.first << ", bucket=" << partition.first.second << "]=" << k << " : " << partition.second->get_num_states(k));
 			}
+		}
+		if (_filter) {
+			LPT_INFO("heuristic", "Estimated false positive rate: " << _filter->estimated_false_positive_rate());
+		}
+	}
+	
+	//! Further partition the states with the same number of unsatisfied goals by the value of the given function,
+	//! grouped in buckets of the given size. Must be set before any state is evaluated.
+	void setPartitionRefinement(const PartitionRefinement& refinement, unsigned bucket_size = 1) {
+		assert(_novelty_evaluators.empty() && bucket_size > 0);
+		_refinement = refinement;
+		_bucket_size = bucket_size;
 	}
 
 	unsigned evaluate_num_unsat_goals(const State& state) const { return _unsat_goal_atoms_heuristic.evaluate(state); }
+	
+	PartitionKey partition(const State& state) const {
+		return std::make_pair(evaluate_num_unsat_goals(state), _refinement ? _refinement(state) / _bucket_size : 0);
+	}
 
-	GenericNoveltyEvaluator& evaluator(const State& state) { return _novelty_evaluators[evaluate_num_unsat_goals(state)]; }
+	GenericNoveltyEvaluator& evaluator(const State& state) { return evaluator(partition(state)); }
+	
+	GenericNoveltyEvaluator& evaluator(const PartitionKey& key) {
+		auto& evaluator = _novelty_evaluators[key];
+		if (!evaluator) {
+			uint64_t seed = (uint64_t(key.first) << 32) | key.second;
+			evaluator = std::unique_ptr<GenericNoveltyEvaluator>(new GenericNoveltyEvaluator(_features, Base::novelty_bound(), _feature_configuration, _filter, seed));
+		}
+		return *evaluator;
+	}
+	
+	//! Evaluates the given search node, whose state is given, incrementally with respect to the state of its parent node, if given.
+	//! The partition of each node is stored in the node and passed on to its children, so that the partition of the parent,
+	//! which with a refinement might be costly to compute, is never computed again.
+	//! The search nodes must provide the fields of a GBFSNoveltyNode.
+	void evaluate(SearchNode& node, const State& state, const State* parent) {
+		PartitionKey key = partition(state);
+		node.num_unsat = key.first;
+		node.bucket = key.second;
+		node.novelty = parent ? novelty(state, *parent, key, PartitionKey(node.parent_num_unsat, node.parent_bucket))
+		                      : novelty(state, key);
+		if (node.novelty > Base::novelty_bound()) node.novelty = SearchNode::DEAD_END;
+	}
+	
+	//! The novelty of a state can be computed incrementally only if its parent has been evaluated by the same evaluator,
+	//! i.e. belongs to the same partition. Note that this computes the partition of the parent; search nodes should rather
+	//! be evaluated through 'evaluate', which reuses the partition stored in the parent node.
+	unsigned novelty(const State& state, const State& parent) {
+		return novelty(state, parent, partition(state), partition(parent));
+	}
+	
+	//! Computes the novelty of the given state within the given partition, for subclasses that determine the partitions by other means
+	unsigned novelty(const State& state, const PartitionKey& key) { return evaluator(key).evaluate(state); }
+	
+	//! Same as above, but incrementally with respect to the given parent state if it belongs to the same partition,
+	//! 'parent_key' being the partition in which the parent was evaluated
+	unsigned novelty(const State& state, const State& parent, const PartitionKey& key, const PartitionKey& parent_key) {
+		GenericNoveltyEvaluator& evaluator = this->evaluator(key);
+		return (key == parent_key) ? evaluator.evaluate(state, parent) : evaluator.evaluate(state);
+	}
 };
 
 } } // namespaces
@@ -6,7 +6,7 @@
 #include <problem.hxx>
 #include <state.hxx>
 #include <actions/ground_action_iterator.hxx>
-#include <aptk2/search/algorithms/best_first_search.hxx>
+#include <search/algorithms/best_first_search.hxx>
 #include <asp/asp_hplus.hxx>
 
 namespace fs0 { namespace drivers {
@@ -20,13 +20,13 @@ std::unique_ptr<FS0SearchAlgorithm> ASPEngine::create(const Config& config, cons
 	std::string search = config.getOption<std::string>("engine.search");
 	if (search == "astar") {
 		LPT_INFO("main", "Chosen engine: A* with ASP-based h+ computation");
-		typedef AStarSearchNode<State, GroundAction> AStarNode;
-		engine = new aptk::StlBestFirstSearch<AStarNode, asp::ASPHPlus, GroundStateModel>(model, asp::ASPHPlus(problem));
+		typedef AStarSearchNode<GroundAction> AStarNode;
+		engine = new FS0BestFirstSearch<AStarNode, asp::ASPHPlus, GroundStateModel>(model, asp::ASPHPlus(problem), false);
 	} else {
 		assert(search == "gbfs");
 		LPT_INFO("main", "Chosen engine: GBFS with ASP-based h+ computation");
-		typedef HeuristicSearchNode<State, GroundAction> GBFSNode;
-		engine = new aptk::StlBestFirstSearch<GBFSNode, asp::ASPHPlus, GroundStateModel>(model, asp::ASPHPlus(problem));
+		typedef HeuristicSearchNode<GroundAction> GBFSNode;
+		engine = new FS0BestFirstSearch<GBFSNode, asp::ASPHPlus, GroundStateModel>(model, asp::ASPHPlus(problem), false);
 	}
 	return std::unique_ptr<FS0SearchAlgorithm>(engine);
 }
@@ -0,0 +1,86 @@
+
+#include <search/drivers/bfws.hxx>
+#include <search/drivers/native_driver.hxx>
+#include <search/components/relaxed_plan_atoms.hxx>
+#include <heuristics/heuristic_cache.hxx>
+#include <search/algorithms/best_first_search.hxx>
+#include <heuristics/relaxed_plan/direct_crpg.hxx>
+#include <heuristics/relaxed_plan/smart_rpg.hxx>
+#include <heuristics/relaxed_plan/propositional_rpg.hxx>
+#include <constraints/direct/direct_rpg_builder.hxx>
+#include <constraints/direct/action_manager.hxx>
+#include <constraints/gecode/handlers/lifted_effect_csp.hxx>
+#include <actions/ground_action_iterator.hxx>
+#include <actions/grounding.hxx>
+#include <problem.hxx>
+#include <problem_info.hxx>
+#include <utils/support.hxx>
+#include <utils/config.hxx>
+
+using namespace fs0::gecode;
+
+namespace fs0 { namespace drivers {
+
+std::unique_ptr<FS0SearchAlgorithm> BFWSDriver::create(const Config& config, const GroundStateModel& model) const {
+	const Problem& problem = model.getTask();
+	unsigned max_novelty = config.getOption<int>("engine.max_novelty");
+	bool delayed = config.useDelayedEvaluation();
+	int bucket_size = config.getOption<int>("engine.bfws_bucket_size", 1);
+	if (bucket_size < 1) throw std::runtime_error("The BFWS bucket size must be positive");
+	
+	if (!dynamic_cast<const fs::Conjunction*>(problem.getGoalConditions())) throw std::runtime_error("BFWS available only for goal conjunctions");
+	
+	NoveltyFeaturesConfiguration feature_configuration(config);
+	
+	// The partition of each state is refined by the number of atoms that hold in it of the relaxed plan computed where
+	// the number of unsatisfied goals last decreased along its path. Relaxed plans are expensive, and hence computed only then.
+	NoveltyHeuristic::RelaxedPlanner planner;
+	bool propositional = config.getOption<bool>("engine.propositional_rpg", true) && PropositionalRPG::is_supported(problem);
+	bool native = NativeDriver::check_supported(problem);
+	bool incremental = config.getOption<bool>("engine.incremental_rpg", false);
+	if (incremental && !propositional) throw std::runtime_error("The incremental RPG is only available for problems supported by the propositional RPG");
+	if (propositional) {
+		PropositionalRPG rpg(problem, PropositionalRPG::Type::HFF, incremental);
+		auto counter = std::make_shared<RelaxedPlanAtomsCounter<PropositionalRPG>>(std::move(rpg), HeuristicCache::create(config, true));
+		planner = [counter](const State& state) { return counter->compute(state); };
+	} else if (native) {
+		auto builder = DirectRPGBuilder::create(problem.getGoalConditions(), problem.getStateConstraints());
+		DirectCRPG rpg(problem, DirectActionManager::create(problem.getGroundActions()), std::move(builder));
+		auto counter = std::make_shared<RelaxedPlanAtomsCounter<DirectCRPG>>(std::move(rpg), HeuristicCache::create(config, true));
+		planner = [counter](const State& state) { return counter->compute(state); };
+	} else {
+		bool novelty = config.useNoveltyConstraint() && !problem.is_predicative();
+		bool approximate = config.useApproximateActionResolution();
+		const auto& tuple_index = problem.get_tuple_index();
+		const std::vector<const PartiallyGroundedAction*>& actions = problem.getPartiallyGroundedActions();
+		auto managers = LiftedEffectCSP::create_smart(actions, tuple_index, approximate, novelty);
+		
+		const auto managed = support::compute_managed_symbols(std::vector<const ActionBase*>(actions.begin(), actions.end()), problem.getGoalConditions(), problem.getStateConstraints());
+		ExtensionHandler extension_handler(tuple_index, managed);
+		
+		SmartRPG rpg(problem, problem.getGoalConditions(), problem.getStateConstraints(), std::move(managers), extension_handler);
+		auto counter = std::make_shared<RelaxedPlanAtomsCounter<SmartRPG>>(std::move(rpg), HeuristicCache::create(config, true));
+		planner = [counter](const State& state) { return counter->compute(state); };
+	}
+	
+	NoveltyHeuristic heuristic(model, max_novelty, feature_configuration, std::move(planner), bucket_size);
+	
+	LPT_INFO("main", "Heuristic options:");
+	LPT_INFO("main", "\tMax novelty: " << max_novelty);
+	LPT_INFO("main", "\tFeature extraction: " << feature_configuration);
+	LPT_INFO("main", "\tRelaxed plans: " << (propositional ? "propositional" : (native ? "native" : "smart")) << (incremental ? " incremental" : "") << " RPG, buckets of " << bucket_size << " atoms");
+	LPT_INFO("main", "\tRelaxed plan cache: " << (HeuristicCache::configured_memory(config) >> 20) << " MB");
+	
+	return std::unique_ptr<FS0SearchAlgorithm>(new FS0BestFirstSearch<SearchNode, NoveltyHeuristic, GroundStateModel, OpenList>(model, std::move(heuristic), delayed));
+}
+
+GroundStateModel BFWSDriver::setup(const Config& config, Problem& problem) const {
+	problem.setGroundActions(ActionGrounder::fully_ground(problem.getActionData(), ProblemInfo::getInstance()));
+	bool propositional = config.getOption<bool>("engine.propositional_rpg", true) && PropositionalRPG::is_supported(problem);
+	if (!propositional && !NativeDriver::check_supported(problem)) {
+		problem.setPartiallyGroundedActions(ActionGrounder::fully_lifted(problem.getActionData(), ProblemInfo::getInstance()));
+	}
+	return GroundStateModel(problem);
+}
+
+} } // namespaces
@@ -0,0 +1,33 @@
+
+#pragma once
+
+#include <search/drivers/registry.hxx>
+#include <search/nodes/bfws_node.hxx>
+#include <search/components/bfws_novelty.hxx>
+#include <search/algorithms/open_lists.hxx>
+
+namespace fs0 { class GroundStateModel; class Config; }
+
+namespace fs0 { namespace drivers {
+
+//! A creator for the Best-First Width Search engine BFWS(f), a greedy best-first search ordered by the novelty of each
+//! state (then by its number of unsatisfied goals), where the novelty is computed with respect to the previous states with
+//! the same number of unsatisfied goals and of achieved atoms of the relaxed plan computed where that number last decreased
+class BFWSDriver : public Driver {
+public:
+	//! BFWS nodes carry the relaxed plan of their path
+	typedef BFWSNode<GroundAction> SearchNode;
+	
+	typedef BFWSNoveltyComponent<SearchNode> NoveltyHeuristic;
+	
+	//! Nodes are prioritized by (novelty, #unsatisfied goals, g) through a bucket-based open list
+	typedef NoveltyBucketOpenList<SearchNode> OpenList;
+	
+	std::unique_ptr<FS0SearchAlgorithm> create(const Config& config, const GroundStateModel& model) const;
+	
+	//! The relaxed plans are computed with the native RPG if possible, or otherwise with the (lifted) smart RPG, which
+	//! needs the partially grounded actions
+	GroundStateModel setup(const Config& config, Problem& problem) const;
+};
+
+} } // namespaces
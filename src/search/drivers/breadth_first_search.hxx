@@ -3,8 +3,7 @@
 
 #include <search/drivers/registry.hxx>
 #include <search/nodes/blind_search_node.hxx>
-#include <aptk2/search/algorithms/breadth_first_search.hxx>
-#include <aptk2/search/components/stl_unsorted_fifo_open_list.hxx>
+#include <search/algorithms/breadth_first_search.hxx>
 
 namespace fs0 { class GroundStateModel; class Config; }
 
@@ -14,10 +13,10 @@ namespace fs0 { namespace drivers {
 class BreadthFirstSearchDriver : public Driver {
 public:
 	//! The Breadth-First Search engine uses a simple blind-search node
-	typedef BlindSearchNode<fs0::State> SearchNode;
+	typedef BlindSearchNode<GroundAction> SearchNode;
 	
 	std::unique_ptr<FS0SearchAlgorithm> create(const Config& config, const GroundStateModel& model) const {
-		FS0SearchAlgorithm* engine = new aptk::StlBreadthFirstSearch<SearchNode, GroundStateModel>(model);
+		FS0SearchAlgorithm* engine = new FS0BreadthFirstSearch<SearchNode, GroundStateModel>(model);
 		return std::unique_ptr<FS0SearchAlgorithm>(engine);
 	}
 	
@@ -2,7 +2,7 @@
 #include <search/drivers/fully_lifted_driver.hxx>
 #include <search/drivers/validation.hxx>
 #include <problem.hxx>
-#include <aptk2/search/algorithms/best_first_search.hxx>
+#include <search/algorithms/best_first_search.hxx>
 #include <heuristics/relaxed_plan/gecode_crpg.hxx>
 #include <constraints/gecode/handlers/lifted_action_csp.hxx>
 #include <constraints/gecode/handlers/formula_csp.hxx>
@@ -32,7 +32,7 @@ std::unique_ptr<aptk::SearchAlgorithm<LiftedStateModel>> FullyLiftedDriver::crea
 	ExtensionHandler extension_handler(problem.get_tuple_index(), managed);
 	
 	GecodeCRPG heuristic(problem, problem.getGoalConditions(), problem.getStateConstraints(), std::move(managers), extension_handler);
-	return std::unique_ptr<LiftedEngine>(new aptk::StlBestFirstSearch<SearchNode, GecodeCRPG, LiftedStateModel>(model, std::move(heuristic), delayed));
+	return std::unique_ptr<LiftedEngine>(new FS0BestFirstSearch<SearchNode, GecodeCRPG, LiftedStateModel>(model, std::move(heuristic), delayed));
 }
 
 
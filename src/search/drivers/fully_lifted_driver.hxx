@@ -17,7 +17,7 @@ typedef aptk::SearchAlgorithm<LiftedStateModel> LiftedEngine;
 //! A rather more specific engine creator that simply creates a GBFS planner for lifted planning
 class FullyLiftedDriver {
 protected:
-	typedef HeuristicSearchNode<State, LiftedActionID> SearchNode;
+	typedef HeuristicSearchNode<LiftedActionID> SearchNode;
 	
 public:
 	std::unique_ptr<LiftedEngine> create(const Config& config, LiftedStateModel& model) const;
@@ -4,10 +4,11 @@
 #include <search/drivers/validation.hxx>
 #include <problem.hxx>
 #include <state.hxx>
-#include <aptk2/search/algorithms/best_first_search.hxx>
+#include <search/algorithms/best_first_search.hxx>
 #include <heuristics/relaxed_plan/gecode_crpg.hxx>
 #include <heuristics/relaxed_plan/unreached_atom_rpg.hxx>
 #include <heuristics/relaxed_plan/direct_crpg.hxx>
+#include <heuristics/relaxed_plan/propositional_rpg.hxx>
 #include <constraints/gecode/handlers/ground_action_csp.hxx>
 #include <constraints/gecode/handlers/ground_effect_csp.hxx>
 #include <constraints/gecode/handlers/lifted_action_csp.hxx>
@@ -28,6 +29,16 @@ std::unique_ptr<FS0SearchAlgorithm> GBFSConstrainedHeuristicsCreator::create(con
 	bool approximate = config.useApproximateActionResolution();
 	bool delayed = config.useDelayedEvaluation();
 	
+	if (config.getOption<bool>("engine.propositional_rpg", true) && PropositionalRPG::is_supported(problem)) {
+		LPT_INFO("main", "Chosen RPG: propositional");
+		PropositionalRPG heuristic(problem, PropositionalRPG::parse_type(config.getHeuristic()), config.getOption<bool>("engine.incremental_rpg", false));
+		return std::unique_ptr<FS0SearchAlgorithm>(new FS0BestFirstSearch<SearchNode, PropositionalRPG, GroundStateModel>(model, std::move(heuristic), delayed));
+	}
+	
+	if (config.getOption<bool>("engine.incremental_rpg", false)) throw std::runtime_error("The incremental RPG is only available for problems supported by the propositional RPG");
+	
+	if (config.getHeuristic() == "hadd") throw std::runtime_error("The h_add heuristic is only available for propositional problems");
+	
 	LPT_INFO("main", "Chosen CSP Manager: Gecode");
 	
 	Validation::check_no_conditional_effects(problem);
@@ -38,11 +49,11 @@ std::unique_ptr<FS0SearchAlgorithm> GBFSConstrainedHeuristicsCreator::create(con
 	
 	if (config.getHeuristic() == "hff") {
 		GecodeCRPG heuristic(problem, problem.getGoalConditions(), problem.getStateConstraints(), std::move(managers), extension_handler);
-		return std::unique_ptr<FS0SearchAlgorithm>(new aptk::StlBestFirstSearch<SearchNode, GecodeCRPG, GroundStateModel>(model, std::move(heuristic), delayed));
+		return std::unique_ptr<FS0SearchAlgorithm>(new FS0BestFirstSearch<SearchNode, GecodeCRPG, GroundStateModel>(model, std::move(heuristic), delayed));
 	} else {
 		assert(config.getHeuristic() == "hmax");
 		GecodeCHMax heuristic(problem, problem.getGoalConditions(), problem.getStateConstraints(), std::move(managers), extension_handler);
-		return std::unique_ptr<FS0SearchAlgorithm>(new aptk::StlBestFirstSearch<SearchNode, GecodeCHMax, GroundStateModel>(model, std::move(heuristic), delayed));
+		return std::unique_ptr<FS0SearchAlgorithm>(new FS0BestFirstSearch<SearchNode, GecodeCHMax, GroundStateModel>(model, std::move(heuristic), delayed));
 	}
 }
 
@@ -16,7 +16,7 @@ namespace fs0 { namespace drivers {
 //! The choice of the heuristic is done through template instantiation
 class GBFSConstrainedHeuristicsCreator : public Driver {
 protected:
-	typedef HeuristicSearchNode<State, GroundAction> SearchNode;
+	typedef HeuristicSearchNode<GroundAction> SearchNode;
 	
 public:
 	std::unique_ptr<FS0SearchAlgorithm> create(const Config& config, const GroundStateModel& problem) const;
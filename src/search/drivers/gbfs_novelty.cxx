@@ -1,8 +1,12 @@
 
+#include <limits>
+
 #include <search/drivers/gbfs_novelty.hxx>
-#include <aptk2/search/algorithms/breadth_first_search.hxx>
-#include <aptk2/search/algorithms/best_first_search.hxx>
+#include <search/algorithms/best_first_search.hxx>
+#include <heuristics/relaxed_plan/propositional_rpg.hxx>
+#include <heuristics/heuristic_cache.hxx>
 #include <actions/ground_action_iterator.hxx>
+#include <utils/config.hxx>
 
 namespace fs0 { namespace drivers {
 	
@@ -15,11 +19,32 @@ std::unique_ptr<FS0SearchAlgorithm> GBFSNoveltyDriver::create(const Config& conf
 	NoveltyFeaturesConfiguration feature_configuration(config);
 	
 	NoveltyHeuristic heuristic(model, max_novelty, feature_configuration);
-	engine = new aptk::StlBestFirstSearch<SearchNode, NoveltyHeuristic, GroundStateModel>(model, std::move(heuristic), delayed);
+	
+	// The partitions of states with the same number of unsatisfied goals can optionally be refined by their h_FF value
+	std::string refinement = config.getOption<std::string>("engine.novelty_partition", "goals");
+	int bucket_size = config.getOption<int>("engine.novelty_partition_bucket_size", 1);
+	if (bucket_size < 1) throw std::runtime_error("The novelty partition bucket size must be positive");
+	if (refinement == "hff") {
+		if (!PropositionalRPG::is_supported(model.getTask())) throw std::runtime_error("Novelty partitions refined by h_FF require a problem supported by the propositional RPG");
+		auto rpg = std::make_shared<PropositionalRPG>(model.getTask(), PropositionalRPG::Type::HFF);
+		std::shared_ptr<HeuristicCache> cache(HeuristicCache::create(config));
+		heuristic.setPartitionRefinement([rpg, cache](const State& state) {
+			long h = cache ? cache->evaluate(*rpg, state) : rpg->evaluate(state);
+			return h < 0 ? std::numeric_limits<unsigned>::max() : static_cast<unsigned>(h); // Dead ends get a partition of their own
+		}, bucket_size);
+	} else if (refinement != "goals") {
+		throw std::runtime_error("Unknown novelty partition: " + refinement);
+	}
+	
+	engine = new FS0BestFirstSearch<SearchNode, NoveltyHeuristic, GroundStateModel, OpenList>(model, std::move(heuristic), delayed);
 	
 	LPT_INFO("main", "Heuristic options:");
 	LPT_INFO("main", "\tMax novelty: " << max_novelty);
 	LPT_INFO("main", "\tFeatiue extaction: " << feature_configuration);
+	LPT_INFO("main", "\tNovelty partitions: #unsatisfied goals" << (refinement == "hff" ? " and h_FF, in buckets of " + std::to_string(bucket_size) : ""));
+	if (refinement == "hff") {
+		LPT_INFO("main", "\th_FF cache: " << (HeuristicCache::configured_memory(config) >> 20) << " MB");
+	}
 	
 	return std::unique_ptr<FS0SearchAlgorithm>(engine);
 }
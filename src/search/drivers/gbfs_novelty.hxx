@@ -4,7 +4,7 @@
 #include <search/drivers/registry.hxx>
 #include <search/nodes/gbfs_novelty_node.hxx>
 #include <search/components/unsat_goals_novelty.hxx>
-#include <aptk2/search/components/stl_unsorted_fifo_open_list.hxx>
+#include <search/algorithms/open_lists.hxx>
 
 namespace fs0 { class GroundStateModel; class Config; }
 
@@ -14,10 +14,13 @@ namespace fs0 { namespace drivers {
 class GBFSNoveltyDriver : public Driver {
 public:
 	//! We use a GBFS heuristic search node
-	typedef GBFSNoveltyNode<fs0::State> SearchNode;
+	typedef GBFSNoveltyNode<GroundAction> SearchNode;
 	
 	typedef UnsatGoalsNoveltyComponent<SearchNode> NoveltyHeuristic;
 	
+	//! Nodes are prioritized by (novelty, #unsatisfied goals, g) through a bucket-based open list
+	typedef NoveltyBucketOpenList<SearchNode> OpenList;
+	
 	std::unique_ptr<FS0SearchAlgorithm> create(const Config& config, const GroundStateModel& model) const;
 };
 
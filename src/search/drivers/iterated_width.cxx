@@ -14,7 +14,10 @@ std::unique_ptr<FS0SearchAlgorithm> IteratedWidthDriver::create(const Config& co
 	LPT_INFO("main", "\tMax novelty: " << max_novelty);
 	LPT_INFO("main", "\tFeatiue extaction: " << feature_configuration);
 	
-	FS0SearchAlgorithm* engine = new FS0IWAlgorithm(model, 1, max_novelty, feature_configuration);
+	std::size_t cache_memory = std::size_t(config.getOption<int>("engine.iw_cache_memory", 256)) << 20;
+	LPT_INFO("main", "\tSuccessor cache: " << (cache_memory >> 20) << " MB");
+	
+	FS0SearchAlgorithm* engine = new FS0IWAlgorithm(model, 1, max_novelty, feature_configuration, cache_memory);
 	return std::unique_ptr<FS0SearchAlgorithm>(engine);
 }
 
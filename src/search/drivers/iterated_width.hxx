@@ -4,7 +4,6 @@
 #include <search/drivers/registry.hxx>
 #include <search/nodes/blind_search_node.hxx>
 #include <search/components/single_novelty.hxx>
-#include <aptk2/search/components/stl_unsorted_fifo_open_list.hxx>
 
 namespace fs0 { class GroundStateModel; class Config; }
 
@@ -3,12 +3,13 @@
 #include <problem.hxx>
 #include <problem_info.hxx>
 #include <state.hxx>
-#include <aptk2/search/algorithms/best_first_search.hxx>
+#include <search/algorithms/best_first_search.hxx>
 #include <actions/ground_action_iterator.hxx>
 #include <actions/grounding.hxx>
 #include <constraints/direct/direct_rpg_builder.hxx>
 #include <constraints/direct/action_manager.hxx>
 #include <heuristics/relaxed_plan/direct_crpg.hxx>
+#include <heuristics/relaxed_plan/propositional_rpg.hxx>
 #include <languages/fstrips/formulae.hxx>
 
 
@@ -25,10 +26,18 @@ NativeDriver::create(const Config& config, const GroundStateModel& model) const
 		throw std::runtime_error("The Native Driver cannot process the given problem");
 	}
 	
+	if (config.getOption<bool>("engine.propositional_rpg", true) && PropositionalRPG::is_supported(problem)) {
+		LPT_INFO("main", "Using the propositional RPG");
+		PropositionalRPG heuristic(problem, PropositionalRPG::Type::HFF, config.getOption<bool>("engine.incremental_rpg", false));
+		return std::unique_ptr<FS0SearchAlgorithm>(new FS0BestFirstSearch<SearchNode, PropositionalRPG, GroundStateModel>(model, std::move(heuristic), delayed));
+	}
+	
+	if (config.getOption<bool>("engine.incremental_rpg", false)) throw std::runtime_error("The incremental RPG is only available for problems supported by the propositional RPG");
+	
 	auto direct_builder = DirectRPGBuilder::create(problem.getGoalConditions(), problem.getStateConstraints());
 	DirectCRPG heuristic(problem, DirectActionManager::create(actions), std::move(direct_builder));
 	
-	return std::unique_ptr<FS0SearchAlgorithm>(new aptk::StlBestFirstSearch<SearchNode, DirectCRPG, GroundStateModel>(model, std::move(heuristic), delayed));
+	return std::unique_ptr<FS0SearchAlgorithm>(new FS0BestFirstSearch<SearchNode, DirectCRPG, GroundStateModel>(model, std::move(heuristic), delayed));
 }
 
 GroundStateModel
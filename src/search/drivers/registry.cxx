@@ -3,8 +3,10 @@
 #include <search/drivers/registry.hxx>
 #include <search/drivers/gbfs_constrained.hxx>
 #include <search/drivers/iterated_width.hxx>
+#include <search/drivers/serialized_iterated_width.hxx>
 #include <search/drivers/breadth_first_search.hxx>
 #include <search/drivers/gbfs_novelty.hxx>
+#include <search/drivers/bfws.hxx>
 // #include <search/drivers/asp_engine.hxx>
 #include <search/drivers/unreached_atom_driver.hxx>
 #include <search/drivers/smart_effect_driver.hxx>
@@ -40,7 +42,9 @@ EngineRegistry::EngineRegistry() {
 	add("smart",  new SmartEffectDriver());
 	
 	add("iw",  new IteratedWidthDriver());
+	add("siw",  new SerializedIteratedWidthDriver());
 	add("novelty_best_first",  new GBFSNoveltyDriver());
+	add("bfws",  new BFWSDriver());
 	add("breadth_first_search",  new BreadthFirstSearchDriver());
 // 	add("asp_engine",  new ASPEngine());
 }
@@ -0,0 +1,43 @@
+
+#include <search/drivers/serialized_iterated_width.hxx>
+#include <search/drivers/native_driver.hxx>
+#include <search/algorithms/serialized_iterated_width.hxx>
+#include <heuristics/relaxed_plan/direct_crpg.hxx>
+#include <heuristics/heuristic_cache.hxx>
+#include <constraints/direct/direct_rpg_builder.hxx>
+#include <constraints/direct/action_manager.hxx>
+#include <actions/ground_action_iterator.hxx>
+#include <problem.hxx>
+#include <utils/config.hxx>
+
+namespace fs0 { namespace drivers {
+
+std::unique_ptr<FS0SearchAlgorithm> SerializedIteratedWidthDriver::create(const Config& config, const GroundStateModel& model) const {
+	const Problem& problem = model.getTask();
+	unsigned max_novelty = config.getOption<int>("engine.max_novelty");
+	NoveltyFeaturesConfiguration feature_configuration(config);
+	
+	// The reachability test of the subgoal states is performed on the native RPG, whenever the problem allows it
+	std::unique_ptr<DirectCRPG> reachability;
+	if (config.getOption<bool>("engine.siw_reachability", true) && NativeDriver::check_supported(problem)) {
+		auto builder = DirectRPGBuilder::create(problem.getGoalConditions(), problem.getStateConstraints());
+		reachability = std::unique_ptr<DirectCRPG>(new DirectCHMax(problem, DirectActionManager::create(problem.getGroundActions()), std::move(builder)));
+	}
+	
+	LPT_INFO("main", "Heuristic options:");
+	LPT_INFO("main", "\tMax novelty: " << max_novelty);
+	LPT_INFO("main", "\tFeature extraction: " << feature_configuration);
+	LPT_INFO("main", "\tReachability test: " << (reachability ? "yes" : "no"));
+	
+	std::size_t cache_memory = std::size_t(config.getOption<int>("engine.iw_cache_memory", 256)) << 20;
+	LPT_INFO("main", "\tSuccessor cache: " << (cache_memory >> 20) << " MB");
+	
+	// The same subgoal states are tested for reachability by the IW searches of increasing width
+	std::unique_ptr<HeuristicCache> reachability_cache = reachability ? HeuristicCache::create(config) : nullptr;
+	LPT_INFO("main", "\tReachability cache: " << (reachability_cache ? HeuristicCache::configured_memory(config) >> 20 : 0) << " MB");
+	
+	FS0SearchAlgorithm* engine = new FS0SIWAlgorithm(model, max_novelty, feature_configuration, std::move(reachability), cache_memory, std::move(reachability_cache));
+	return std::unique_ptr<FS0SearchAlgorithm>(engine);
+}
+
+} } // namespaces
@@ -0,0 +1,16 @@
+
+#pragma once
+
+#include <search/drivers/registry.hxx>
+
+namespace fs0 { class GroundStateModel; class Config; }
+
+namespace fs0 { namespace drivers {
+
+//! A creator for the Serialized Iterated Width, SIW(k), engine
+class SerializedIteratedWidthDriver : public Driver {
+public:
+	std::unique_ptr<FS0SearchAlgorithm> create(const Config& config, const GroundStateModel& model) const;
+};
+
+} } // namespaces
@@ -3,11 +3,13 @@
 #include <problem.hxx>
 #include <problem_info.hxx>
 #include <state.hxx>
-#include <aptk2/search/algorithms/best_first_search.hxx>
+#include <search/algorithms/best_first_search.hxx>
 #include <constraints/gecode/handlers/lifted_effect_csp.hxx>
 #include <actions/ground_action_iterator.hxx>
 #include <actions/grounding.hxx>
 #include <heuristics/relaxed_plan/smart_rpg.hxx>
+#include <heuristics/relaxed_plan/smart_cost_rpg.hxx>
+#include <heuristics/relaxed_plan/propositional_rpg.hxx>
 #include <utils/support.hxx>
 
 using namespace fs0::gecode;
@@ -22,6 +24,14 @@ SmartEffectDriver::create(const Config& config, const GroundStateModel& model) c
 	bool approximate = config.useApproximateActionResolution();
 	bool delayed = config.useDelayedEvaluation();
 	
+	if (config.getOption<bool>("engine.propositional_rpg", true) && PropositionalRPG::is_supported(problem)) {
+		LPT_INFO("main", "Using the propositional RPG");
+		PropositionalRPG heuristic(problem, PropositionalRPG::parse_type(config.getHeuristic()), config.getOption<bool>("engine.incremental_rpg", false));
+		return std::unique_ptr<FS0SearchAlgorithm>(new FS0BestFirstSearch<SearchNode, PropositionalRPG, GroundStateModel>(model, std::move(heuristic), delayed));
+	}
+	
+	if (config.getOption<bool>("engine.incremental_rpg", false)) throw std::runtime_error("The incremental RPG is only available for problems supported by the propositional RPG");
+	
 	const auto& tuple_index = problem.get_tuple_index();
 	const std::vector<const PartiallyGroundedAction*>& actions = problem.getPartiallyGroundedActions();
 	auto managers = LiftedEffectCSP::create_smart(actions, tuple_index, approximate, novelty);
@@ -29,16 +39,25 @@ SmartEffectDriver::create(const Config& config, const GroundStateModel& model) c
 	const auto managed = support::compute_managed_symbols(std::vector<const ActionBase*>(actions.begin(), actions.end()), problem.getGoalConditions(), problem.getStateConstraints());
 	ExtensionHandler extension_handler(problem.get_tuple_index(), managed);
 	
+	// h_max and h_add are computed by propagating costs rather than layer by layer
+	if (config.getHeuristic() != "hff") {
+		LPT_INFO("main", "Using the cost-propagating RPG");
+		SmartCostRPG heuristic(problem, problem.getGoalConditions(), problem.getStateConstraints(), std::move(managers), extension_handler, SmartCostRPG::parse_type(config.getHeuristic()));
+		return std::unique_ptr<FS0SearchAlgorithm>(new FS0BestFirstSearch<SearchNode, SmartCostRPG, GroundStateModel>(model, std::move(heuristic), delayed));
+	}
+	
 	SmartRPG heuristic(problem, problem.getGoalConditions(), problem.getStateConstraints(), std::move(managers), extension_handler);
 	
-	return std::unique_ptr<FS0SearchAlgorithm>(new aptk::StlBestFirstSearch<SearchNode, SmartRPG, GroundStateModel>(model, std::move(heuristic), delayed));
+	return std::unique_ptr<FS0SearchAlgorithm>(new FS0BestFirstSearch<SearchNode, SmartRPG, GroundStateModel>(model, std::move(heuristic), delayed));
 }
 
 GroundStateModel
 SmartEffectDriver::setup(const Config& config, Problem& problem) const {
 	// We'll use all the ground actions for the search plus the partyally ground actions for the heuristic computations
 	problem.setGroundActions(ActionGrounder::fully_ground(problem.getActionData(), ProblemInfo::getInstance()));
-	problem.setPartiallyGroundedActions(ActionGrounder::fully_lifted(problem.getActionData(), ProblemInfo::getInstance()));
+	if (!config.getOption<bool>("engine.propositional_rpg", true) || !PropositionalRPG::is_supported(problem)) {
+		problem.setPartiallyGroundedActions(ActionGrounder::fully_lifted(problem.getActionData(), ProblemInfo::getInstance()));
+	}
 	return GroundStateModel(problem);
 }
 
@@ -1,7 +1,7 @@
 
 #include <search/drivers/smart_lifted_driver.hxx>
 #include <problem.hxx>
-#include <aptk2/search/algorithms/best_first_search.hxx>
+#include <search/algorithms/best_first_search.hxx>
 #include <heuristics/relaxed_plan/smart_rpg.hxx>
 #include <constraints/gecode/handlers/lifted_action_csp.hxx>
 #include <constraints/gecode/handlers/formula_csp.hxx>
@@ -34,7 +34,7 @@ std::unique_ptr<aptk::SearchAlgorithm<LiftedStateModel>> SmartLiftedDriver::crea
 	
 	SmartRPG heuristic(problem, problem.getGoalConditions(), problem.getStateConstraints(), std::move(managers), extension_handler);
 	
-	return std::unique_ptr<LiftedEngine>(new aptk::StlBestFirstSearch<SearchNode, SmartRPG, LiftedStateModel>(model, std::move(heuristic), delayed));
+	return std::unique_ptr<LiftedEngine>(new FS0BestFirstSearch<SearchNode, SmartRPG, LiftedStateModel>(model, std::move(heuristic), delayed));
 }
 
 
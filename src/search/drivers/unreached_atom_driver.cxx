@@ -3,7 +3,7 @@
 #include <problem.hxx>
 #include <problem_info.hxx>
 #include <state.hxx>
-#include <aptk2/search/algorithms/best_first_search.hxx>
+#include <search/algorithms/best_first_search.hxx>
 #include <heuristics/relaxed_plan/unreached_atom_rpg.hxx>
 #include <constraints/gecode/handlers/ground_effect_csp.hxx>
 #include <actions/ground_action_iterator.hxx>
@@ -32,7 +32,7 @@ std::unique_ptr<FS0SearchAlgorithm> UnreachedAtomDriver::create(const Config& co
 									GroundEffectCSP::create(actions, tuple_index, approximate, novelty),
 									extension_handler);
 	
-	return std::unique_ptr<FS0SearchAlgorithm>(new aptk::StlBestFirstSearch<SearchNode, UnreachedAtomRPG, GroundStateModel>(model, std::move(heuristic), delayed));
+	return std::unique_ptr<FS0SearchAlgorithm>(new FS0BestFirstSearch<SearchNode, UnreachedAtomRPG, GroundStateModel>(model, std::move(heuristic), delayed));
 }
 
 GroundStateModel UnreachedAtomDriver::setup(const Config& config, Problem& problem) const {
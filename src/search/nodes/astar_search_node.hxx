@@ -26,55 +26,58 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #pragma once
 
 #include <aptk2/tools/logging.hxx>
+#include <search/algorithms/search_space.hxx>
 
 namespace fs0 { namespace drivers {
 
-template <typename StateT, typename ActionT>
+template <typename ActionT>
 class AStarSearchNode {
 public:
+	typedef typename ActionT::IdType ActionIdT;
+	
 	AStarSearchNode() = delete;
 	virtual ~AStarSearchNode() {}
 	
-	AStarSearchNode(const AStarSearchNode& other) = delete;
-	AStarSearchNode(AStarSearchNode&& other) = delete;
-	AStarSearchNode& operator=(const AStarSearchNode& rhs) = delete;
-	AStarSearchNode& operator=(AStarSearchNode&& rhs) = delete;
+	AStarSearchNode(const AStarSearchNode& other) = default;
+	AStarSearchNode(AStarSearchNode&& other) = default;
+	AStarSearchNode& operator=(const AStarSearchNode& rhs) = default;
+	AStarSearchNode& operator=(AStarSearchNode&& rhs) = default;
 	
 	
-	AStarSearchNode(const StateT& state_)
-		: state(state_), action(ActionT::invalid_action_id), parent(nullptr), g(0), h(0)
+	AStarSearchNode(StateID state_)
+		: state(state_), action(ActionT::invalid_action_id), parent(INVALID_NODE_ID), g(0), h(0)
 	{}
 
-	AStarSearchNode(StateT&& state_, typename ActionT::IdType action_, std::shared_ptr<AStarSearchNode<StateT ,ActionT>> parent_) :
-		state(std::move(state_)), action(action_), parent(parent_), g(parent_->g + 1), h(0)
+	AStarSearchNode(StateID state_, const ActionIdT& action_, NodeID parent_, const AStarSearchNode<ActionT>& parent_node) :
+		state(state_), action(action_), parent(parent_), g(parent_node.g + 1), h(0)
 	{}
 
-	bool has_parent() const { return parent != nullptr; }
+	bool has_parent() const { return parent != INVALID_NODE_ID; }
 
 	//! Print the node into the given stream
-	friend std::ostream& operator<<(std::ostream &os, const AStarSearchNode<StateT, ActionT>& object) { return object.print(os); }
+	friend std::ostream& operator<<(std::ostream &os, const AStarSearchNode<ActionT>& object) { return object.print(os); }
 	std::ostream& print(std::ostream& os) const { 
 		os << "{@ = " << this << ", s = " << state << ", g = " << g << ", h = " << h <<  ", g+h = " << g+h << ", parent = " << parent << ", action: " << action << "}";
 		return os;
 	}
-	
-	//! Forward the comparison and hash function to the search state.
-	bool operator==(const AStarSearchNode<StateT, ActionT>& o) const { return state == o.state; }
-	std::size_t hash() const { return state.hash(); }
 
 	// MRJ: This is part of the required interface of the Heuristic
 	template <typename Heuristic>
-	void evaluate_with(Heuristic& heuristic) {
-		h = heuristic.evaluate(state);
-		LPT_DEBUG("heuristic" , std::endl << "Computed heuristic value of " << h <<  " for seed state: " << std::endl << state << std::endl << "****************************************");
+	void evaluate_with(Heuristic& heuristic, const State& state_) {
+		h = heuristic.evaluate(state_);
+		LPT_DEBUG("heuristic" , std::endl << "Computed heuristic value of " << h <<  " for seed state: " << std::endl << state_ << std::endl << "****************************************");
 	}
 	
-	void inherit_heuristic_estimate() {
-		if (parent) h = parent->h;
+	//! The heuristic is evaluated from scratch, regardless of the parent state
+	template <typename Heuristic>
+	void evaluate_with(Heuristic& heuristic, const State& state_, const State& parent) { evaluate_with(heuristic, state_); }
+	
+	void inherit_heuristic_estimate(const AStarSearchNode<ActionT>& parent_node) {
+		h = parent_node.h;
 	}
 
 	//! This effectively implements A* search with tie-breaking based on h
-	bool operator>(const AStarSearchNode<StateT, ActionT>& other) const {
+	bool operator>(const AStarSearchNode<ActionT>& other) const {
 		long this_f = this->g + this->h, other_f = other.g + other.h;
 		if (this_f > other_f) return true;
 		if (this_f == other_f) return this->h > other.h;
@@ -83,11 +86,11 @@ public:
 
 	bool dead_end() const { return h == -1; }
 
-	StateT state;
+	StateID state;
 	
-	typename ActionT::IdType action;
+	ActionIdT action;
 	
-	std::shared_ptr<AStarSearchNode<StateT, ActionT>> parent;
+	NodeID parent;
 	
 	unsigned g;
 	
@@ -0,0 +1,134 @@
+/*
+FS0 planner
+Copyright (c) 2015
+Guillem Frances <guillem.frances@upf.edu>
+
+
+Lightweight Automated Planning Toolkit
+Copyright (C) 2012
+Miquel Ramirez <miquel.ramirez@rmit.edu.au>
+Nir Lipovetzky <nirlipo@gmail.com>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <aptk2/tools/logging.hxx>
+#include <search/algorithms/search_space.hxx>
+#include <atom.hxx>
+
+namespace fs0 { namespace drivers {
+
+//! A search node for BFWS(f), which besides the novelty and number of unsatisfied goals #g of its state keeps the
+//! relaxed plan whose atoms are counted to compute #r, along with the #g and #r values of its parent node
+template <typename ActionT>
+class BFWSNode {
+public:
+	typedef typename ActionT::IdType ActionIdT;
+	
+	StateID state;
+	ActionIdT action;
+	
+	NodeID parent;
+
+	//! Accummulated cost
+	unsigned g;
+
+	//! Novelty of the state
+	unsigned novelty;
+	
+	//! Number of unsatisfied goal atoms of the state
+	unsigned num_unsat;
+	
+	//! Number of atoms of the relaxed plan that hold in the state
+	unsigned num_achieved;
+	
+	//! The number of unsatisfied goal atoms and of achieved relaxed plan atoms of the parent node
+	unsigned parent_num_unsat;
+	unsigned parent_num_achieved;
+	
+	//! The atoms of the relaxed plan computed on the closest node of the path from the root where the number of
+	//! unsatisfied goals decreased, shared with all the nodes below that one
+	std::shared_ptr<const std::vector<Atom>> relaxed_plan;
+	
+	//! The novelty of nodes whose novelty exceeds the novelty bound, which are pruned
+	static const unsigned DEAD_END = std::numeric_limits<unsigned>::max();
+	
+public:
+	BFWSNode() = delete;
+	~BFWSNode() {}
+	
+	BFWSNode(const BFWSNode& other) = default;
+	BFWSNode(BFWSNode&& other) = default;
+	BFWSNode& operator=(const BFWSNode& rhs) = default;
+	BFWSNode& operator=(BFWSNode&& rhs) = default;
+	
+	BFWSNode(StateID s)
+		: state(s), action(ActionT::invalid_action_id), parent(INVALID_NODE_ID), g(0), novelty(0), num_unsat(0), num_achieved(0),
+		  parent_num_unsat(std::numeric_limits<unsigned>::max()), parent_num_achieved(0), relaxed_plan(nullptr)
+	{}
+
+	BFWSNode(StateID _state, const ActionIdT& _action, NodeID _parent, const BFWSNode<ActionT>& parent_node) :
+		state(_state), action(_action), parent(_parent), g(parent_node.g + 1), novelty(0), num_unsat(0), num_achieved(0),
+		parent_num_unsat(parent_node.num_unsat), parent_num_achieved(parent_node.num_achieved), relaxed_plan(parent_node.relaxed_plan)
+	{}
+
+	bool has_parent() const { return parent != INVALID_NODE_ID; }
+
+	
+	//! Print the node into the given stream
+	friend std::ostream& operator<<(std::ostream &os, const BFWSNode<ActionT>& object) { return object.print(os); }
+	std::ostream& print(std::ostream& os) const { 
+		os << "{@ = " << this << ", s = " << state << ", novelty = " << novelty << ", g = " << g << " unsat = " << num_unsat << ", #r = " << num_achieved << ", parent = " << parent << "}";
+		return os;
+	}
+
+	template <typename Heuristic>
+	void evaluate_with(Heuristic& heuristic, const State& state_) {
+		heuristic.evaluate(*this, state_, nullptr);
+	}
+	
+	//! Evaluates the node incrementally with respect to the state of its parent node
+	template <typename Heuristic>
+	void evaluate_with(Heuristic& heuristic, const State& state_, const State& parent) {
+		heuristic.evaluate(*this, state_, &parent);
+	}
+	
+	//! The relaxed plan of the parent has already been inherited when the node was created
+	void inherit_heuristic_estimate(const BFWSNode<ActionT>& parent_node) {
+		novelty = parent_node.novelty;
+		num_unsat = parent_node.num_unsat;
+		num_achieved = parent_node.num_achieved;
+	}
+
+	bool dead_end() const { return novelty == DEAD_END; }
+
+	//! The ordering of the nodes prioritizes:
+	//! (1) nodes with lower novelty, (2) nodes with lower number of unsatisfied goals, (3) nodes with lower accumulated cost
+	bool operator>( const BFWSNode<ActionT>& other ) const {
+		if ( novelty > other.novelty ) return true;
+		if ( novelty < other.novelty ) return false;
+		if (num_unsat > other.num_unsat) return true;
+		if (num_unsat < other.num_unsat) return false;
+		return g > other.g;
+	}
+};
+
+
+} }  // namespaces
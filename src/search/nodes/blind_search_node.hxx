@@ -26,50 +26,44 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #pragma once
 
 #include <aptk2/tools/logging.hxx>
-#include <actions/actions.hxx>
+#include <search/algorithms/search_space.hxx>
 
 namespace fs0 { namespace drivers {
 
-template <typename State>
+template <typename ActionT>
 class BlindSearchNode {
 public:
-	State state; // TODO - Check no extra copies are being performed, or switch to pointers otherwise.
-	fs0::GroundAction::IdType action;
-	std::shared_ptr<BlindSearchNode<State>> parent;
+	typedef typename ActionT::IdType ActionIdT;
+	
+	StateID state;
+	ActionIdT action;
+	NodeID parent;
 
 public:
 	BlindSearchNode() = delete;
 	~BlindSearchNode() {}
 	
-	BlindSearchNode(const BlindSearchNode& other) = delete;
-	BlindSearchNode(BlindSearchNode&& other) = delete;
-	BlindSearchNode& operator=(const BlindSearchNode& rhs) = delete;
-	BlindSearchNode& operator=(BlindSearchNode&& rhs) = delete;
+	BlindSearchNode(const BlindSearchNode& other) = default;
+	BlindSearchNode(BlindSearchNode&& other) = default;
+	BlindSearchNode& operator=(const BlindSearchNode& rhs) = default;
+	BlindSearchNode& operator=(BlindSearchNode&& rhs) = default;
 	
-	//! Constructor with full copying of the state (expensive)
-	BlindSearchNode( const State& s )
-		: state( s ), action( fs0::GroundAction::invalid_action_id ), parent( nullptr )
+	BlindSearchNode(StateID _state)
+		: state(_state), action(ActionT::invalid_action_id), parent(INVALID_NODE_ID)
 	{}
 
-	//! Constructor with move of the state (cheaper)
-	BlindSearchNode( State&& _state, fs0::GroundAction::IdType _action, std::shared_ptr< BlindSearchNode<State> > _parent ) :
-		state(std::move(_state)) {
-		action = _action;
-		parent = _parent;
-	}
+	BlindSearchNode(StateID _state, const ActionIdT& _action, NodeID _parent, const BlindSearchNode<ActionT>& parent_node) :
+		state(_state), action(_action), parent(_parent)
+	{}
 
-	bool has_parent() const { return parent != nullptr; }
+	bool has_parent() const { return parent != INVALID_NODE_ID; }
 
 		//! Print the node into the given stream
-	friend std::ostream& operator<<(std::ostream &os, const BlindSearchNode<State>& object) { return object.print(os); }
+	friend std::ostream& operator<<(std::ostream &os, const BlindSearchNode<ActionT>& object) { return object.print(os); }
 	std::ostream& print(std::ostream& os) const { 
 		os << "{@ = " << this << ", s = " << state << ", parent = " << parent << "}";
 		return os;
 	}
-
-	bool operator==( const BlindSearchNode<State>& o ) const { return state == o.state; }
-
-	std::size_t hash() const { return state.hash(); }
 };
 
 } }  // namespaces
@@ -26,18 +26,20 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #pragma once
 
 #include <aptk2/tools/logging.hxx>
-#include <actions/actions.hxx>
+#include <search/algorithms/search_space.hxx>
 
 namespace fs0 { namespace drivers {
 
 
-template <typename State>
+template <typename ActionT>
 class GBFSNoveltyNode {
 public:
-	State state;
-	GroundAction::IdType action;
+	typedef typename ActionT::IdType ActionIdT;
 	
-	std::shared_ptr<GBFSNoveltyNode<State> > parent;
+	StateID state;
+	ActionIdT action;
+	
+	NodeID parent;
 
 	//! Accummulated cost
 	unsigned g;
@@ -48,62 +50,72 @@ public:
 	//! Number of unsatisfied goal atoms of the state
 	unsigned num_unsat;
 	
+	//! The bucket by which the novelty partition of the state is refined, if any
+	unsigned bucket;
+	
+	//! The number of unsatisfied goals and the refining bucket of the parent node, i.e. the partition in which it was evaluated
+	unsigned parent_num_unsat;
+	unsigned parent_bucket;
+	
+	//! The novelty of nodes whose novelty exceeds the novelty bound, which are pruned
+	static const unsigned DEAD_END = std::numeric_limits<unsigned>::max();
+	
 public:
 	GBFSNoveltyNode() = delete;
 	~GBFSNoveltyNode() {}
 	
-	GBFSNoveltyNode(const GBFSNoveltyNode& other) = delete;
-	GBFSNoveltyNode(GBFSNoveltyNode&& other) = delete;
-	GBFSNoveltyNode& operator=(const GBFSNoveltyNode& rhs) = delete;
-	GBFSNoveltyNode& operator=(GBFSNoveltyNode&& rhs) = delete;
+	GBFSNoveltyNode(const GBFSNoveltyNode& other) = default;
+	GBFSNoveltyNode(GBFSNoveltyNode&& other) = default;
+	GBFSNoveltyNode& operator=(const GBFSNoveltyNode& rhs) = default;
+	GBFSNoveltyNode& operator=(GBFSNoveltyNode&& rhs) = default;
 	
-	//! Constructor with full copying of the state (expensive)
-	GBFSNoveltyNode(const State& s)
-		: state(s), action(GroundAction::invalid_action_id), parent(nullptr), g(0), novelty(0), num_unsat(0)
+	GBFSNoveltyNode(StateID s)
+		: state(s), action(ActionT::invalid_action_id), parent(INVALID_NODE_ID), g(0), novelty(0), num_unsat(0), bucket(0),
+		  parent_num_unsat(0), parent_bucket(0)
 	{}
 
-	//! Constructor with move of the state (cheaper)
-	GBFSNoveltyNode(State&& _state, GroundAction::IdType _action, std::shared_ptr< GBFSNoveltyNode<State> > _parent) :
-		state(std::move(_state)), action(_action), parent(_parent), g(_parent->g + 1), novelty(0), num_unsat(0)
+	GBFSNoveltyNode(StateID _state, const ActionIdT& _action, NodeID _parent, const GBFSNoveltyNode<ActionT>& parent_node) :
+		state(_state), action(_action), parent(_parent), g(parent_node.g + 1), novelty(0), num_unsat(0), bucket(0),
+		parent_num_unsat(parent_node.num_unsat), parent_bucket(parent_node.bucket)
 	{}
 
-	bool has_parent() const { return parent != nullptr; }
+	bool has_parent() const { return parent != INVALID_NODE_ID; }
 
 	
 	//! Print the node into the given stream
-	friend std::ostream& operator<<(std::ostream &os, const GBFSNoveltyNode<State>& object) { return object.print(os); }
+	friend std::ostream& operator<<(std::ostream &os, const GBFSNoveltyNode<ActionT>& object) { return object.print(os); }
 	std::ostream& print(std::ostream& os) const { 
 		os << "{@ = " << this << ", s = " << state << ", novelty = " << novelty << ", g = " << g << " unsat = " << num_unsat << ", parent = " << parent << "}";
 		return os;
 	}
 
-	bool operator==( const GBFSNoveltyNode<State>& o ) const { return state == o.state; }
-
 	template <typename Heuristic>
-	void evaluate_with( Heuristic& heuristic ) {
-		novelty = heuristic.novelty( state );
-		if (novelty > heuristic.novelty_bound()) novelty = std::numeric_limits<unsigned>::infinity();
-		num_unsat = heuristic.evaluate_num_unsat_goals( state );
+	void evaluate_with(Heuristic& heuristic, const State& state_) {
+		heuristic.evaluate(*this, state_, nullptr);
 	}
 	
-	void inherit_heuristic_estimate() {
-		if (parent) {
-			novelty = parent->novelty;
-			num_unsat = parent->num_unsat;
-		}
+	//! Evaluates the node incrementally with respect to the state of its parent node
+	template <typename Heuristic>
+	void evaluate_with(Heuristic& heuristic, const State& state_, const State& parent) {
+		heuristic.evaluate(*this, state_, &parent);
+	}
+	
+	//! The partition of the parent has already been inherited when the node was created
+	void inherit_heuristic_estimate(const GBFSNoveltyNode<ActionT>& parent_node) {
+		novelty = parent_node.novelty;
+		num_unsat = parent_node.num_unsat;
+		bucket = parent_node.bucket;
 	}
 
-	bool dead_end() const { return novelty == std::numeric_limits<unsigned>::infinity(); }
-
-	std::size_t hash() const { return state.hash(); }
+	bool dead_end() const { return novelty == DEAD_END; }
 
 	//! The ordering of the nodes prioritizes:
 	//! (1) nodes with lower novelty, (2) nodes with lower number of unsatisfied goals, (3) nodes with lower accumulated cost
-	bool operator>( const GBFSNoveltyNode<State>& other ) const {
+	bool operator>( const GBFSNoveltyNode<ActionT>& other ) const {
 		if ( novelty > other.novelty ) return true;
 		if ( novelty < other.novelty ) return false;
 		if (num_unsat > other.num_unsat) return true;
-		if (num_unsat < other.num_unsat) return true;
+		if (num_unsat < other.num_unsat) return false;
 		return g > other.g;
 	}
 };
@@ -9,6 +9,8 @@
 #include <search/drivers/registry.hxx>
 #include <search/drivers/fully_lifted_driver.hxx>
 #include <search/drivers/smart_lifted_driver.hxx>
+#include <search/benchmarks.hxx>
+#include <search/statistics.hxx>
 #include <actions/checker.hxx>
 #include <utils/printers/printers.hxx>
 #include <languages/fstrips/language.hxx>
@@ -52,6 +54,9 @@ void SearchUtils::do_search(SearchAlgorithmT& engine, const StateModelT& model,
 	json_out << "\t\"generated\": " << engine.generated << "," << std::endl;
 	json_out << "\t\"expanded\": " << engine.expanded << "," << std::endl;
 	json_out << "\t\"eval_per_second\": " << eval_speed << "," << std::endl;
+	for (const auto& entry:SearchStatistics::instance().collect()) {
+		json_out << "\t\"" << entry.first << "\": " << entry.second << "," << std::endl;
+	}
 	json_out << "\t\"solved\": " << ( solved ? "true" : "false" ) << "," << std::endl;
 	json_out << "\t\"valid\": " << ( valid ? "true" : "false" ) << "," << std::endl;
 	json_out << "\t\"plan_length\": " << plan.size() << "," << std::endl;
@@ -75,6 +80,12 @@ void SearchUtils::do_search(SearchAlgorithmT& engine, const StateModelT& model,
 }
 
 void SearchUtils::instantiate_seach_engine_and_run(Problem& problem, const Config& config, const std::string& driver_tag, const std::string& out_dir, float start_time) {
+	if (driver_tag == "benchmark") {
+		std::cout << "Running benchmarks..." << std::endl;
+		Benchmarks::run(problem, config, out_dir);
+		return;
+	}
+	
 	std::cout << "Starting search..." << std::endl;
 	
 	// The engine and search model for lifted planning are different!
@@ -110,10 +121,6 @@ void SearchUtils::report_stats(const Problem& problem) {
 	std::cout << "Number of action schemata: " << problem.getActionData().size() << std::endl;
 	std::cout << "Number of (perhaps partially) ground actions: " << n_actions << std::endl;
 	
-	if (n_actions > 1000) {
-		std::cout << "WARNING: The number of ground actions (" << n_actions << ") is too high for our applicable action strategy to perform well." << std::endl;
-	}
-
 	std::cout << "Number of state constraints: " << problem.getStateConstraints()->all_atoms().size() << std::endl;
 	std::cout << "Number of goal conditions: " << problem.getGoalConditions()->all_atoms().size() << std::endl;
 }
@@ -0,0 +1,58 @@
+
+#include <algorithm>
+
+#include <search/state_registry.hxx>
+#include <state_layout.hxx>
+
+
+namespace fs0 { namespace drivers {
+
+StateRegistry::StateRegistry() :
+	_num_words(StateLayout::getInstance().getNumWords()),
+	_arena(),
+	_hashes(),
+	_index(0, StateIDHash{this}, StateIDEqual{this}),
+	_candidate(nullptr)
+{}
+
+std::pair<StateID, bool> StateRegistry::insert(const State& state) {
+	assert(state.getData().size() == _num_words);
+	_candidate = &state;
+	auto it = _index.find(INVALID_STATE_ID);
+	_candidate = nullptr;
+	if (it != _index.end()) return std::make_pair(*it, false);
+	
+	if (_hashes.size() == INVALID_STATE_ID) throw std::runtime_error("StateRegistry: Maximum number of states exceeded");
+	StateID id = _hashes.size();
+	_arena.insert(_arena.end(), state.getData().begin(), state.getData().end());
+	_hashes.push_back(state.hash());
+	_index.insert(id);
+	return std::make_pair(id, true);
+}
+
+StateID StateRegistry::find(const State& state) const {
+	assert(state.getData().size() == _num_words);
+	_candidate = &state;
+	auto it = _index.find(INVALID_STATE_ID);
+	_candidate = nullptr;
+	return (it != _index.end()) ? *it : INVALID_STATE_ID;
+}
+
+State StateRegistry::lookup(StateID id) const {
+	assert(id < size());
+	const Word* begin = data(id);
+	return State(std::vector<Word>(begin, begin + _num_words), _hashes[id]);
+}
+
+bool StateRegistry::equal(StateID lhs, StateID rhs) const {
+	if (hash(lhs) != hash(rhs)) return false;
+	const Word* lhs_data = data(lhs);
+	return std::equal(lhs_data, lhs_data + _num_words, data(rhs));
+}
+
+std::size_t StateRegistry::memory() const {
+	// We approximate the size of the hash set assuming one pointer-sized bucket plus one three-word node per element
+	return _arena.capacity() * sizeof(Word) + _hashes.capacity() * sizeof(std::size_t) + _index.bucket_count() * sizeof(void*) + _index.size() * 3 * sizeof(void*);
+}
+
+} } // namespaces
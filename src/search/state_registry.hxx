@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_set>
+
+#include <fs_types.hxx>
+#include <state.hxx>
+
+namespace fs0 { namespace drivers {
+
+//! The compact identifier of a state stored in a StateRegistry
+typedef uint32_t StateID;
+const StateID INVALID_STATE_ID = std::numeric_limits<uint32_t>::max();
+
+//! A StateRegistry stores each distinct state that is registered on it exactly once, in a single contiguous memory arena,
+//! and hands out for each of them a compact StateID, which is simply the order in which the state was first registered.
+//! States are deduplicated by (Zobrist) hash and full memory comparison, without ever being stored as State objects.
+class StateRegistry {
+protected:
+	typedef State::Word Word;
+	
+	//! Hash and equality functors over the IDs of the registered states. The special ID INVALID_STATE_ID refers to the
+	//! state that is currently being registered, which allows us to look it up without first copying it into the arena.
+	struct StateIDHash {
+		const StateRegistry* registry;
+		std::size_t operator()(StateID id) const { return registry->hash(id); }
+	};
+	
+	struct StateIDEqual {
+		const StateRegistry* registry;
+		bool operator()(StateID lhs, StateID rhs) const { return registry->equal(lhs, rhs); }
+	};
+	
+	//! The number of words taken by each state
+	const unsigned _num_words;
+	
+	//! The memory of all registered states: the state with ID 'i' takes positions [i*_num_words, (i+1)*_num_words)
+	std::vector<Word> _arena;
+	
+	//! '_hashes[i]' is the hash of the state with ID 'i'
+	std::vector<std::size_t> _hashes;
+	
+	//! The set of all registered IDs, used for deduplication
+	std::unordered_set<StateID, StateIDHash, StateIDEqual> _index;
+	
+	//! The state currently being registered or looked up, if any
+	mutable const State* _candidate;
+	
+public:
+	StateRegistry();
+	~StateRegistry() = default;
+	
+	//! The hash and equality functors keep a pointer to the registry, hence the registry cannot be copied nor moved
+	StateRegistry(const StateRegistry&) = delete;
+	StateRegistry(StateRegistry&&) = delete;
+	StateRegistry& operator=(const StateRegistry&) = delete;
+	StateRegistry& operator=(StateRegistry&&) = delete;
+	
+	//! Registers the given state, returning its ID plus a flag telling whether the state had not been registered before
+	std::pair<StateID, bool> insert(const State& state);
+	
+	//! Returns the ID of the given state, or INVALID_STATE_ID if it has not been registered
+	StateID find(const State& state) const;
+	
+	//! Returns a newly-created copy of the state with the given ID
+	State lookup(StateID id) const;
+	
+	//! The number of registered states
+	unsigned size() const { return _hashes.size(); }
+	
+	//! An estimate of the memory taken by the registry, in bytes
+	std::size_t memory() const;
+	
+protected:
+	std::size_t hash(StateID id) const { return (id == INVALID_STATE_ID) ? _candidate->hash() : _hashes[id]; }
+	
+	const Word* data(StateID id) const { return (id == INVALID_STATE_ID) ? _candidate->getData().data() : _arena.data() + id * _num_words; }
+	
+	bool equal(StateID lhs, StateID rhs) const;
+};
+
+} } // namespaces
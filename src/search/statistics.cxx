@@ -0,0 +1,28 @@
+
+#include <algorithm>
+
+#include <search/statistics.hxx>
+
+namespace fs0 { namespace drivers {
+
+SearchStatistics& SearchStatistics::instance() {
+	static SearchStatistics theInstance;
+	return theInstance;
+}
+
+unsigned SearchStatistics::add(Reporter&& reporter) {
+	_reporters.push_back(std::make_pair(_next_id, std::move(reporter)));
+	return _next_id++;
+}
+
+void SearchStatistics::remove(unsigned id) {
+	_reporters.erase(std::remove_if(_reporters.begin(), _reporters.end(), [id](const std::pair<unsigned, Reporter>& entry) { return entry.first == id; }), _reporters.end());
+}
+
+SearchStatistics::Entries SearchStatistics::collect() const {
+	Entries entries;
+	for (const auto& entry:_reporters) entry.second(entries);
+	return entries;
+}
+
+} } // namespaces
@@ -0,0 +1,41 @@
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fs0 { namespace drivers {
+
+//! A (singleton) registry of the statistics gathered by search components other than the search engine itself, e.g. caches,
+//! which are reported along with the engine statistics in the results of the search. Each component registers a reporter,
+//! which is only invoked when the statistics are collected, and must unregister it before being destroyed.
+//! The values of the entries are already formatted by the reporters, so that e.g. large counters are printed in full.
+class SearchStatistics {
+public:
+	typedef std::vector<std::pair<std::string, std::string>> Entries;
+	typedef std::function<void(Entries&)> Reporter;
+
+	static SearchStatistics& instance();
+
+	SearchStatistics(const SearchStatistics&) = delete;
+	SearchStatistics& operator=(const SearchStatistics&) = delete;
+
+	//! Registers the given reporter, returning an identifier that can be used to unregister it
+	unsigned add(Reporter&& reporter);
+
+	void remove(unsigned id);
+
+	//! Returns the entries of all registered reporters, in order of registration
+	Entries collect() const;
+
+protected:
+	SearchStatistics() : _reporters(), _next_id(0) {}
+
+	std::vector<std::pair<unsigned, Reporter>> _reporters;
+
+	unsigned _next_id;
+};
+
+} } // namespaces
@@ -1,6 +1,4 @@
 
-#include <boost/functional/hash.hpp>
-
 #include <state.hxx>
 #include <problem_info.hxx>
 #include <atom.hxx>
@@ -9,11 +7,18 @@
 namespace fs0 {
 
 State::State(unsigned numAtoms, const std::vector<Atom>& facts) :
-	_values(numAtoms)
+	_data(StateLayout::getInstance().getNumWords(), 0)
 {
+	const StateLayout& layout = StateLayout::getInstance();
+	assert(numAtoms == layout.getNumVariables());
+	
 	// Note that those facts not explicitly set in the initial state will be initialized to 0, i.e. "false", which is convenient to us.
+	// (In the packed representation, a zeroed memory does not necessarily correspond to all variables being 0)
+	for (VariableIdx variable = 0; variable < numAtoms; ++variable) {
+		layout.set(_data, variable, 0);
+	}
 	for (const auto& fact:facts) { // Insert all the elements of the vector
-		set(fact);
+		layout.set(_data, fact.getVariable(), fact.getValue());
 	}
 	updateHash();
 }
@@ -24,15 +29,23 @@ State::State(const State& state, const std::vector<Atom>& atoms) :
 }
 	
 void State::set(const Atom& atom) {
-	_values.at(atom.getVariable()) = atom.getValue();
+	assert(atom.getVariable() < numAtoms());
+	// The Zobrist hash gets updated by XOR-ing out the key of the old atom and XOR-ing in the key of the new one
+	_hash ^= StateLayout::getInstance().update(_data, atom.getVariable(), atom.getValue());
 }
 
 bool State::contains(const Atom& atom) const {
 	return getValue(atom.getVariable()) == atom.getValue();
 }
 
-ObjectIdx State::getValue(const VariableIdx& variable) const {
-	return _values.at(variable);
+std::vector<ObjectIdx> State::getValues() const {
+	const StateLayout& layout = StateLayout::getInstance();
+	std::vector<ObjectIdx> values;
+	values.reserve(layout.getNumVariables());
+	for (VariableIdx variable = 0; variable < layout.getNumVariables(); ++variable) {
+		values.push_back(layout.get(_data, variable));
+	}
+	return values;
 }
 
 //! Applies the given changeset into the current state.
@@ -40,28 +53,28 @@ void State::accumulate(const std::vector<Atom>& atoms) {
 	for (const Atom& fact:atoms) { 
 		set(fact);
 	}
-	updateHash(); // Important to update the hash value after all the changes have been applied!
+	assert(_hash == computeHash()); // The hash value is incrementally updated by 'set'
 }
 
 std::ostream& State::print(std::ostream& os) const {
 	const ProblemInfo& info = ProblemInfo::getInstance();
 	os << "State";
 	os << "(" << _hash << ")[";
-	for (unsigned i = 0; i < _values.size(); ++i) {
+	for (unsigned i = 0; i < numAtoms(); ++i) {
 		if (info.getVariableGenericType(i) == ProblemInfo::ObjectType::BOOL) {
-			if (_values.at(i) == 0) continue;
+			if (getValue(i) == 0) continue;
 			
 			// Print only those atoms which are true in the state
 			os << info.getVariableName(i);
 		} else {
-			os << info.getVariableName(i) << "=" << info.getObjectName(i, _values.at(i));
+			os << info.getVariableName(i) << "=" << info.getObjectName(i, getValue(i));
 		}
-		if (i < _values.size() - 1) os << ", ";
+		if (i < numAtoms() - 1) os << ", ";
 	}
 	os << "]";
 	return os;
 }
 
-std::size_t State::computeHash() const { return boost::hash_range(_values.begin(), _values.end()); }
+std::size_t State::computeHash() const { return StateLayout::getInstance().hash(_data); }
 
 } // namespaces
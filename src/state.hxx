@@ -2,6 +2,7 @@
 #pragma once
 
 #include <fs_types.hxx>
+#include <state_layout.hxx>
 
 namespace fs0 {
 
@@ -9,9 +10,13 @@ class Problem;
 class Atom;
 
 class State {
+public:
+	typedef StateLayout::Word Word;
+	
 protected:
-	//! A vector mapping state variable (implicit) ids to their value in the current state.
-	std::vector<ObjectIdx> _values;
+	//! The memory holding the values of all state variables in the current state, laid out according to the global StateLayout.
+	//! Depending on the layout, this will be either one word per state variable, or a packed representation of all values.
+	std::vector<Word> _data;
 
 	std::size_t _hash;
 
@@ -30,6 +35,9 @@ public:
 	//! state plus the new atoms. Note that we do not check that there are no contradictory atoms.
 	State(const State& state, const std::vector<Atom>& atoms);
 	
+	//! Constructs a state directly from its raw memory and its (already computed) hash, e.g. when retrieving it from some storage
+	State(std::vector<Word>&& data, std::size_t hash) : _data(std::move(data)), _hash(hash) {}
+	
 	//! Default copy constructors and assignment operators - if ever need a custom version, check the git history!
 	// https://bitbucket.org/gfrances/fs0/src/28ce4119f27a537d8f7628c6ca0487d03d5ed0b1/src/state.hxx?at=gecode_integration
 	State(const State& state) = default;
@@ -38,27 +46,32 @@ public:
 	State& operator=(State&& state) = default;
 
 	// Check the hash first for performance.
-	bool operator==(const State &rhs) const { return _hash == rhs._hash && _values == rhs._values; }
+	bool operator==(const State &rhs) const { return _hash == rhs._hash && _data == rhs._data; }
 	bool operator!=(const State &rhs) const { return !(this->operator==(rhs));}
 	
 	void set(const Atom& atom);
 	
 	bool contains(const Atom& atom) const;
 	
-	ObjectIdx getValue(const VariableIdx& variable) const;
+	ObjectIdx getValue(const VariableIdx& variable) const { return StateLayout::getInstance().get(_data, variable); }
 	
-	const std::vector<ObjectIdx>& getValues() const { return _values; }
+	//! Returns a (newly-created) vector with the values of all state variables
+	std::vector<ObjectIdx> getValues() const;
 
-	unsigned numAtoms() const { return _values.size(); }
+	unsigned numAtoms() const { return StateLayout::getInstance().getNumVariables(); }
+	
+	//! Returns the raw memory of the state
+	const std::vector<Word>& getData() const { return _data; }
 	
 	//! "Applies" the given atoms into the current state.
 	void accumulate(const std::vector<Atom>& atoms);
 
+	//! Computes from scratch the (Zobrist) hash of the state, i.e. ignoring the incrementally-maintained value
+	std::size_t computeHash() const;
+
 protected:
 	void updateHash() { _hash = computeHash(); }
 	
-	std::size_t computeHash() const;
-	
 public:
 	//! Prints a representation of the state to the given stream.
 	friend std::ostream& operator<<(std::ostream &os, const State&  state) { return state.print(os); }
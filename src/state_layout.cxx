@@ -0,0 +1,162 @@
+
+#include <algorithm>
+#include <random>
+
+#include <state_layout.hxx>
+#include <problem_info.hxx>
+#include <aptk2/tools/logging.hxx>
+
+namespace fs0 {
+
+std::unique_ptr<StateLayout> StateLayout::_instance = nullptr;
+
+//! Returns the minimum number of bits necessary to represent 'size' different codes
+static unsigned required_bits(StateLayout::Word size) {
+	unsigned bits = 0;
+	while (bits < 32 && (static_cast<uint64_t>(1) << bits) < size) ++bits;
+	return bits;
+}
+
+StateLayout::StateLayout(const ProblemInfo& info, bool packed) :
+	_packed(packed), _codecs(), _slots(), _num_words(0), _keys()
+{
+	unsigned num_variables = info.getNumVariables();
+	_slots.reserve(num_variables);
+	
+	if (!_packed) { // A single, unrestricted identity codec, used by all variables
+		_codecs.push_back(ValueCodec{0, std::numeric_limits<Word>::max(), std::numeric_limits<Word>::max(), false, {}, {}});
+	}
+	
+	// Variables of the same type (and predicative-ness) share the same domain
+	std::map<std::pair<TypeIdx, bool>, unsigned> codec_index;
+	std::vector<std::pair<ObjectIdx, ObjectIdx>> domain_bounds; // The min and max values of each domain, indexed as the codecs
+	
+	// We use a fixed seed so that hash values, and thus the search behavior, are deterministic across runs
+	std::mt19937_64 generator(std::mt19937_64::default_seed);
+
+	unsigned current_word = 0, used_bits = 0;
+	for (VariableIdx variable = 0; variable < num_variables; ++variable) {
+		TypeIdx type = info.getVariableType(variable);
+		bool predicative = info.isPredicativeVariable(variable);
+
+		auto key = std::make_pair(type, predicative);
+		auto it = codec_index.find(key);
+		if (it == codec_index.end()) {
+			std::vector<ObjectIdx> domain = compute_domain(info, type, predicative);
+			domain_bounds.push_back(std::make_pair(domain.front(), domain.back()));
+			if (_packed) _codecs.push_back(build_codec(domain));
+			it = codec_index.insert(std::make_pair(key, domain_bounds.size() - 1)).first;
+		}
+		
+		VariableSlot slot;
+		
+		if (_packed) {
+			slot.codec = it->second;
+			unsigned width = required_bits(_codecs[slot.codec].size);
+			if (used_bits + width > 32 || used_bits == 32) { // Variables never straddle two words
+				++current_word;
+				used_bits = 0;
+			}
+			slot.word = current_word;
+			slot.shift = used_bits;
+			slot.mask = (width == 32) ? std::numeric_limits<Word>::max() : ((static_cast<Word>(1) << width) - 1);
+			used_bits += width;
+			
+			// The stored codes are dense, so we need one key per value of the domain
+			slot.num_keys = _codecs[slot.codec].size;
+			
+		} else {
+			slot.codec = 0;
+			slot.word = variable;
+			slot.shift = 0;
+			slot.mask = std::numeric_limits<Word>::max();
+			
+			// The stored codes are the values themselves, which can be used as direct indexes only if not negative
+			const auto& bounds = domain_bounds[it->second];
+			slot.num_keys = (bounds.first >= 0) ? static_cast<Word>(bounds.second) + 1 : 0;
+		}
+		
+		// The keys of the variables that do not fit in the table are computed on the fly rather than tabulated
+		if (slot.num_keys > MAX_TABULATED_KEYS - _keys.size()) slot.num_keys = 0;
+		
+		slot.seed = generator();
+		slot.key_offset = _keys.size();
+		for (unsigned i = 0; i < slot.num_keys; ++i) _keys.push_back(generator());
+		
+		_slots.push_back(slot);
+	}
+	_num_words = _packed ? ((num_variables == 0) ? 0 : current_word + 1) : num_variables;
+
+	if (_packed) {
+		LPT_INFO("main", "Packed state layout: " << num_variables << " state variables packed into " << _num_words << " words of " << sizeof(Word) << " bytes");
+	}
+}
+
+std::vector<ObjectIdx> StateLayout::compute_domain(const ProblemInfo& info, VariableIdx variable) {
+	return compute_domain(info, info.getVariableType(variable), info.isPredicativeVariable(variable));
+}
+
+std::vector<ObjectIdx> StateLayout::compute_domain(const ProblemInfo& info, TypeIdx type, bool predicative) {
+	std::vector<ObjectIdx> domain;
+	
+	if (info.isBoundedType(type)) { // For integer types we consider the whole range, extended to include 0
+		const auto& bounds = info.getTypeBounds(type);
+		for (int v = std::min(bounds.first, 0); v <= std::max(bounds.second, 0); ++v) domain.push_back(v);
+	} else {
+		domain = info.getTypeObjects(type);
+		domain.push_back(0); // Variables not explicitly initialized take value 0
+		if (predicative) domain.push_back(1);
+	}
+	std::sort(domain.begin(), domain.end());
+	domain.erase(std::unique(domain.begin(), domain.end()), domain.end());
+	return domain;
+}
+
+std::size_t StateLayout::hash(const std::vector<Word>& data) const {
+	std::size_t hash = 0;
+	for (VariableIdx variable = 0; variable < _slots.size(); ++variable) {
+		hash ^= key(variable, code(data, variable));
+	}
+	return hash;
+}
+
+StateLayout::ValueCodec StateLayout::build_codec(const std::vector<ObjectIdx>& domain) {
+	assert(!domain.empty() && std::is_sorted(domain.begin(), domain.end()));
+	ObjectIdx min = domain.front(), max = domain.back();
+	Word size = domain.size();
+	Word range = static_cast<Word>(max - min) + 1;
+
+	if (size == range) return ValueCodec{min, size, range, true, {}, {}}; // A contiguous range: a simple offset will do
+
+	std::vector<int> encoding(range, -1);
+	for (unsigned code = 0; code < domain.size(); ++code) {
+		encoding[domain[code] - min] = code;
+	}
+	return ValueCodec{min, size, range, true, encoding, domain};
+}
+
+unsigned StateLayout::getWidth(VariableIdx variable) const {
+	Word mask = _slots.at(variable).mask;
+	unsigned width = 0;
+	while (width < 32 && (mask >> width) & 1) ++width;
+	return width;
+}
+
+void StateLayout::throw_out_of_domain(VariableIdx variable, ObjectIdx value) const {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	throw std::runtime_error("Value " + std::to_string(value) + " does not belong to the domain of state variable " + info.getVariableName(variable));
+}
+
+std::ostream& StateLayout::print(std::ostream& os) const {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	os << "StateLayout(" << (_packed ? "packed" : "unpacked") << ", " << _num_words << " words)[";
+	for (VariableIdx variable = 0; variable < _slots.size(); ++variable) {
+		const VariableSlot& slot = _slots[variable];
+		os << info.getVariableName(variable) << ": " << slot.word << "[" << slot.shift << ":" << slot.shift + getWidth(variable) << ")";
+		if (variable < _slots.size() - 1) os << ", ";
+	}
+	os << "]";
+	return os;
+}
+
+} // namespaces
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <ostream>
+
+#include <fs_types.hxx>
+
+namespace fs0 {
+
+class ProblemInfo;
+
+/**
+ * A StateLayout determines how the values of all state variables are laid out in the memory of a State object.
+ * In the unpacked representation, each state variable takes a whole word, and values are stored as they are.
+ * In the packed representation, the values of each state variable are first mapped into a dense [0..n) range of codes,
+ * where n is the size of the domain of the variable, and each variable is then assigned the minimum number of bits
+ * required to represent its codes. Variables are then packed into words, ensuring that no variable straddles two words.
+ * The layout also holds the tables of Zobrist keys that allow states to update their hash incrementally, in time
+ * proportional to the number of changed atoms rather than to the number of state variables.
+ */
+class StateLayout {
+public:
+	//! The type of the words that make up the memory of a state
+	typedef uint32_t Word;
+
+	//! Set the global singleton layout instance
+	static void setInstance(std::unique_ptr<StateLayout>&& layout) {
+		assert(!_instance);
+		_instance = std::move(layout);
+	}
+
+	//! Global singleton object accessor
+	static const StateLayout& getInstance() {
+		assert(_instance);
+		return *_instance;
+	}
+
+protected:
+	//! A mapping between the values of some domain and their dense codes
+	struct ValueCodec {
+		//! The minimum value of the domain
+		ObjectIdx min;
+
+		//! The number of codes, i.e. the size of the domain
+		Word size;
+
+		//! The length of the [min, max] range of values of the domain, which is larger than 'size' only for non-contiguous domains
+		Word range;
+
+		//! Whether the codec restricts values to the [min, max] range at all
+		bool bounded;
+
+		//! When the domain is not a contiguous range of values, 'encoding[v - min]' contains the code of value 'v', or -1 if
+		//! 'v' does not belong to the domain, and 'decoding[c]' contains the value with code 'c'. Otherwise both are empty.
+		std::vector<int> encoding;
+		std::vector<ObjectIdx> decoding;
+	};
+
+	//! The position of a state variable within the memory of a state, plus the data necessary to compute its Zobrist keys
+	struct VariableSlot {
+		unsigned word;
+		unsigned shift;
+		Word mask;
+		unsigned codec;
+		
+		//! The keys of codes [0..num_keys) are tabulated in '_keys', starting at position 'key_offset'.
+		//! The keys of any other code, and of all codes of the variables whose keys did not fit in the table, are derived from 'seed' on the fly.
+		unsigned key_offset;
+		Word num_keys;
+		uint64_t seed;
+	};
+	
+	//! The maximum number of tabulated Zobrist keys over all state variables (8 MB of keys)
+	static const Word MAX_TABULATED_KEYS = 1 << 20;
+
+	//! The singleton instance
+	static std::unique_ptr<StateLayout> _instance;
+
+	//! Whether the layout is packed or not
+	const bool _packed;
+
+	//! The codecs of the different domains. Variables with the same type share the same codec.
+	std::vector<ValueCodec> _codecs;
+
+	//! '_slots[i]' contains the position of state variable 'i'
+	std::vector<VariableSlot> _slots;
+
+	//! The total number of words required to store a state
+	unsigned _num_words;
+	
+	//! The (random) Zobrist keys of all atoms <variable, code> for all variables with tabulated keys
+	std::vector<uint64_t> _keys;
+
+public:
+	StateLayout(const ProblemInfo& info, bool packed);
+	~StateLayout() = default;
+
+	StateLayout(const StateLayout&) = delete;
+	StateLayout& operator=(const StateLayout&) = delete;
+
+	bool isPacked() const { return _packed; }
+
+	unsigned getNumVariables() const { return _slots.size(); }
+
+	unsigned getNumWords() const { return _num_words; }
+
+	//! Returns the index of the word where the given variable is stored
+	unsigned getWord(VariableIdx variable) const { return _slots[variable].word; }
+
+	//! Returns the value of the given variable in the given memory
+	inline ObjectIdx get(const std::vector<Word>& data, VariableIdx variable) const {
+		const VariableSlot& slot = _slots[variable];
+		return decode(slot, (data[slot.word] >> slot.shift) & slot.mask);
+	}
+
+	//! Returns the code of the given variable as stored in the given memory
+	inline Word code(const std::vector<Word>& data, VariableIdx variable) const {
+		const VariableSlot& slot = _slots[variable];
+		return (data[slot.word] >> slot.shift) & slot.mask;
+	}
+
+	//! Sets the value of the given variable in the given memory. Throws if the value does not belong to the domain of the variable.
+	inline void set(std::vector<Word>& data, VariableIdx variable, ObjectIdx value) const {
+		const VariableSlot& slot = _slots[variable];
+		Word& word = data[slot.word];
+		word = (word & ~(slot.mask << slot.shift)) | (encode(slot, variable, value) << slot.shift);
+	}
+	
+	//! Sets the value of the given variable in the given memory, and returns the value that needs to be XORed
+	//! into the Zobrist hash of the memory to account for the change
+	inline std::size_t update(std::vector<Word>& data, VariableIdx variable, ObjectIdx value) const {
+		const VariableSlot& slot = _slots[variable];
+		Word& word = data[slot.word];
+		Word previous = (word >> slot.shift) & slot.mask;
+		Word current = encode(slot, variable, value);
+		if (previous == current) return 0;
+		word = (word & ~(slot.mask << slot.shift)) | (current << slot.shift);
+		return key(slot, previous) ^ key(slot, current);
+	}
+	
+	//! Returns the Zobrist key of the atom given by the given variable having the given (stored) code
+	inline std::size_t key(VariableIdx variable, Word code) const { return key(_slots[variable], code); }
+	
+	//! Computes from scratch the Zobrist hash of the given memory, i.e. the XOR of the keys of all its atoms
+	std::size_t hash(const std::vector<Word>& data) const;
+	
+	//! The number of Zobrist keys stored in the table, which never exceeds MAX_TABULATED_KEYS
+	std::size_t getNumTabulatedKeys() const { return _keys.size(); }
+
+	//! Returns the code of the given value of the given variable. Throws if the value does not belong to the domain of the variable.
+	Word encode(VariableIdx variable, ObjectIdx value) const { return encode(_slots.at(variable), variable, value); }
+
+	//! Returns the value of the given variable that corresponds to the given code
+	ObjectIdx decode(VariableIdx variable, Word code) const { return decode(_slots.at(variable), code); }
+
+	//! Returns the number of bits used to store the given variable
+	unsigned getWidth(VariableIdx variable) const;
+
+	//! Computes the (sorted) domain of values that the given state variable can take, i.e. those that can be stored in a state
+	static std::vector<ObjectIdx> compute_domain(const ProblemInfo& info, VariableIdx variable);
+
+	//! Prints a representation of the object to the given stream.
+	friend std::ostream& operator<<(std::ostream &os, const StateLayout& o) { return o.print(os); }
+	std::ostream& print(std::ostream& os) const;
+
+protected:
+	inline ObjectIdx decode(const VariableSlot& slot, Word code) const {
+		const ValueCodec& codec = _codecs[slot.codec];
+		return codec.decoding.empty() ? codec.min + static_cast<ObjectIdx>(code) : codec.decoding[code];
+	}
+
+	inline Word encode(const VariableSlot& slot, VariableIdx variable, ObjectIdx value) const {
+		const ValueCodec& codec = _codecs[slot.codec];
+		Word offset = static_cast<Word>(value - codec.min);
+		if (codec.bounded && offset >= codec.range) throw_out_of_domain(variable, value); // Unsigned wrap-around catches values below 'min'
+		if (codec.encoding.empty()) return offset;
+		int code = codec.encoding[offset];
+		if (code < 0) throw_out_of_domain(variable, value);
+		return static_cast<Word>(code);
+	}
+
+	inline std::size_t key(const VariableSlot& slot, Word code) const {
+		return (code < slot.num_keys) ? _keys[slot.key_offset + code] : mix(slot.seed + code);
+	}
+	
+	//! The SplitMix64 finalizer, a cheap bijective mixing function
+	static inline uint64_t mix(uint64_t x) {
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+		return x ^ (x >> 31);
+	}
+
+	[[noreturn]] void throw_out_of_domain(VariableIdx variable, ObjectIdx value) const;
+	
+	//! Computes the (sorted) domain of values that a state variable of the given type can take
+	static std::vector<ObjectIdx> compute_domain(const ProblemInfo& info, TypeIdx type, bool predicative);
+
+	//! Builds the codec corresponding to the given (sorted) domain
+	static ValueCodec build_codec(const std::vector<ObjectIdx>& domain);
+};
+
+} // namespaces
@@ -22,13 +22,15 @@ Config& Config::instance() {
 }
 
 template <typename OptionType>
-OptionType parseOption(const pt::ptree& tree, const std::unordered_map<std::string, std::string>& user_options, const std::string& key, std::map<std::string, OptionType> allowed) {
+OptionType parseOption(const pt::ptree& tree, const std::unordered_map<std::string, std::string>& user_options, const std::string& key, std::map<std::string, OptionType> allowed, const std::string& default_value = "") {
 	
 	std::string parsed;
 	
 	auto it = user_options.find(key);
 	if (it != user_options.end()) { // The user specified an option value, which thus has priority
 		parsed = it->second;
+	} else if (!default_value.empty()) { // Options with a default value need not be present in the configuration file
+		parsed = tree.get<std::string>(key, default_value);
 	} else {
 		parsed = tree.get<std::string>(key);
 	}
@@ -50,6 +52,11 @@ Config::Config(const std::string& root, const std::unordered_map<std::string, st
 void Config::load(const std::string& filename) {
 	pt::json_parser::read_json(filename, _root);
 	
+	// User-specified options override the ones in the configuration file, so that they can also be retrieved through the generic getter
+	for (const auto& option:_user_options) {
+		_root.put(option.first, option.second);
+	}
+	
 	// Parse the type of relaxed plan extraction: propositional or extended
 	_rpg_extraction = parseOption<RPGExtractionType>(_root, _user_options, "plan_extraction", {{"propositional", RPGExtractionType::Propositional}, {"extended", RPGExtractionType::Supported}});
 	
@@ -67,7 +74,9 @@ void Config::load(const std::string& filename) {
 	
 	_delayed = parseOption<bool>(_root, _user_options, "delayed_evaluation", {{"true", true}, {"false", false}});
 	
-	_heuristic = parseOption<std::string>(_root, _user_options, "heuristic", {{"hff", "hff"}, {"hmax", "hmax"}});
+	_heuristic = parseOption<std::string>(_root, _user_options, "heuristic", {{"hff", "hff"}, {"hmax", "hmax"}, {"hadd", "hadd"}});
+	
+	_state_representation = parseOption<StateRepresentation>(_root, _user_options, "state_representation", {{"packed", StateRepresentation::Packed}, {"unpacked", StateRepresentation::Unpacked}}, "packed");
 }
 
 
@@ -78,6 +87,7 @@ std::ostream& Config::print(std::ostream& os) const {
 	os << "Goal CSP Value Selection:\t" << ((_goal_value_selection == ValueSelection::MinHMax) ? "Value with minimum h_max value" : "Minimum value") << std::endl;
 	os << "Action CSP Value Selection:\t" << ((_action_value_selection == ValueSelection::MinHMax) ? "Value with minimum h_max value" : "Minimum value") << std::endl;
 	os << "Support Priority:\t" << ((_support_priority == SupportPriority::MinHMaxSum) ? "Support minimizing the sum of h_max values" : "First support found") << std::endl;
+	os << "State Representation:\t" << ((_state_representation == StateRepresentation::Packed) ? "Packed" : "Unpacked") << std::endl;
 	return os;
 }
 
@@ -23,6 +23,9 @@ public:
 	//! The type of support sets that should be given priority
 	enum class SupportPriority {First, MinHMaxSum};
 	
+	//! The in-memory representation of states
+	enum class StateRepresentation {Unpacked, Packed};
+	
 	//! Explicit initizalition of the singleton
 	static void init(const std::string& root, const std::unordered_map<std::string, std::string>& user_options, const std::string& filename);
 	
@@ -52,6 +55,8 @@ protected:
 	
 	SupportPriority _support_priority;
 	
+	StateRepresentation _state_representation;
+	
 	bool _novelty;
 	
 	bool _delayed;
@@ -83,6 +88,10 @@ public:
 	
 	bool useMinHMaxSumSupportPriority() const { return _support_priority == SupportPriority::MinHMaxSum; }
 	
+	StateRepresentation getStateRepresentation() const { return _state_representation; }
+	
+	bool usePackedStateRepresentation() const { return _state_representation == StateRepresentation::Packed; }
+	
 	bool useNoveltyConstraint() const { return _novelty; }
 	
 	bool useDelayedEvaluation() const { return _delayed; }
@@ -102,6 +111,12 @@ public:
 	T getOption(const std::string& key) const {
 		return _root.get<T>(key);
 	}
+	
+	//! A generic getter with a default value for options not present in the configuration
+	template <typename T>
+	T getOption(const std::string& key, const T& default_value) const {
+		return _root.get<T>(key, default_value);
+	}
 };
 
 } // namespaces
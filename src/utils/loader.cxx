@@ -16,6 +16,7 @@
 #include <utils/config.hxx>
 #include "static.hxx"
 #include <state.hxx>
+#include <state_layout.hxx>
 #include <problem_info.hxx>
 #include <languages/fstrips/formulae.hxx>
 
@@ -27,6 +28,9 @@ namespace fs0 {
 Problem* Loader::loadProblem(const rapidjson::Document& data, asp::LPHandler* lp_handler) {
 	const ProblemInfo& info = ProblemInfo::getInstance();
 	
+	//! The state layout needs to be set before any state is created
+	StateLayout::setInstance(std::unique_ptr<StateLayout>(new StateLayout(info, Config::instance().usePackedStateRepresentation())));
+	
 	LPT_INFO("main", "Loading initial state...");
 	auto init = loadState(data["init"]);
 	
@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+
+#include <actions/batch_applicability.hxx>
+#include <fixtures/action_fixture.hxx>
+
+using namespace fs0;
+
+typedef BatchApplicabilityChecker::Kernel Kernel;
+
+class BatchApplicabilityTest : public test::ActionFixture {};
+
+
+TEST_F(BatchApplicabilityTest, ScalarSupported) {
+	EXPECT_TRUE(BatchApplicabilityChecker::supported(Kernel::SCALAR));
+	EXPECT_TRUE(BatchApplicabilityChecker::supported(BatchApplicabilityChecker::best_kernel()));
+}
+
+TEST_F(BatchApplicabilityTest, EqualsLinearScan) {
+	// Some of the numbers of actions are not a multiple of the number of rows processed at once by the SIMD kernels
+	for (unsigned num_actions : {1, 7, 9, 100, 500}) {
+		auto problem = buildRandomProblem(num_actions);
+		BatchApplicabilityChecker checker(problem->getGroundActions());
+		for (unsigned i = 0; i < 200; ++i) {
+			State state = buildState(randomValues());
+			std::vector<ActionIdx> expected = linearScan(*problem, state);
+			for (Kernel kernel : {Kernel::SCALAR, Kernel::SSE2, Kernel::AVX2}) {
+				if (!BatchApplicabilityChecker::supported(kernel)) continue;
+				EXPECT_EQ(expected, checker.getCandidates(state, kernel)) << "Kernel: " << BatchApplicabilityChecker::kernel_name(kernel);
+			}
+		}
+	}
+}
+
+TEST_F(BatchApplicabilityTest, NoActions) {
+	auto problem = buildProblem({0, 0, 0, 0, 0, 0}, {}, {});
+	BatchApplicabilityChecker checker(problem->getGroundActions());
+	EXPECT_TRUE(checker.getCandidates(problem->getInitialState()).empty());
+}
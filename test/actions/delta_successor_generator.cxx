@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <actions/delta_successor_generator.hxx>
+#include <fixtures/action_fixture.hxx>
+
+using namespace fs0;
+
+class DeltaSuccessorGeneratorTest : public test::ActionFixture {
+protected:
+	//! The state that results from applying the given action to the given state
+	static State successor(const Problem& problem, const State& state, ActionIdx action) {
+		std::vector<Atom> atoms;
+		for (const fs::ActionEffect* effect:problem.getGroundActions()[action]->getEffects()) atoms.push_back(effect->apply(state));
+		return State(state, atoms);
+	}
+};
+
+
+TEST_F(DeltaSuccessorGeneratorTest, RandomStates) {
+	for (unsigned num_actions : {1, 10, 100, 500}) {
+		auto problem = buildRandomProblem(num_actions);
+		DeltaSuccessorGenerator generator(problem->getGroundActions());
+		for (unsigned i = 0; i < 200; ++i) {
+			State state = buildState(randomValues());
+			EXPECT_EQ(linearScan(*problem, state), generator.getCandidates(state));
+		}
+	}
+}
+
+TEST_F(DeltaSuccessorGeneratorTest, RandomWalks) {
+	for (unsigned num_actions : {10, 100, 500}) {
+		auto problem = buildRandomProblem(num_actions);
+		DeltaSuccessorGenerator generator(problem->getGroundActions());
+		State state = problem->getInitialState();
+		std::vector<ActionIdx> applicable = generator.getCandidates(state);
+		EXPECT_EQ(linearScan(*problem, state), applicable);
+		
+		for (unsigned i = 0; i < 500; ++i) {
+			unsigned move = random(10);
+			if (applicable.empty() || move == 0) {
+				// Jump to an unrelated state, so that the changes have to be found by comparing both states
+				state = buildState(randomValues());
+			} else if (move == 1) {
+				// Notify some successor, but then query a sibling of it, as when expanding several children of a node
+				ActionIdx action = applicable[random(applicable.size())];
+				generator.notify_successor(state, action, successor(*problem, state, action));
+				state = successor(*problem, state, applicable[random(applicable.size())]);
+			} else {
+				ActionIdx action = applicable[random(applicable.size())];
+				State child = successor(*problem, state, action);
+				generator.notify_successor(state, action, child);
+				state = child;
+			}
+			applicable = generator.getCandidates(state);
+			EXPECT_EQ(linearScan(*problem, state), applicable);
+		}
+	}
+}
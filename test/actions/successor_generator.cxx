@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+
+#include <actions/successor_generator.hxx>
+#include <fixtures/action_fixture.hxx>
+
+using namespace fs0;
+
+class SuccessorGeneratorTest : public test::ActionFixture {};
+
+
+TEST_F(SuccessorGeneratorTest, ExtractConditions) {
+	std::vector<SuccessorGenerator::Condition> equalities, inequalities;
+	std::unique_ptr<const fs::Formula> formula(conjunction({{0, 1}, {3, 0}}));
+	EXPECT_TRUE(SuccessorGenerator::extract_conditions(formula.get(), equalities, inequalities));
+	EXPECT_EQ(2, equalities.size());
+	EXPECT_TRUE(inequalities.empty());
+	
+	std::vector<const fs::Term*> subterms{new fs::StateVariable(0, nullptr), new fs::StateVariable(1, nullptr)};
+	std::unique_ptr<const fs::Formula> comparison(new fs::Conjunction({new fs::LTAtomicFormula(subterms)}));
+	EXPECT_FALSE(SuccessorGenerator::extract_conditions(comparison.get(), equalities, inequalities));
+}
+
+TEST_F(SuccessorGeneratorTest, EqualsLinearScan) {
+	for (unsigned num_actions : {1, 10, 100, 500}) {
+		auto problem = buildRandomProblem(num_actions);
+		SuccessorGenerator generator(problem->getGroundActions());
+		for (unsigned i = 0; i < 200; ++i) {
+			State state = buildState(randomValues());
+			EXPECT_EQ(linearScan(*problem, state), generator.getCandidates(state));
+		}
+	}
+}
+
+TEST_F(SuccessorGeneratorTest, NoActions) {
+	auto problem = buildProblem({0, 0, 0, 0, 0, 0}, {}, {});
+	SuccessorGenerator generator(problem->getGroundActions());
+	EXPECT_TRUE(generator.getCandidates(problem->getInitialState()).empty());
+}
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include <applicability/state_constraint_index.hxx>
+#include <fixtures/action_fixture.hxx>
+
+using namespace fs0;
+
+class StateConstraintIndexTest : public test::ActionFixture {
+protected:
+	//! Random atoms over distinct variables, such as the effects of some action
+	std::vector<Atom> randomAtoms() {
+		std::vector<Atom> atoms;
+		for (unsigned i = 0, n = 1 + random(3); i < n; ++i) atoms.push_back(Atom(random(NUM_VARIABLES), random(2)));
+		return atoms;
+	}
+};
+
+
+TEST_F(StateConstraintIndexTest, Overlay) {
+	State state = buildState({0, 1, 0, 1, 0, 1});
+	std::vector<Atom> atoms{Atom(0, 1), Atom(1, 0), Atom(0, 0)};
+	StateOverlay overlay(state, atoms);
+	State successor(state, atoms);
+	for (VariableIdx variable = 0; variable < NUM_VARIABLES; ++variable) EXPECT_EQ(successor.getValue(variable), overlay.getValue(variable));
+}
+
+TEST_F(StateConstraintIndexTest, Trivial) {
+	std::unique_ptr<const fs::Formula> constraints(new fs::Tautology);
+	StateConstraintIndex index(constraints.get());
+	EXPECT_TRUE(index.trivial());
+	EXPECT_TRUE(index.holds(buildState(randomValues()), randomAtoms()));
+}
+
+TEST_F(StateConstraintIndexTest, EqualsFullCheck) {
+	for (unsigned i = 0; i < 200; ++i) {
+		std::unique_ptr<const fs::Formula> constraints(randomPrecondition());
+		StateConstraintIndex index(constraints.get());
+		for (unsigned j = 0; j < 50; ++j) {
+			// The index assumes that the constraints hold in the state to which the atoms are applied
+			State state = buildState(randomValues());
+			if (!constraints->interpret(state)) continue;
+			std::vector<Atom> atoms = randomAtoms();
+			EXPECT_EQ(constraints->interpret(State(state, atoms)), index.holds(state, atoms));
+		}
+	}
+}
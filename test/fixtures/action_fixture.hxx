@@ -0,0 +1,74 @@
+
+#pragma once
+
+#include <random>
+
+#include "fixtures/boolean_problem_fixture.hxx"
+
+namespace fs0 { namespace test {
+
+/**
+ * A fixture with randomly-generated problems over the boolean variables of the BooleanProblemFixture, whose action
+ * preconditions are conjunctions of atoms p(i) = v and p(i) != v, with the occasional p(i) < p(j) atom, which cannot be
+ * indexed by the different successor generators and must thus be checked on its own.
+ * The set of applicable actions computed by the linear scan over all actions serves as reference.
+ */
+class ActionFixture : public BooleanProblemFixture {
+protected:
+	ActionFixture() : _generator(1) {}
+	
+	//! Builds a random problem with the given number of actions
+	std::unique_ptr<Problem> buildRandomProblem(unsigned num_actions) {
+		std::vector<std::pair<const fs::Formula*, Conditions>> actions;
+		for (unsigned i = 0; i < num_actions; ++i) {
+			Conditions effects;
+			for (unsigned j = 0, n = 1 + random(2); j < n; ++j) effects.push_back(std::make_pair(random(NUM_VARIABLES), random(2)));
+			actions.push_back(std::make_pair(randomPrecondition(), effects));
+		}
+		return buildProblem(randomValues(), new fs::Tautology, actions);
+	}
+	
+	//! A random conjunction of 0 to 3 atoms
+	const fs::Formula* randomPrecondition() {
+		unsigned num_atoms = random(4);
+		if (num_atoms == 0) return new fs::Tautology;
+		std::vector<const fs::AtomicFormula*> atoms;
+		for (unsigned i = 0; i < num_atoms; ++i) {
+			unsigned kind = random(10);
+			std::vector<const fs::Term*> subterms{new fs::StateVariable(random(NUM_VARIABLES), nullptr)};
+			if (kind == 0) {
+				subterms.push_back(new fs::StateVariable(random(NUM_VARIABLES), nullptr));
+				atoms.push_back(new fs::LTAtomicFormula(subterms));
+			} else {
+				subterms.push_back(new fs::IntConstant(random(2)));
+				if (kind < 4) atoms.push_back(new fs::NEQAtomicFormula(subterms));
+				else atoms.push_back(new fs::EQAtomicFormula(subterms));
+			}
+		}
+		return new fs::Conjunction(atoms);
+	}
+	
+	//! Random values for all state variables
+	std::vector<ObjectIdx> randomValues() {
+		std::vector<ObjectIdx> values;
+		for (unsigned i = 0; i < NUM_VARIABLES; ++i) values.push_back(random(2));
+		return values;
+	}
+	
+	//! The indexes of the actions whose preconditions hold in the given state, found by interpreting every precondition
+	static std::vector<ActionIdx> linearScan(const Problem& problem, const State& state) {
+		std::vector<ActionIdx> applicable;
+		const auto& actions = problem.getGroundActions();
+		for (ActionIdx i = 0; i < actions.size(); ++i) {
+			if (actions[i]->getPrecondition()->interpret(state)) applicable.push_back(i);
+		}
+		return applicable;
+	}
+	
+	//! A random integer in [0, n)
+	unsigned random(unsigned n) { return std::uniform_int_distribution<unsigned>(0, n - 1)(_generator); }
+	
+	std::mt19937 _generator;
+};
+
+} } // namespaces
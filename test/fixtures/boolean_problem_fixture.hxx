@@ -0,0 +1,96 @@
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fixtures/base_fixture.hxx"
+#include <lib/rapidjson/document.h>
+#include <problem_info.hxx>
+#include <state_layout.hxx>
+#include <problem.hxx>
+#include <state.hxx>
+#include <atom.hxx>
+#include <actions/actions.hxx>
+#include <utils/binding.hxx>
+#include <utils/tuple_index.hxx>
+#include <languages/fstrips/language.hxx>
+
+namespace fs0 { namespace test {
+
+/**
+ * A fixture with a problem over NUM_VARIABLES boolean state variables p(0), ..., p(NUM_VARIABLES - 1), whose ground actions
+ * have conjunctions of atoms p(i) = v as preconditions and unconditional assignments p(i) := v as effects.
+ */
+class BooleanProblemFixture : public BaseFixture {
+protected:
+	static const unsigned NUM_VARIABLES = 6;
+	
+	typedef std::vector<std::pair<VariableIdx, ObjectIdx>> Conditions;
+
+	//! The problem info and state layout are global singletons, which are hence loaded only once for all tests
+	static void SetUpTestCase() {
+		static bool loaded = false;
+		if (loaded) return;
+		loaded = true;
+		
+		std::string variables, tuples;
+		for (unsigned i = 0; i < NUM_VARIABLES; ++i) {
+			std::string index = std::to_string(i);
+			variables += std::string(i ? "," : "") + "{\"id\":" + index + ",\"name\":\"p(" + index + ")\",\"type\":\"bool\",\"data\":[0,[" + index + "]]}";
+			tuples += std::string(i ? "," : "") + "[" + index + "]";
+		}
+		std::string data = "{\"types\":[[0,\"bool\",[\"0\",\"1\"]],[1,\"num\",\"int\",[0," + std::to_string(NUM_VARIABLES - 1) + "]]],"
+		                   "\"objects\":[],\"symbols\":[[0,\"p\",\"predicate\",[\"num\"],\"bool\",[" + tuples + "],false]],"
+		                   "\"variables\":[" + variables + "],\"problem\":{\"domain\":\"test\",\"instance\":\"test\"}}";
+		rapidjson::Document document;
+		document.Parse(data.c_str());
+		ProblemInfo::setInstance(std::unique_ptr<ProblemInfo>(new ProblemInfo(document)));
+		StateLayout::setInstance(std::unique_ptr<StateLayout>(new StateLayout(ProblemInfo::getInstance(), true)));
+	}
+	
+	//! Builds a problem with the given initial state, goal and ground actions, given as pairs (precondition, effects)
+	std::unique_ptr<Problem> buildProblem(const std::vector<ObjectIdx>& init, const Conditions& goal, const std::vector<std::pair<Conditions, Conditions>>& actions) {
+		std::vector<std::pair<const fs::Formula*, Conditions>> formulae;
+		for (const auto& action:actions) formulae.push_back(std::make_pair(conjunction(action.first), action.second));
+		return buildProblem(init, conjunction(goal), formulae);
+	}
+	
+	//! Same as above, but with the goal and preconditions given as arbitrary formulae, of which the problem takes ownership
+	std::unique_ptr<Problem> buildProblem(const std::vector<ObjectIdx>& init, const fs::Formula* goal, const std::vector<std::pair<const fs::Formula*, Conditions>>& actions) {
+		ActionData* data = new ActionData(0, "action", Signature(), {}, new fs::Tautology, {});
+		std::unique_ptr<Problem> problem(new Problem(new State(buildState(init)), {data}, goal, new fs::Tautology, TupleIndex(ProblemInfo::getInstance())));
+		
+		std::vector<const GroundAction*> ground;
+		for (const auto& action:actions) {
+			std::vector<const fs::ActionEffect*> effects;
+			for (const auto& effect:action.second) {
+				effects.push_back(new fs::ActionEffect(new fs::StateVariable(effect.first, nullptr), new fs::IntConstant(effect.second), new fs::Tautology));
+			}
+			ground.push_back(new GroundAction(ground.size(), *data, Binding(), action.first, effects));
+		}
+		problem->setGroundActions(std::move(ground));
+		return problem;
+	}
+	
+	//! The state where the i-th variable has the i-th given value
+	State buildState(const std::vector<ObjectIdx>& values) {
+		std::vector<Atom> atoms;
+		for (unsigned i = 0; i < values.size(); ++i) atoms.push_back(Atom(i, values[i]));
+		return State(values.size(), atoms);
+	}
+	
+	//! The conjunction of the given atoms, or a tautology if there are none
+	const fs::Formula* conjunction(const Conditions& conditions) {
+		if (conditions.empty()) return new fs::Tautology;
+		std::vector<const fs::AtomicFormula*> atoms;
+		for (const auto& condition:conditions) {
+			std::vector<const fs::Term*> subterms{new fs::StateVariable(condition.first, nullptr), new fs::IntConstant(condition.second)};
+			atoms.push_back(new fs::EQAtomicFormula(subterms));
+		}
+		return new fs::Conjunction(atoms);
+	}
+};
+
+} } // namespaces
@@ -0,0 +1,81 @@
+
+#pragma once
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "fixtures/base_fixture.hxx"
+#include <lib/rapidjson/document.h>
+#include <problem_info.hxx>
+#include <state_layout.hxx>
+
+namespace fs0 { namespace test {
+
+/**
+ * A fixture with the packed and unpacked layouts of a problem whose state variables have domains of different kinds:
+ * four predicative variables p(0..3), two variables loc(0..1) over the non-contiguous objects {3, 5, 9}, two bounded
+ * integer variables level(0..1) in [-2, 5], and one bounded integer variable amount(0) in [0, 100000].
+ * The problem info is not the global one, so that the layouts can be built independently of other fixtures.
+ */
+class LayoutFixture : public BaseFixture {
+protected:
+	static const unsigned NUM_VARIABLES = 9;
+
+	virtual void SetUp() {
+		std::string data = "{\"types\":[[0,\"bool\",[\"0\",\"1\"]],[1,\"block\",[\"3\",\"5\",\"9\"]],[2,\"small\",\"int\",[-2,5]],"
+		                   "[3,\"large\",\"int\",[0,100000]],[4,\"index\",\"int\",[0,3]]],\"objects\":[],"
+		                   "\"symbols\":[[0,\"p\",\"predicate\",[\"index\"],\"bool\",[[0],[1],[2],[3]],false],"
+		                   "[1,\"loc\",\"function\",[\"index\"],\"block\",[[4],[5]],false],"
+		                   "[2,\"level\",\"function\",[\"index\"],\"small\",[[6],[7]],false],"
+		                   "[3,\"amount\",\"function\",[\"index\"],\"large\",[[8]],false]],"
+		                   "\"variables\":[" + variable(0, "p(0)", "bool", 0, 0) + "," + variable(1, "p(1)", "bool", 0, 1) + ","
+		                   + variable(2, "p(2)", "bool", 0, 2) + "," + variable(3, "p(3)", "bool", 0, 3) + ","
+		                   + variable(4, "loc(0)", "block", 1, 0) + "," + variable(5, "loc(1)", "block", 1, 1) + ","
+		                   + variable(6, "level(0)", "small", 2, 0) + "," + variable(7, "level(1)", "small", 2, 1) + ","
+		                   + variable(8, "amount(0)", "large", 3, 0) + "],"
+		                   "\"problem\":{\"domain\":\"test\",\"instance\":\"test\"}}";
+		rapidjson::Document document;
+		document.Parse(data.c_str());
+		info = std::unique_ptr<ProblemInfo>(new ProblemInfo(document));
+		packed = std::unique_ptr<StateLayout>(new StateLayout(*info, true));
+		unpacked = std::unique_ptr<StateLayout>(new StateLayout(*info, false));
+	}
+	
+	//! The values that each state variable can take
+	std::vector<ObjectIdx> domain(VariableIdx variable) const {
+		if (variable < 4) return {0, 1};
+		if (variable < 6) return {0, 3, 5, 9};
+		if (variable < 8) return {-2, -1, 0, 1, 2, 3, 4, 5};
+		return {0, 1, 2, 65535, 65536, 99999, 100000};
+	}
+	
+	//! A random valuation of all state variables
+	std::vector<ObjectIdx> randomValues(std::mt19937& generator) const {
+		std::vector<ObjectIdx> values;
+		for (VariableIdx variable = 0; variable < NUM_VARIABLES; ++variable) {
+			std::vector<ObjectIdx> values_of_variable = domain(variable);
+			values.push_back(values_of_variable[generator() % values_of_variable.size()]);
+		}
+		return values;
+	}
+	
+	//! The memory of the state with the given values, laid out according to the given layout
+	std::vector<StateLayout::Word> buildData(const StateLayout& layout, const std::vector<ObjectIdx>& values) const {
+		std::vector<StateLayout::Word> data(layout.getNumWords(), 0);
+		for (VariableIdx variable = 0; variable < values.size(); ++variable) layout.set(data, variable, values[variable]);
+		return data;
+	}
+	
+	std::unique_ptr<ProblemInfo> info;
+	std::unique_ptr<StateLayout> packed;
+	std::unique_ptr<StateLayout> unpacked;
+	
+private:
+	static std::string variable(unsigned id, const std::string& name, const std::string& type, unsigned symbol, unsigned argument) {
+		return "{\"id\":" + std::to_string(id) + ",\"name\":\"" + name + "\",\"type\":\"" + type + "\",\"data\":[" + std::to_string(symbol) + ",[" + std::to_string(argument) + "]]}";
+	}
+};
+
+} } // namespaces
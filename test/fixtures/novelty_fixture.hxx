@@ -0,0 +1,110 @@
+
+#pragma once
+
+#include <random>
+#include <set>
+
+#include "fixtures/base_fixture.hxx"
+#include <aptk2/heuristics/novelty/fd_novelty_evaluator.hxx>
+
+namespace fs0 { namespace test {
+
+//! A straightforward implementation of the novelty of a sequence of valuations, which records explicitly every tuple seen so far
+class ReferenceNovelty {
+public:
+	ReferenceNovelty(unsigned max_novelty) : _max_novelty(max_novelty) {}
+	
+	unsigned evaluate(const std::vector<aptk::ValueIndex>& valuation) {
+		unsigned novelty = _max_novelty + 1;
+		std::vector<std::pair<unsigned, aptk::ValueIndex>> tuple;
+		record(valuation, 0, tuple, novelty);
+		return novelty;
+	}
+	
+protected:
+	unsigned _max_novelty;
+	
+	std::set<std::vector<std::pair<unsigned, aptk::ValueIndex>>> _seen;
+	
+	//! Records all tuples that extend the given one with features from 'first' onwards, updating the novelty with the size of those not seen before
+	void record(const std::vector<aptk::ValueIndex>& valuation, unsigned first, std::vector<std::pair<unsigned, aptk::ValueIndex>>& tuple, unsigned& novelty) {
+		if (tuple.size() == _max_novelty) return;
+		for (unsigned i = first; i < valuation.size(); ++i) {
+			tuple.push_back(std::make_pair(i, valuation[i]));
+			if (_seen.insert(tuple).second) novelty = std::min<unsigned>(novelty, tuple.size());
+			record(valuation, i + 1, tuple, novelty);
+			tuple.pop_back();
+		}
+	}
+};
+
+/**
+ * A fixture with a sequence of valuations of three features together with the novelty of each of them w.r.t. all
+ * previous valuations, and helpers to check novelty tables against it and against the reference implementation.
+ */
+class NoveltyTablesFixture : public BaseFixture {
+protected:
+	virtual void SetUp() {
+		domains = {{0, 1}, {0, 1}, {0, 1, 2}};
+		valuations = {{0, 0, 0}, {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0, 1, 0}, {0, 1, 2}, {1, 0, 2}, {1, 1, 2}};
+		novelties = {1, 3, 1, 1, 2, 3, 1, 2, 3};
+	}
+	
+	//! Checks that the given tables compute the expected novelty of each valuation, both from scratch and incrementally
+	template <typename TablesT>
+	void testNovelties(TablesT& tables, TablesT& incremental) {
+		std::vector<aptk::ValueIndex> previous;
+		for (unsigned i = 0; i < valuations.size(); ++i) {
+			EXPECT_EQ(novelties[i], tables.evaluate(valuations[i]));
+			
+			if (previous.empty()) {
+				EXPECT_EQ(novelties[i], incremental.evaluate(valuations[i]));
+			} else {
+				EXPECT_EQ(novelties[i], incremental.evaluate(valuations[i], changed(previous, valuations[i])));
+			}
+			previous = valuations[i];
+		}
+		EXPECT_EQ(4, tables.get_num_states(1));
+		EXPECT_EQ(2, tables.get_num_states(2));
+		EXPECT_EQ(3, tables.get_num_states(3));
+	}
+	
+	//! Checks that the given tables compute the same novelty as the reference implementation along a random walk over
+	//! valuations of features with the given domains, where every step changes the value of a few features
+	template <typename TablesT>
+	void testAgainstReference(const std::vector<std::vector<aptk::ValueIndex>>& domains, TablesT& tables, TablesT& incremental, unsigned max_novelty, unsigned steps) {
+		std::mt19937 generator(1);
+		ReferenceNovelty reference(max_novelty);
+		std::vector<aptk::ValueIndex> valuation;
+		for (const auto& domain:domains) valuation.push_back(domain[0]);
+		
+		EXPECT_EQ(reference.evaluate(valuation), tables.evaluate(valuation));
+		incremental.evaluate(valuation);
+		for (unsigned i = 0; i < steps; ++i) {
+			std::vector<aptk::ValueIndex> next = valuation;
+			for (unsigned j = 0, n = 1 + generator() % 3; j < n; ++j) {
+				unsigned feature = generator() % domains.size();
+				next[feature] = domains[feature][generator() % domains[feature].size()];
+			}
+			unsigned expected = reference.evaluate(next);
+			EXPECT_EQ(expected, tables.evaluate(next));
+			EXPECT_EQ(expected, incremental.evaluate(next, changed(valuation, next)));
+			valuation = next;
+		}
+	}
+	
+	//! The features whose value differs in both valuations
+	static std::vector<unsigned> changed(const std::vector<aptk::ValueIndex>& previous, const std::vector<aptk::ValueIndex>& valuation) {
+		std::vector<unsigned> features;
+		for (unsigned j = 0; j < valuation.size(); ++j) {
+			if (valuation[j] != previous[j]) features.push_back(j);
+		}
+		return features;
+	}
+
+	std::vector<std::vector<aptk::ValueIndex>> domains;
+	std::vector<std::vector<aptk::ValueIndex>> valuations;
+	std::vector<unsigned> novelties;
+};
+
+} } // namespaces
@@ -0,0 +1,97 @@
+
+#include <gtest/gtest.h>
+
+#include <heuristics/heuristic_cache.hxx>
+#include <search/components/relaxed_plan_atoms.hxx>
+#include <fixtures/boolean_problem_fixture.hxx>
+
+using namespace fs0;
+
+class HeuristicCacheTest : public test::BooleanProblemFixture {
+protected:
+	//! A heuristic that counts the number of times it is actually evaluated
+	struct CountingHeuristic {
+		unsigned evaluations = 0;
+		
+		long evaluate(const State& state) {
+			++evaluations;
+			return 1 + state.getValue(0) + 2 * state.getValue(1) + 4 * state.getValue(2);
+		}
+		
+		long evaluate(const State& state, std::vector<Atom>& atoms) {
+			atoms = {Atom(3, 1), Atom(4, 1)};
+			return evaluate(state);
+		}
+	};
+	
+	//! A memory budget which allows only for a single set of slots, in which all states are then stored
+	static const std::size_t SINGLE_SET_MEMORY = 100;
+	
+	//! The (pairwise different) states where the first three variables take the binary representation of 'i'
+	State buildState(unsigned i) {
+		return BooleanProblemFixture::buildState({ObjectIdx(i & 1), ObjectIdx((i >> 1) & 1), ObjectIdx((i >> 2) & 1), 0, 0, 0});
+	}
+	
+	CountingHeuristic heuristic;
+};
+
+
+TEST_F(HeuristicCacheTest, RepeatedLookups) {
+	HeuristicCache cache(1024 * 1024, HeuristicCache::Policy::REPLACE);
+	for (unsigned i = 0; i < 8; ++i) EXPECT_EQ(i + 1, cache.evaluate(heuristic, buildState(i)));
+	for (unsigned i = 0; i < 8; ++i) EXPECT_EQ(i + 1, cache.evaluate(heuristic, buildState(i)));
+	EXPECT_EQ(8, heuristic.evaluations);
+	EXPECT_EQ(8, cache.hits());
+	EXPECT_EQ(8, cache.misses());
+}
+
+TEST_F(HeuristicCacheTest, ReplacePolicy) {
+	HeuristicCache cache(SINGLE_SET_MEMORY, HeuristicCache::Policy::REPLACE);
+	for (unsigned i = 0; i <= HeuristicCache::WAYS; ++i) cache.evaluate(heuristic, buildState(i));
+	
+	// The last state replaced the oldest one
+	EXPECT_EQ(HeuristicCache::WAYS + 1, cache.evaluate(heuristic, buildState(HeuristicCache::WAYS)));
+	EXPECT_EQ(1, cache.hits());
+	EXPECT_EQ(1, cache.evaluate(heuristic, buildState(0)));
+	EXPECT_EQ(1, cache.hits());
+	EXPECT_EQ(HeuristicCache::WAYS + 2, heuristic.evaluations);
+}
+
+TEST_F(HeuristicCacheTest, KeepPolicy) {
+	HeuristicCache cache(SINGLE_SET_MEMORY, HeuristicCache::Policy::KEEP);
+	for (unsigned i = 0; i <= HeuristicCache::WAYS; ++i) cache.evaluate(heuristic, buildState(i));
+	
+	// The last state was discarded
+	EXPECT_EQ(HeuristicCache::WAYS + 1, cache.evaluate(heuristic, buildState(HeuristicCache::WAYS)));
+	EXPECT_EQ(0, cache.hits());
+	EXPECT_EQ(1, cache.evaluate(heuristic, buildState(0)));
+	EXPECT_EQ(1, cache.hits());
+	EXPECT_EQ(HeuristicCache::WAYS + 2, heuristic.evaluations);
+}
+
+TEST_F(HeuristicCacheTest, RelaxedPlanAtoms) {
+	HeuristicCache cache(1024 * 1024, HeuristicCache::Policy::REPLACE, true);
+	std::vector<Atom> atoms;
+	
+	// Values stored without atoms are not used when the atoms are requested
+	EXPECT_EQ(2, cache.evaluate(heuristic, buildState(1)));
+	EXPECT_EQ(2, cache.evaluate(heuristic, buildState(1), atoms));
+	EXPECT_EQ(2, heuristic.evaluations);
+	
+	atoms.clear();
+	EXPECT_EQ(2, cache.evaluate(heuristic, buildState(1), atoms));
+	EXPECT_EQ(std::vector<Atom>({Atom(3, 1), Atom(4, 1)}), atoms);
+	EXPECT_EQ(2, heuristic.evaluations);
+}
+
+TEST_F(HeuristicCacheTest, RelaxedPlanAtomsCounter) {
+	std::unique_ptr<HeuristicCache> cache(new HeuristicCache(1024 * 1024, HeuristicCache::Policy::REPLACE, true));
+	const HeuristicCache* lookups = cache.get();
+	drivers::RelaxedPlanAtomsCounter<CountingHeuristic> counter(CountingHeuristic(), std::move(cache));
+	
+	drivers::RelaxedPlanAtoms first = counter.compute(buildState(3)), second = counter.compute(buildState(3));
+	EXPECT_EQ(std::vector<Atom>({Atom(3, 1), Atom(4, 1)}), *first);
+	EXPECT_EQ(*first, *second);
+	EXPECT_EQ(1, lookups->hits());
+	EXPECT_EQ(1, lookups->misses());
+}
@@ -0,0 +1,113 @@
+#include <random>
+#include <gtest/gtest.h>
+
+#include <languages/fstrips/compiled.hxx>
+#include <languages/fstrips/builtin.hxx>
+#include <fixtures/boolean_problem_fixture.hxx>
+
+using namespace fs0;
+
+class CompiledExpressionTest : public test::BooleanProblemFixture {
+protected:
+	CompiledExpressionTest() : generator(1) {}
+	
+	//! A random term of at most the given depth, built from constants, state variables and arithmetic terms
+	const fs::Term* randomTerm(unsigned depth) {
+		unsigned kind = random(depth > 0 ? 5 : 2);
+		if (kind == 0) return new fs::IntConstant(random(4));
+		if (kind == 1) return new fs::StateVariable(random(NUM_VARIABLES), nullptr);
+		std::vector<const fs::Term*> subterms{randomTerm(depth - 1), randomTerm(depth - 1)};
+		if (kind == 2) return new fs::AdditionTerm(subterms);
+		if (kind == 3) return new fs::SubtractionTerm(subterms);
+		return new fs::MultiplicationTerm(subterms);
+	}
+	
+	//! A random relational atom between two random terms
+	const fs::AtomicFormula* randomAtom() {
+		std::vector<const fs::Term*> subterms{randomTerm(2), randomTerm(2)};
+		switch (random(6)) {
+			case 0: return new fs::EQAtomicFormula(subterms);
+			case 1: return new fs::NEQAtomicFormula(subterms);
+			case 2: return new fs::LTAtomicFormula(subterms);
+			case 3: return new fs::LEQAtomicFormula(subterms);
+			case 4: return new fs::GTAtomicFormula(subterms);
+			default: return new fs::GEQAtomicFormula(subterms);
+		}
+	}
+	
+	//! A random formula: a tautology, a contradiction, a single atom or a conjunction of up to three atoms
+	const fs::Formula* randomFormula() {
+		unsigned kind = random(10);
+		if (kind == 0) return new fs::Tautology;
+		if (kind == 1) return new fs::Contradiction;
+		if (kind < 5) return randomAtom();
+		std::vector<const fs::AtomicFormula*> atoms;
+		for (unsigned i = 0, n = 1 + random(3); i < n; ++i) atoms.push_back(randomAtom());
+		return new fs::Conjunction(atoms);
+	}
+	
+	State randomState() {
+		std::vector<ObjectIdx> values;
+		for (unsigned i = 0; i < NUM_VARIABLES; ++i) values.push_back(random(2));
+		return buildState(values);
+	}
+	
+	//! A random integer in [0, n)
+	unsigned random(unsigned n) { return std::uniform_int_distribution<unsigned>(0, n - 1)(generator); }
+	
+	std::mt19937 generator;
+};
+
+
+TEST_F(CompiledExpressionTest, TermsEqualInterpretation) {
+	for (unsigned i = 0; i < 500; ++i) {
+		std::unique_ptr<const fs::Term> term(randomTerm(3));
+		auto compiled = fs::CompiledExpression::compile(term.get());
+		ASSERT_TRUE(compiled != nullptr);
+		for (unsigned j = 0; j < 20; ++j) {
+			State state = randomState();
+			EXPECT_EQ(term->interpret(state), compiled->value(state));
+		}
+	}
+}
+
+TEST_F(CompiledExpressionTest, FormulaeEqualInterpretation) {
+	for (unsigned i = 0; i < 500; ++i) {
+		std::unique_ptr<const fs::Formula> formula(randomFormula());
+		auto compiled = fs::CompiledExpression::compile(formula.get());
+		ASSERT_TRUE(compiled != nullptr);
+		for (unsigned j = 0; j < 20; ++j) {
+			State state = randomState();
+			EXPECT_EQ(formula->interpret(state), compiled->holds(state));
+		}
+	}
+}
+
+TEST_F(CompiledExpressionTest, EffectsEqualInterpretation) {
+	for (unsigned i = 0; i < 500; ++i) {
+		fs::ActionEffect effect(new fs::StateVariable(random(NUM_VARIABLES), nullptr), randomTerm(2), randomFormula());
+		auto compiled = fs::CompiledEffect::compile(&effect);
+		ASSERT_TRUE(compiled != nullptr);
+		for (unsigned j = 0; j < 20; ++j) {
+			State state = randomState();
+			EXPECT_EQ(effect.applicable(state), compiled->applicable(state));
+			EXPECT_EQ(effect.apply(state), compiled->apply(state));
+		}
+	}
+}
+
+TEST_F(CompiledExpressionTest, StackOverflow) {
+	// A left-deep sum of more terms than the stack can hold can still be compiled, but a right-deep one cannot
+	const fs::Term* left = new fs::StateVariable(0, nullptr), *right = new fs::StateVariable(0, nullptr);
+	for (unsigned i = 0; i < fs::CompiledExpression::MAX_STACK_DEPTH; ++i) {
+		left = new fs::AdditionTerm({left, new fs::IntConstant(1)});
+		right = new fs::AdditionTerm({new fs::IntConstant(1), right});
+	}
+	std::unique_ptr<const fs::Term> left_term(left), right_term(right);
+	
+	auto compiled = fs::CompiledExpression::compile(left);
+	ASSERT_TRUE(compiled != nullptr);
+	State state = buildState({1, 0, 0, 0, 0, 0});
+	EXPECT_EQ(17, compiled->value(state));
+	EXPECT_TRUE(fs::CompiledExpression::compile(right) == nullptr);
+}
@@ -0,0 +1,60 @@
+#include <random>
+#include <gtest/gtest.h>
+
+#include <heuristics/novelty/approximate_novelty_tables.hxx>
+#include <fixtures/novelty_fixture.hxx>
+
+using namespace fs0;
+
+class ApproximateNoveltyTablesTest : public test::NoveltyTablesFixture {};
+
+
+TEST_F(ApproximateNoveltyTablesTest, Novelties) {
+	ApproximateNoveltyTables tables(3, 2, 64 * 1024, 4), incremental(3, 2, 64 * 1024, 4);
+	testNovelties(tables, incremental);
+}
+
+TEST_F(ApproximateNoveltyTablesTest, EqualsReference) {
+	// With a filter large enough for the number of recorded tuples, false positives are very unlikely
+	std::vector<std::vector<aptk::ValueIndex>> features = {{0, 1}, {0, 1, 2, 3}, {-2, 5, 7}, {0, 1}, {3, 4, 5, 6, 7, 8}, {0, 1, 2}, {0, 1}};
+	for (unsigned max_novelty : {1, 2}) {
+		ApproximateNoveltyTables tables(features.size(), max_novelty, 1024 * 1024, 4), incremental(features.size(), max_novelty, 1024 * 1024, 4);
+		testAgainstReference(features, tables, incremental, max_novelty, 500);
+	}
+}
+
+TEST_F(ApproximateNoveltyTablesTest, SharedFilter) {
+	auto filter = std::make_shared<BlockedBloomFilter>(64 * 1024, 4);
+	ApproximateNoveltyTables first(3, 2, filter, 1), second(3, 2, filter, 2);
+	
+	// The tuples of tables with different seeds are told apart
+	EXPECT_EQ(1, first.evaluate({0, 0, 0}));
+	EXPECT_EQ(1, second.evaluate({0, 0, 0}));
+	EXPECT_EQ(3, first.evaluate({0, 0, 0}));
+	EXPECT_EQ(3, second.evaluate({0, 0, 0}));
+	EXPECT_EQ(filter->memory(), first.memory());
+}
+
+TEST_F(ApproximateNoveltyTablesTest, BloomFilter) {
+	BlockedBloomFilter filter(4096, 3);
+	EXPECT_LE(filter.memory(), 4096);
+	EXPECT_EQ(0, filter.estimated_false_positive_rate());
+	
+	std::mt19937_64 generator(1);
+	std::vector<uint64_t> hashes;
+	for (unsigned i = 0; i < 100; ++i) hashes.push_back(BlockedBloomFilter::mix(generator()));
+	
+	// There are no false negatives
+	for (uint64_t hash:hashes) filter.insert(hash);
+	for (uint64_t hash:hashes) EXPECT_FALSE(filter.insert(hash));
+	
+	double rate = filter.estimated_false_positive_rate();
+	EXPECT_GT(rate, 0);
+	EXPECT_LT(rate, 0.01);
+}
+
+TEST_F(ApproximateNoveltyTablesTest, BloomFilterParameters) {
+	EXPECT_THROW(BlockedBloomFilter(4096, 0), std::runtime_error);
+	EXPECT_THROW(BlockedBloomFilter(4096, BlockedBloomFilter::MAX_HASHES + 1), std::runtime_error);
+	EXPECT_THROW(BlockedBloomFilter(32, 3), std::runtime_error);
+}
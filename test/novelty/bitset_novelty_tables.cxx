@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+
+#include <heuristics/novelty/bitset_novelty_tables.hxx>
+#include <fixtures/novelty_fixture.hxx>
+
+using namespace fs0;
+
+class BitsetNoveltyTablesTest : public test::NoveltyTablesFixture {};
+
+
+TEST_F(BitsetNoveltyTablesTest, SupportedTables) {
+	EXPECT_TRUE(BitsetNoveltyTables::supported(domains, 1));
+	EXPECT_TRUE(BitsetNoveltyTables::supported(domains, 2));
+	EXPECT_FALSE(BitsetNoveltyTables::supported(domains, 3));
+	EXPECT_FALSE(BitsetNoveltyTables::supported({{0, 1}, {}}, 2));
+}
+
+TEST_F(BitsetNoveltyTablesTest, Novelties) {
+	BitsetNoveltyTables tables(domains, 2), incremental(domains, 2);
+	testNovelties(tables, incremental);
+}
+
+TEST_F(BitsetNoveltyTablesTest, ValueOutsideDomain) {
+	BitsetNoveltyTables tables(domains, 2);
+	EXPECT_THROW(tables.evaluate({0, 0, 3}), std::runtime_error);
+}
+
+TEST_F(BitsetNoveltyTablesTest, EqualsReference) {
+	// Domains of different sizes, not necessarily starting at 0 nor contiguous
+	std::vector<std::vector<aptk::ValueIndex>> features = {{0, 1}, {0, 1, 2, 3}, {-2, 5, 7}, {0, 1}, {3, 4, 5, 6, 7, 8}, {0, 1, 2}, {0, 1}};
+	for (unsigned max_novelty : {1, 2}) {
+		BitsetNoveltyTables tables(features, max_novelty), incremental(features, max_novelty);
+		testAgainstReference(features, tables, incremental, max_novelty, 500);
+	}
+}
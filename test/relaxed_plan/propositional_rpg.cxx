@@ -0,0 +1,120 @@
+
+#include <algorithm>
+#include <random>
+#include <gtest/gtest.h>
+
+#include <heuristics/relaxed_plan/propositional_rpg.hxx>
+#include <fixtures/boolean_problem_fixture.hxx>
+
+using namespace fs0;
+
+typedef PropositionalRPG::Type RPGType;
+
+class PropositionalRPGTest : public test::BooleanProblemFixture {
+protected:
+
+	virtual void SetUp() {
+		BooleanProblemFixture::SetUp();
+		// p(0) is achieved from scratch, p(1) and p(3) from p(0), and p(2) from p(1)
+		problem = buildProblem({0, 0, 0, 0, 0, 0}, {{2, 1}, {3, 1}}, {
+			{{}, {{0, 1}}},
+			{{{0, 1}}, {{1, 1}}},
+			{{{1, 1}}, {{2, 1}}},
+			{{{0, 1}}, {{3, 1}}}
+		});
+	}
+	
+	//! A problem with the given number of random actions, each with up to two preconditions p(i) = 1 and up to two effects
+	std::unique_ptr<Problem> buildRandomProblem(std::mt19937& generator, unsigned num_actions) {
+		std::vector<std::pair<Conditions, Conditions>> actions;
+		for (unsigned i = 0; i < num_actions; ++i) {
+			Conditions precondition, effects;
+			for (unsigned k = generator() % 3; k > 0; --k) precondition.push_back({generator() % NUM_VARIABLES, 1});
+			for (unsigned k = 1 + generator() % 2; k > 0; --k) effects.push_back({generator() % NUM_VARIABLES, generator() % 2});
+			actions.push_back({precondition, effects});
+		}
+		return buildProblem({0, 0, 0, 0, 0, 0}, {{generator() % NUM_VARIABLES, 1}, {generator() % NUM_VARIABLES, 1}}, actions);
+	}
+	
+	std::unique_ptr<Problem> problem;
+};
+
+
+TEST_F(PropositionalRPGTest, SupportedProblem) {
+	EXPECT_TRUE(PropositionalRPG::is_supported(*problem));
+}
+
+TEST_F(PropositionalRPGTest, InitialStateHeuristics) {
+	PropositionalRPG hmax(*problem, RPGType::HMAX), hadd(*problem, RPGType::HADD), hff(*problem, RPGType::HFF);
+	const State& init = problem->getInitialState();
+	EXPECT_EQ(3, hmax.evaluate(init));
+	EXPECT_EQ(5, hadd.evaluate(init));
+	EXPECT_EQ(4, hff.evaluate(init));
+}
+
+TEST_F(PropositionalRPGTest, IntermediateStateHeuristics) {
+	PropositionalRPG hmax(*problem, RPGType::HMAX), hadd(*problem, RPGType::HADD), hff(*problem, RPGType::HFF);
+	State state = buildState({1, 0, 0, 0, 0, 0});
+	EXPECT_EQ(2, hmax.evaluate(state));
+	EXPECT_EQ(3, hadd.evaluate(state));
+	EXPECT_EQ(3, hff.evaluate(state));
+}
+
+TEST_F(PropositionalRPGTest, GoalStateHeuristics) {
+	PropositionalRPG hff(*problem, RPGType::HFF);
+	EXPECT_EQ(0, hff.evaluate(buildState({0, 0, 1, 1, 0, 0})));
+}
+
+TEST_F(PropositionalRPGTest, RelaxedPlanAtoms) {
+	PropositionalRPG hff(*problem, RPGType::HFF);
+	std::vector<Atom> atoms;
+	EXPECT_EQ(3, hff.evaluate(buildState({1, 0, 0, 0, 0, 0}), atoms));
+	std::sort(atoms.begin(), atoms.end());
+	EXPECT_EQ(std::vector<Atom>({Atom(1, 1), Atom(2, 1), Atom(3, 1)}), atoms);
+}
+
+TEST_F(PropositionalRPGTest, UnreachableGoal) {
+	// No action achieves p(4)
+	std::unique_ptr<Problem> unreachable = buildProblem({0, 0, 0, 0, 0, 0}, {{4, 1}}, {{{}, {{0, 1}}}});
+	PropositionalRPG hmax(*unreachable, RPGType::HMAX), hff(*unreachable, RPGType::HFF, true);
+	EXPECT_EQ(-1, hmax.evaluate(unreachable->getInitialState()));
+	EXPECT_EQ(-1, hff.evaluate(unreachable->getInitialState()));
+}
+
+TEST_F(PropositionalRPGTest, ConditionsOutsideDomain) {
+	// The precondition p(0) = 2 of the only action achieving p(4), as well as the goal p(5) = 2, can never be satisfied
+	std::unique_ptr<Problem> unsatisfiable = buildProblem({0, 0, 0, 0, 0, 0}, {{4, 1}}, {{{{0, 2}}, {{4, 1}}}});
+	PropositionalRPG hmax(*unsatisfiable, RPGType::HMAX);
+	EXPECT_EQ(-1, hmax.evaluate(unsatisfiable->getInitialState()));
+	
+	std::unique_ptr<Problem> unreachable = buildProblem({0, 0, 0, 0, 0, 0}, {{5, 2}}, {{{}, {{5, 1}}}});
+	PropositionalRPG hadd(*unreachable, RPGType::HADD, true);
+	EXPECT_EQ(-1, hadd.evaluate(unreachable->getInitialState()));
+	EXPECT_EQ(-1, hadd.evaluate(buildState({0, 0, 0, 0, 0, 1})));
+}
+
+// The incremental repair must compute the same h_max and h_add values as a computation from scratch, along sequences
+// of states that differ in a few variables, as well as in all of them
+TEST_F(PropositionalRPGTest, IncrementalRepair) {
+	std::mt19937 generator(3);
+	for (unsigned trial = 0; trial < 50; ++trial) {
+		std::unique_ptr<Problem> random = buildRandomProblem(generator, 12);
+		PropositionalRPG hmax(*random, RPGType::HMAX), hadd(*random, RPGType::HADD);
+		PropositionalRPG incremental_hmax(*random, RPGType::HMAX, true), incremental_hadd(*random, RPGType::HADD, true), incremental_hff(*random, RPGType::HFF, true);
+		
+		std::vector<ObjectIdx> values(NUM_VARIABLES, 0);
+		for (unsigned step = 0; step < 40; ++step) {
+			unsigned flips = (step % 10 == 9) ? NUM_VARIABLES : 1 + generator() % 2;
+			for (unsigned i = 0; i < flips; ++i) values[generator() % NUM_VARIABLES] ^= 1;
+			State state = buildState(values);
+			
+			long expected_hmax = hmax.evaluate(state);
+			EXPECT_EQ(expected_hmax, incremental_hmax.evaluate(state));
+			EXPECT_EQ(hadd.evaluate(state), incremental_hadd.evaluate(state));
+			
+			long hff = incremental_hff.evaluate(state);
+			EXPECT_EQ(expected_hmax == -1, hff == -1);
+			EXPECT_LE(expected_hmax, hff);
+		}
+	}
+}
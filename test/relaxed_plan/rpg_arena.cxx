@@ -0,0 +1,107 @@
+
+#include <map>
+#include <random>
+#include <gtest/gtest.h>
+
+#include <heuristics/relaxed_plan/rpg_arena.hxx>
+#include <actions/action_id.hxx>
+#include "fixtures/base_fixture.hxx"
+
+using namespace fs0;
+using namespace fs0::gecode;
+
+class RPGArenaTest : public BaseFixture {
+protected:
+
+	virtual void SetUp() {
+		arena.prepare(NUM_TUPLES, NUM_VARIABLES);
+	}
+	
+	static const unsigned NUM_TUPLES = 5;
+	static const unsigned NUM_VARIABLES = 2;
+	
+	RPGArena arena;
+};
+
+
+TEST_F(RPGArenaTest, Supports) {
+	for (TupleIdx tuple = 0; tuple < NUM_TUPLES; ++tuple) EXPECT_FALSE(arena.reached(tuple));
+	
+	arena.add(3, 0, nullptr, {});
+	arena.add(1, 1, new PlainActionID(nullptr), {3});
+	arena.add(4, 2, new PlainActionID(nullptr), {3, 1});
+	
+	EXPECT_TRUE(arena.reached(1));
+	EXPECT_FALSE(arena.reached(2));
+	EXPECT_EQ(std::vector<TupleIdx>({3, 1, 4}), arena.reached_tuples());
+	
+	EXPECT_EQ(2, arena.support(4).layer);
+	TupleRange range = arena.tuples(arena.support(4));
+	EXPECT_EQ(std::vector<TupleIdx>({3, 1}), std::vector<TupleIdx>(range.begin(), range.end()));
+	EXPECT_TRUE(arena.tuples(arena.support(3)).empty());
+}
+
+TEST_F(RPGArenaTest, Values) {
+	arena.add_value(1, 7);
+	arena.add_value(1, 8);
+	EXPECT_EQ(std::vector<ObjectIdx>({7, 8}), arena.values(1));
+	EXPECT_TRUE(arena.values(0).empty());
+	EXPECT_EQ(std::vector<VariableIdx>({1}), arena.changed_variables());
+	
+	arena.clear_changed();
+	EXPECT_TRUE(arena.changed_variables().empty());
+	arena.add_value(0, 2);
+	EXPECT_EQ(std::vector<VariableIdx>({0}), arena.changed_variables());
+}
+
+// The memory of an arena is reused for the next RPG after releasing the data of the previous one
+TEST_F(RPGArenaTest, Release) {
+	arena.add(0, 0, nullptr, {});
+	arena.add(2, 1, new PlainActionID(nullptr), {0});
+	arena.add_value(0, 1);
+	arena.release();
+	
+	for (TupleIdx tuple = 0; tuple < NUM_TUPLES; ++tuple) EXPECT_FALSE(arena.reached(tuple));
+	EXPECT_TRUE(arena.reached_tuples().empty());
+	EXPECT_TRUE(arena.values(0).empty());
+	EXPECT_TRUE(arena.changed_variables().empty());
+	
+	arena.prepare(NUM_TUPLES, NUM_VARIABLES);
+	arena.add(2, 0, nullptr, {});
+	EXPECT_TRUE(arena.reached(2));
+	EXPECT_EQ(0, arena.tuples(arena.support(2)).size());
+}
+
+// Over several RPGs built on the same arena, the supports equal those recorded in a map of tuples to (layer, support)
+TEST_F(RPGArenaTest, EqualsMap) {
+	const unsigned num_tuples = 200;
+	std::mt19937 generator(1);
+	arena.release();
+	for (unsigned rpg = 0; rpg < 20; ++rpg) {
+		arena.prepare(num_tuples, NUM_VARIABLES);
+		std::map<TupleIdx, std::pair<unsigned, std::vector<TupleIdx>>> expected;
+		std::vector<TupleIdx> reached;
+		for (unsigned layer = 0; layer < 5; ++layer) {
+			for (unsigned i = 0; i < 20; ++i) {
+				TupleIdx tuple = generator() % num_tuples;
+				if (expected.count(tuple)) continue;
+				std::vector<TupleIdx> support;
+				for (unsigned j = 0, n = reached.empty() ? 0 : generator() % 4; j < n; ++j) support.push_back(reached[generator() % reached.size()]);
+				arena.add(tuple, layer, layer > 0 ? new PlainActionID(nullptr) : nullptr, support);
+				expected[tuple] = std::make_pair(layer, support);
+				reached.push_back(tuple);
+			}
+		}
+		
+		EXPECT_EQ(reached, arena.reached_tuples());
+		for (TupleIdx tuple = 0; tuple < num_tuples; ++tuple) {
+			auto it = expected.find(tuple);
+			ASSERT_EQ(it != expected.end(), arena.reached(tuple));
+			if (it == expected.end()) continue;
+			EXPECT_EQ(it->second.first, arena.support(tuple).layer);
+			TupleRange range = arena.tuples(arena.support(tuple));
+			EXPECT_EQ(it->second.second, std::vector<TupleIdx>(range.begin(), range.end()));
+		}
+		arena.release();
+	}
+}
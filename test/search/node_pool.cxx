@@ -0,0 +1,60 @@
+
+#include <gtest/gtest.h>
+
+#include <search/algorithms/node_pool.hxx>
+#include "fixtures/base_fixture.hxx"
+
+using namespace fs0::drivers;
+
+class NodePoolTest : public BaseFixture {
+protected:
+	//! A node that counts the number of live instances
+	struct CountedNode {
+		CountedNode(unsigned value, NodeID parent) : value(value), parent(parent) { ++live; }
+		~CountedNode() { --live; }
+		
+		unsigned value;
+		NodeID parent;
+		
+		static int live;
+	};
+	
+	virtual void SetUp() { CountedNode::live = 0; }
+};
+
+int NodePoolTest::CountedNode::live = 0;
+
+
+// Nodes spanning several chunks keep their values, and references to them remain valid as the pool grows
+TEST_F(NodePoolTest, StableNodes) {
+	NodePool<CountedNode> pool;
+	NodeID root = pool.emplace(0, INVALID_NODE_ID);
+	CountedNode& reference = pool[root];
+	
+	const unsigned num_nodes = 40000;
+	for (unsigned i = 1; i < num_nodes; ++i) EXPECT_EQ(i, pool.emplace(i, i - 1));
+	
+	EXPECT_EQ(num_nodes, pool.size());
+	EXPECT_EQ(&reference, &pool[root]);
+	for (NodeID id = 1; id < num_nodes; ++id) {
+		EXPECT_EQ(id, pool[id].value);
+		EXPECT_EQ(id - 1, pool[id].parent);
+	}
+}
+
+TEST_F(NodePoolTest, Clear) {
+	{
+		NodePool<CountedNode> pool;
+		for (unsigned i = 0; i < 100; ++i) pool.emplace(i, INVALID_NODE_ID);
+		EXPECT_EQ(100, CountedNode::live);
+		
+		pool.clear();
+		EXPECT_EQ(0, CountedNode::live);
+		EXPECT_EQ(0, pool.size());
+		EXPECT_EQ(0, pool.memory());
+		
+		for (unsigned i = 0; i < 10; ++i) pool.emplace(i, INVALID_NODE_ID);
+	}
+	// The nodes left are destroyed along with the pool
+	EXPECT_EQ(0, CountedNode::live);
+}
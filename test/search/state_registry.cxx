@@ -0,0 +1,66 @@
+
+#include <map>
+#include <random>
+#include <gtest/gtest.h>
+
+#include <search/state_registry.hxx>
+#include <fixtures/boolean_problem_fixture.hxx>
+
+using namespace fs0;
+using namespace fs0::drivers;
+
+class StateRegistryTest : public test::BooleanProblemFixture {
+protected:
+	std::vector<ObjectIdx> randomValues(std::mt19937& generator) {
+		std::vector<ObjectIdx> values;
+		for (unsigned i = 0; i < NUM_VARIABLES; ++i) values.push_back(generator() % 2);
+		return values;
+	}
+	
+	StateRegistry registry;
+};
+
+
+// The registry must behave as a map from the values of the states to the order in which they were first registered
+TEST_F(StateRegistryTest, Interning) {
+	std::mt19937 generator(1);
+	std::map<std::vector<ObjectIdx>, StateID> reference;
+	
+	for (unsigned i = 0; i < 500; ++i) {
+		std::vector<ObjectIdx> values = randomValues(generator);
+		State state = buildState(values);
+		
+		auto expected = reference.insert(std::make_pair(values, StateID(reference.size())));
+		EXPECT_EQ(expected.second ? INVALID_STATE_ID : expected.first->second, registry.find(state));
+		
+		auto registered = registry.insert(state);
+		EXPECT_EQ(expected.first->second, registered.first);
+		EXPECT_EQ(expected.second, registered.second);
+		EXPECT_EQ(reference.size(), registry.size());
+	}
+	
+	for (const auto& entry:reference) {
+		State state = registry.lookup(entry.second);
+		EXPECT_EQ(buildState(entry.first), state);
+		EXPECT_EQ(entry.first, state.getValues());
+		EXPECT_EQ(state.computeHash(), state.hash());
+	}
+}
+
+TEST_F(StateRegistryTest, UnregisteredState) {
+	registry.insert(buildState({0, 0, 0, 0, 0, 0}));
+	EXPECT_EQ(0, registry.find(buildState({0, 0, 0, 0, 0, 0})));
+	EXPECT_EQ(INVALID_STATE_ID, registry.find(buildState({1, 0, 0, 0, 0, 0})));
+}
+
+// States with equal hashes but different memory must not be merged
+TEST_F(StateRegistryTest, HashCollisions) {
+	State first = buildState({1, 0, 0, 0, 0, 0}), second = buildState({0, 1, 0, 0, 0, 0});
+	State colliding(std::vector<State::Word>(second.getData()), first.hash());
+	
+	EXPECT_TRUE(registry.insert(first).second);
+	EXPECT_TRUE(registry.insert(colliding).second);
+	EXPECT_EQ(2, registry.size());
+	EXPECT_EQ(1, registry.find(colliding));
+	EXPECT_EQ(INVALID_STATE_ID, registry.find(second));
+}
@@ -0,0 +1,86 @@
+
+#include <random>
+#include <gtest/gtest.h>
+
+#include <state_layout.hxx>
+#include <fixtures/layout_fixture.hxx>
+
+using namespace fs0;
+
+class StateLayoutTest : public test::LayoutFixture {};
+
+
+TEST_F(StateLayoutTest, VariableWidths) {
+	EXPECT_EQ(1, packed->getWidth(0));
+	EXPECT_EQ(2, packed->getWidth(4));
+	EXPECT_EQ(3, packed->getWidth(6));
+	EXPECT_EQ(17, packed->getWidth(8));
+	for (VariableIdx variable = 0; variable < NUM_VARIABLES; ++variable) EXPECT_EQ(32, unpacked->getWidth(variable));
+}
+
+TEST_F(StateLayoutTest, PackedWords) {
+	// 4 * 1 + 2 * 2 + 2 * 3 + 17 bits fit in a single word
+	EXPECT_EQ(1, packed->getNumWords());
+	EXPECT_EQ(9, unpacked->getNumWords());
+	for (VariableIdx variable = 0; variable < NUM_VARIABLES; ++variable) {
+		EXPECT_EQ(0, packed->getWord(variable));
+		EXPECT_EQ(variable, unpacked->getWord(variable));
+	}
+}
+
+TEST_F(StateLayoutTest, EncodeDecode) {
+	for (VariableIdx variable = 0; variable < NUM_VARIABLES; ++variable) {
+		for (ObjectIdx value:domain(variable)) {
+			EXPECT_EQ(value, packed->decode(variable, packed->encode(variable, value)));
+			EXPECT_EQ(value, unpacked->decode(variable, unpacked->encode(variable, value)));
+		}
+	}
+	// The codes of non-contiguous domains are dense
+	EXPECT_EQ(3, packed->encode(4, 9));
+}
+
+// The domain of a variable includes 0, which uninitialized variables take, and its packed codes are dense
+TEST_F(StateLayoutTest, VariableDomains) {
+	for (VariableIdx variable = 0; variable < 8; ++variable) {
+		std::vector<ObjectIdx> values = StateLayout::compute_domain(*info, variable);
+		EXPECT_EQ(domain(variable), values);
+		for (unsigned i = 0; i < values.size(); ++i) EXPECT_EQ(i, packed->encode(variable, values[i]));
+	}
+	std::vector<ObjectIdx> amounts = StateLayout::compute_domain(*info, 8);
+	EXPECT_EQ(100001, amounts.size());
+	EXPECT_EQ(0, amounts.front());
+	EXPECT_EQ(100000, amounts.back());
+}
+
+// The packed layout must store the same values as the unpacked one, whatever the order in which variables are set
+TEST_F(StateLayoutTest, PackedEqualsUnpacked) {
+	std::mt19937 generator(1);
+	std::vector<ObjectIdx> values = randomValues(generator);
+	std::vector<StateLayout::Word> packed_data = buildData(*packed, values), unpacked_data = buildData(*unpacked, values);
+	
+	for (unsigned step = 0; step < 1000; ++step) {
+		VariableIdx variable = generator() % NUM_VARIABLES;
+		std::vector<ObjectIdx> values_of_variable = domain(variable);
+		values[variable] = values_of_variable[generator() % values_of_variable.size()];
+		packed->set(packed_data, variable, values[variable]);
+		unpacked->set(unpacked_data, variable, values[variable]);
+		
+		for (VariableIdx other = 0; other < NUM_VARIABLES; ++other) {
+			EXPECT_EQ(values[other], packed->get(packed_data, other));
+			EXPECT_EQ(values[other], unpacked->get(unpacked_data, other));
+		}
+	}
+}
+
+// The memory of a state depends only on its values, and not on how they were set, so that states can be compared word by word
+TEST_F(StateLayoutTest, CanonicalMemory) {
+	std::mt19937 generator(2);
+	for (unsigned i = 0; i < 100; ++i) {
+		std::vector<ObjectIdx> values = randomValues(generator);
+		for (const StateLayout* layout:{packed.get(), unpacked.get()}) {
+			std::vector<StateLayout::Word> data = buildData(*layout, randomValues(generator));
+			for (VariableIdx variable = NUM_VARIABLES; variable-- > 0;) layout->set(data, variable, values[variable]);
+			EXPECT_EQ(buildData(*layout, values), data);
+		}
+	}
+}
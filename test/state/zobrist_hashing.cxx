@@ -0,0 +1,103 @@
+
+#include <algorithm>
+#include <random>
+#include <gtest/gtest.h>
+
+#include <state_layout.hxx>
+#include <fixtures/layout_fixture.hxx>
+
+using namespace fs0;
+
+class ZobristHashingTest : public test::LayoutFixture {};
+
+
+// The hash maintained incrementally through the values returned by 'update' must always equal the hash computed from scratch
+TEST_F(ZobristHashingTest, IncrementalEqualsFullHash) {
+	std::mt19937 generator(1);
+	for (const StateLayout* layout:{packed.get(), unpacked.get()}) {
+		std::vector<StateLayout::Word> data = buildData(*layout, randomValues(generator));
+		std::size_t hash = layout->hash(data);
+		
+		for (unsigned step = 0; step < 1000; ++step) {
+			VariableIdx variable = generator() % NUM_VARIABLES;
+			std::vector<ObjectIdx> values_of_variable = domain(variable);
+			hash ^= layout->update(data, variable, values_of_variable[generator() % values_of_variable.size()]);
+			EXPECT_EQ(layout->hash(data), hash);
+		}
+	}
+}
+
+TEST_F(ZobristHashingTest, UpdateWithSameValue) {
+	for (const StateLayout* layout:{packed.get(), unpacked.get()}) {
+		std::vector<StateLayout::Word> data = buildData(*layout, std::vector<ObjectIdx>(NUM_VARIABLES, 0));
+		std::vector<StateLayout::Word> copy(data);
+		EXPECT_EQ(0, layout->update(data, 5, 0));
+		EXPECT_EQ(copy, data);
+	}
+}
+
+// Any two different atoms of the same variable have different keys, so that states differing in one atom get different hashes
+TEST_F(ZobristHashingTest, DistinctKeys) {
+	for (const StateLayout* layout:{packed.get(), unpacked.get()}) {
+		for (VariableIdx variable = 0; variable < NUM_VARIABLES; ++variable) {
+			std::vector<std::size_t> keys;
+			for (ObjectIdx value:domain(variable)) keys.push_back(layout->key(variable, layout->encode(variable, value)));
+			std::sort(keys.begin(), keys.end());
+			EXPECT_TRUE(std::adjacent_find(keys.begin(), keys.end()) == keys.end());
+		}
+	}
+}
+
+TEST_F(ZobristHashingTest, EqualValuesEqualHash) {
+	std::mt19937 generator(2);
+	for (unsigned i = 0; i < 100; ++i) {
+		std::vector<ObjectIdx> values = randomValues(generator);
+		for (const StateLayout* layout:{packed.get(), unpacked.get()}) {
+			std::vector<StateLayout::Word> data = buildData(*layout, randomValues(generator));
+			std::size_t hash = layout->hash(data);
+			for (VariableIdx variable = 0; variable < NUM_VARIABLES; ++variable) hash ^= layout->update(data, variable, values[variable]);
+			EXPECT_EQ(layout->hash(buildData(*layout, values)), hash);
+		}
+	}
+}
+
+//! A layout with many variables of large domains, whose keys cannot all be tabulated
+class WideDomainsHashingTest : public BaseFixture {
+protected:
+	static const unsigned NUM_VARIABLES = 40;
+	
+	virtual void SetUp() {
+		std::string variables, tuples;
+		for (unsigned i = 0; i < NUM_VARIABLES; ++i) {
+			std::string index = std::to_string(i);
+			variables += std::string(i ? "," : "") + "{\"id\":" + index + ",\"name\":\"f(" + index + ")\",\"type\":\"wide\",\"data\":[0,[" + index + "]]}";
+			tuples += std::string(i ? "," : "") + "[" + index + "]";
+		}
+		std::string data = "{\"types\":[[0,\"wide\",\"int\",[0,65535]],[1,\"index\",\"int\",[0," + std::to_string(NUM_VARIABLES - 1) + "]]],\"objects\":[],"
+		                   "\"symbols\":[[0,\"f\",\"function\",[\"index\"],\"wide\",[" + tuples + "],false]],"
+		                   "\"variables\":[" + variables + "],\"problem\":{\"domain\":\"test\",\"instance\":\"test\"}}";
+		rapidjson::Document document;
+		document.Parse(data.c_str());
+		info = std::unique_ptr<ProblemInfo>(new ProblemInfo(document));
+	}
+	
+	std::unique_ptr<ProblemInfo> info;
+};
+
+TEST_F(WideDomainsHashingTest, BoundedKeyTable) {
+	std::mt19937 generator(3);
+	for (bool packed:{true, false}) {
+		StateLayout layout(*info, packed);
+		EXPECT_GT(layout.getNumTabulatedKeys(), 0);
+		EXPECT_LE(layout.getNumTabulatedKeys(), 1 << 20);
+		
+		// Variables with and without tabulated keys are hashed consistently
+		std::vector<StateLayout::Word> data(layout.getNumWords(), 0);
+		for (VariableIdx variable = 0; variable < NUM_VARIABLES; ++variable) layout.set(data, variable, 0);
+		std::size_t hash = layout.hash(data);
+		for (unsigned step = 0; step < 1000; ++step) {
+			hash ^= layout.update(data, generator() % NUM_VARIABLES, generator() % 65536);
+			EXPECT_EQ(layout.hash(data), hash);
+		}
+	}
+}